@@ -9,9 +9,21 @@
  *  1.0		07/11/2019  	D.Anderson  original
  *  1.1		07/30/2019  	D.Anderson  added dque_key_find, dque_key_insert, dque_key_remove, 
  *                                          dque_error_len, and changed dque_error signature
+ *  1.2		10/17/2026  	agent       added DQUEOPT_SKIPLIST, O(1) dque_insert and dque_erase,
+ *                                          added DQUEOPT_GROWFIX, DQUEOPT_GROWGEO, DQUEOPT_WATERMARK,
+ *                                          added dque_shrink_to_fit, dque_pool_create, dque_pool_destroy,
+ *                                          dque_create_pool, dque_reserve, dque_create_alloc,
+ *                                          dque_pool_create_alloc, DQUEOPT_ARENA, DQUEOPT_INTRUSIVE,
+ *                                          dque_create_chunk, dque_create_ring, dque_create_fifo,
+ *                                          dque_create_xor, dque_compact, DQUEOPT_LOCKED,
+ *                                          dque_create_mpmc, DQUEERR_FULL, dque_create_spsc,
+ *                                          dque_push_back_n, dque_pop_front_n, dque_pop_front_wait,
+ *                                          dque_push_back_wait, DQUE_FOREVER, dque_create_steal,
+ *                                          dque_steal_back, dque_create_prio
  *
  *  These functions are implemented using a cicular doubly-linked list. All functions have a runtime of O(1)
- *  except dque_insert, dque_remove, dque_key_find, dque_key_insert, and dque_key_remove which are O(n).
+ *  except dque_key_find, dque_key_insert, and dque_key_remove which are O(n).
+ *  With the DQUEOPT_SKIPLIST option the key functions are O(log n) when called with the option's COMPFUNC.
  *
  *  These routines can be used to implement several Abstract Data Types (ADT) including FIFO, LIFO (stack),
  *  and Priority queues in C code. These ADTs are usually included in the libraries higher level languages
@@ -46,6 +58,19 @@
  *      dque_destroy(   qhead **                   );  - destroy a queue, free all dynamic memory allocations
  *      dque_error(     dque_err, char *, unsigned  ); - return error message for specified error
  *      dque_error_len( dque_err,         unsigned *); - return length of error message for specified error
+ *      dque_pool_create( pool **, unsigned, char * ); - create an empty node pool to be shared by queues
+ *      dque_pool_destroy(pool **                  );  - destroy a node pool no longer used by any queue
+ *      dque_create_pool( qhead **, pool *         );  - create an empty queue that takes its nodes from a node pool
+ *      dque_create_alloc(qhead **, DQUEMALLOC, DQUEFREE, void *ctx ); - create an empty queue using the user's allocator
+ *      dque_pool_create_alloc(pool **, DQUEMALLOC, DQUEFREE, void *ctx ); - create an empty node pool using the user's allocator
+ *      dque_create_chunk(qhead **, unsigned int   );  - create an empty queue that keeps its data in chunks of slots
+ *      dque_create_ring( qhead **, unsigned, char *);  - create an empty FIFO/LIFO queue that keeps its data in a ring buffer
+ *      dque_create_fifo( qhead **                 );  - create an empty FIFO queue with forward links only
+ *      dque_create_xor(  qhead **                 );  - create an empty queue with one XOR link per element
+ *      dque_create_mpmc( qhead **, unsigned, char *);  - create an empty lock-free bounded multi-producer, multi-consumer queue
+ *      dque_create_spsc( qhead **, unsigned, char *);  - create an empty wait-free bounded single-producer, single-consumer queue
+ *      dque_create_steal( qhead **, unsigned, char *); - create an empty Chase-Lev work-stealing deque, the owner pushes and pops the front
+ *      dque_create_prio( qhead **, COMPFUNC       );  - create an empty lock-free priority queue, push in comp order and pop the smallest
  *      dque_options(   qhead *, int option, ...   );  - control queue behavior with options and arguments as follows:
  *          DQUEOPT_VERSION, int *major, int *minor    - returns major and minor library version numbers
  *          DQUEOPT_NODECNT, unsigned  siz             - sets the # of nodes allocated each time nodes are needed
@@ -54,11 +79,22 @@
  *          DQUEOPT_NOALLOC, unisgned  siz, char *buf  - no dynamic allocation, uses buf of size siz for all nodes
  *          DQUEOPT_NODUPE,  unsigned int              - !0 = no duplicates in priority queue, 0 = allow duplicates
  *          DQUEOPT_NOSCAN,  unsigned int              - !0 = no scan on insert, remove, 0 = scan on insert,remove
+ *          DQUEOPT_SKIPLIST, COMPFUNC comp            - comp = skip list index for key functions using comp, NULL = none
+ *                                                       the index takes about one qnode per three elements, not on DQUEOPT_NOALLOC queues
+ *          DQUEOPT_GROWFIX                            - allocate DQUEOPT_NODECNT nodes each time nodes are needed (default)
+ *          DQUEOPT_GROWGEO, unsigned  cap             - double the # of nodes allocated each time nodes are needed, up to cap
+ *          DQUEOPT_WATERMARK, unsigned hi, unsigned lo - free list above hi nodes releases free blocks down to lo, 0 = off
+ *          DQUEOPT_ARENA,   unsigned cnt, unsigned flags - carve at least cnt nodes from one mmap'd arena, DQUEARENA_* flags
+ *          DQUEOPT_INTRUSIVE, unsigned off            - link the dque_link at offset off of the user's data, no node allocations
+ *          DQUEOPT_LOCKED,  unsigned int              - !0 = calls are thread-safe, holding the queue's mutex, 0 = off
  *
  *  capacity
  *      dque_empty(     qhead *,  unsigned int *   );  - return non-zero value if queue is empty, otherwise zero
  *      dque_size(      qhead *,  unsigned int *   );  - return current number of nodes in the queue
  *      dque_max_size(  qhead *,  unsigned int *   );  - return current number of nodes in the queue and free list
+ *      dque_shrink_to_fit( qhead *                );  - release allocated blocks whose nodes are all on the free list
+ *      dque_reserve(   qhead *,  unsigned int     );  - grow the free list to at least the specified number of nodes
+ *      dque_compact(   qhead *                    );  - relink the queue's nodes in memory order, free nodes reused LIFO
  *
  *  element access
  *      dque_back(      qhead *,  void **          );  - return pointer to user's data in the last element in the queue
@@ -84,8 +120,13 @@
  *      dque_key_insert(qhead *,  void *, COMPFUNC, void *  ); - insert new qnode with the user's data into ordered queue
  *      dque_pop_back(  qhead *,  void **          );  - remove qnode from the back of the queue, return pointer to the user's data
  *      dque_pop_front( qhead *,  void **          );  - remove qnode from the front of the queue, return pointer to the user's data
+ *      dque_pop_front_n(qhead *, void **, unsigned, unsigned * ); - remove up to n elements from the front of the queue into an array
+ *      dque_pop_front_wait(qhead *, void **, long ); - remove qnode from the front of the queue, waiting up to timeout ms for one
  *      dque_push_back( qhead *,  void *           );  - insert new qnode with user's data onto the back of the queue
+ *      dque_push_back_n(qhead *, void **, unsigned, unsigned * ); - insert n elements from an array onto the back of the queue
+ *      dque_push_back_wait(qhead *, void *, long ); - insert onto the back of a bounded queue, waiting up to timeout ms for room
  *      dque_push_front(qhead *,  void *           );  - insert new qnode with user's data onto the front of the queue
+ *      dque_steal_back(qhead *,  void **          );  - take the oldest element off the back of a work-stealing deque, from any thread
  *
  */
 
@@ -100,6 +141,9 @@ extern "C" {
 typedef struct dque_qhead { int type; } dque_qhead, *dque_qheadp, **dque_qheadpp;
 #endif
 
+/* a node pool is a qhead that only supplies qnodes to other queues         */
+typedef dque_qhead dque_pool, *dque_poolp, **dque_poolpp;
+
 #ifndef NULL_QUEUE
 #define NULL_QUEUE      (dque_qhead *)NULL  /* a NULL queue pointer         */
 #define NULL_QUEUEP     (dque_qhead **)NULL
@@ -109,6 +153,14 @@ typedef struct dque_qhead { int type; } dque_qhead, *dque_qheadp, **dque_qheadpp
 typedef struct dque_qiter { int type; } dque_qiter, *dque_qiterp, **dque_qiterpp;
 #endif
 
+/* an intrusive queue links the dque_link embedded in the user's struct    */
+#ifndef DQUE_LINK_DEF
+typedef struct dque_link { void *lnk[4]; } dque_link;
+#endif
+
+/* pointer to the user's struct from a pointer to its dque_link or iterator */
+#define DQUE_CONTAINER_OF(p,type,member) ((type *)((char *)(p) - offsetof(type, member)))
+
 #ifndef NULL_QITER
 #define NULL_QITER      (dque_qiter *)NULL  /* a NULL qiter pointer         */
 #define NULL_QITERP     (dque_qiter **)NULL
@@ -118,6 +170,13 @@ typedef struct dque_qiter { int type; } dque_qiter, *dque_qiterp, **dque_qiterpp
 typedef int (* COMPFUNC)( void *, void * );
 #endif
 
+#include <stddef.h>                         /* need for size_t, offsetof    */
+
+#ifndef DQUEALLOC_DEF
+typedef void *(* DQUEMALLOC)( void *ctx, size_t siz );
+typedef void  (* DQUEFREE)(   void *ctx, void *ptr, size_t siz );
+#endif
+
 #ifndef DQUE_ERR_DEF
 /* error numbers deliberately not defined here. */
 typedef enum dque_err {
@@ -141,7 +200,13 @@ typedef enum dque_err {
         DQUEERR_NODUPE      = 17,
         DQUEERR_INVITER     = 18,
         DQUEERR_NOBUF       = 19,
-        DQUEERR_INVHDR      = 20
+        DQUEERR_INVHDR      = 20,
+        DQUEERR_INVARG      = 21,
+        DQUEERR_INUSE       = 22,
+        DQUEERR_NOTSUP      = 23,
+        DQUEERR_RANGE       = 24,
+        DQUEERR_LINKED      = 25,
+        DQUEERR_FULL        = 26
 	} dque_err;
 #endif
 
@@ -151,10 +216,26 @@ extern dque_err dque_destroy(   dque_qhead **                                  )
 extern dque_err dque_error(     dque_err,      char  *,          unsigned int  );
 extern dque_err dque_error_len( dque_err,                        unsigned int *);
 extern dque_err dque_options(   dque_qhead *,  int, ...                        );
+extern dque_err dque_pool_create(  dque_pool **, unsigned int,   char *        );
+extern dque_err dque_pool_destroy( dque_pool **                                );
+extern dque_err dque_create_pool(  dque_qhead **, dque_pool *                  );
+extern dque_err dque_create_alloc( dque_qhead **, DQUEMALLOC, DQUEFREE, void * );
+extern dque_err dque_pool_create_alloc( dque_pool **, DQUEMALLOC, DQUEFREE, void * );
+extern dque_err dque_create_chunk( dque_qhead **, unsigned int                  );
+extern dque_err dque_create_ring(  dque_qhead **, unsigned int, char *          );
+extern dque_err dque_create_fifo(  dque_qhead **                                );
+extern dque_err dque_create_xor(   dque_qhead **                                );
+extern dque_err dque_create_mpmc(  dque_qhead **, unsigned int, char *          );
+extern dque_err dque_create_spsc(  dque_qhead **, unsigned int, char *          );
+extern dque_err dque_create_steal( dque_qhead **, unsigned int, char *          );
+extern dque_err dque_create_prio(  dque_qhead **, COMPFUNC                      );
 /* capacity */
 extern dque_err dque_empty(     dque_qhead *,  unsigned int *                  );
 extern dque_err dque_size(      dque_qhead *,  unsigned int *                  );
 extern dque_err dque_max_size(  dque_qhead *,  unsigned int *                  );
+extern dque_err dque_shrink_to_fit( dque_qhead *                               );
+extern dque_err dque_reserve(   dque_qhead *,  unsigned int                    );
+extern dque_err dque_compact(   dque_qhead *                                   );
 /* element access */
 extern dque_err dque_back(      dque_qhead *,  void **                         );
 extern dque_err dque_front(     dque_qhead *,  void **                         );
@@ -175,8 +256,16 @@ extern dque_err dque_key_erase( dque_qhead *,  void *, COMPFUNC, void **       )
 extern dque_err dque_key_insert(dque_qhead *,  void *, COMPFUNC, void *        );
 extern dque_err dque_pop_back(  dque_qhead *,  void **                         );
 extern dque_err dque_pop_front( dque_qhead *,  void **                         );
+extern dque_err dque_pop_front_n( dque_qhead *, void **, unsigned int, unsigned int * );
+extern dque_err dque_pop_front_wait( dque_qhead *, void **, long                );
 extern dque_err dque_push_back( dque_qhead *,  void *                          );
+extern dque_err dque_push_back_n( dque_qhead *, void **, unsigned int, unsigned int * );
+extern dque_err dque_push_back_wait( dque_qhead *, void *,  long                );
 extern dque_err dque_push_front(dque_qhead *,  void *                          );
+extern dque_err dque_steal_back(dque_qhead *,  void **                         );
+
+/* timeout for dque_pop_front_wait and dque_push_back_wait, wait for ever   */
+#define DQUE_FOREVER        (-1L)
 
 /* dque options                                                             */
 #define DQUEOPT_NOOPT       0
@@ -187,6 +276,19 @@ extern dque_err dque_push_front(dque_qhead *,  void *                          )
 #define DQUEOPT_NOALLOC     5
 #define DQUEOPT_NODUPE      6
 #define DQUEOPT_NOSCAN      7
+#define DQUEOPT_SKIPLIST    8
+#define DQUEOPT_GROWFIX     9
+#define DQUEOPT_GROWGEO     10
+#define DQUEOPT_WATERMARK   11
+#define DQUEOPT_ARENA       12
+#define DQUEOPT_INTRUSIVE   13
+#define DQUEOPT_LOCKED      14
+
+/* DQUEOPT_ARENA flags                                                      */
+#define DQUEARENA_HUGETLB   0x01            /* explicit hugepages, MAP_HUGETLB */
+#define DQUEARENA_THP       0x02            /* transparent hugepage advice  */
+#define DQUEARENA_POPULATE  0x04            /* prefault every page now      */
+#define DQUEARENA_MLOCK     0x08            /* lock the arena in memory     */
 
 /* short forms of the function names if INSERT_DEF is not defined           */
 
@@ -197,6 +299,45 @@ extern dque_err dque_push_front(dque_qhead *,  void *                          )
     #define destroy(X)          _Generic ((X),                      \
 				        dque_qheadpp: dque_destroy  \
 				        ) (X)
+    #define pool_create(X,b,c)  _Generic ((X),                      \
+				        dque_poolpp: dque_pool_create \
+				        ) (X,b,c)
+    #define pool_destroy(X)     _Generic ((X),                      \
+				        dque_poolpp: dque_pool_destroy \
+				        ) (X)
+    #define create_pool(X,b)    _Generic ((X),                      \
+				        dque_qheadpp: dque_create_pool \
+				        ) (X,b)
+    #define create_alloc(X,b,c,d) _Generic ((X),                    \
+				        dque_qheadpp: dque_create_alloc \
+				        ) (X,b,c,d)
+    #define pool_create_alloc(X,b,c,d) _Generic ((X),               \
+				        dque_poolpp: dque_pool_create_alloc \
+				        ) (X,b,c,d)
+    #define create_chunk(X,b)   _Generic ((X),                      \
+				        dque_qheadpp: dque_create_chunk \
+				        ) (X,b)
+    #define create_ring(X,b,c)  _Generic ((X),                      \
+				        dque_qheadpp: dque_create_ring \
+				        ) (X,b,c)
+    #define create_fifo(X)      _Generic ((X),                      \
+				        dque_qheadpp: dque_create_fifo \
+				        ) (X)
+    #define create_xor(X)       _Generic ((X),                      \
+				        dque_qheadpp: dque_create_xor \
+				        ) (X)
+    #define create_mpmc(X,b,c)  _Generic ((X),                      \
+				        dque_qheadpp: dque_create_mpmc \
+				        ) (X,b,c)
+    #define create_spsc(X,b,c)  _Generic ((X),                      \
+				        dque_qheadpp: dque_create_spsc \
+				        ) (X,b,c)
+    #define create_steal(X,b,c) _Generic ((X),                      \
+				        dque_qheadpp: dque_create_steal \
+				        ) (X,b,c)
+    #define create_prio(X,b)    _Generic ((X),                      \
+				        dque_qheadpp: dque_create_prio \
+				        ) (X,b)
     #define error(X,b,c)        _Generic ((X),                      \
 				        dque_err: dque_error        \
 				        ) (X,b,c)
@@ -215,6 +356,15 @@ extern dque_err dque_push_front(dque_qhead *,  void *                          )
     #define max_size(X,b)       _Generic ((X),                      \
 				        dque_qheadp: dque_max_size  \
 				        ) (X,b)
+    #define shrink_to_fit(X)    _Generic ((X),                      \
+				        dque_qheadp: dque_shrink_to_fit \
+				        ) (X)
+    #define reserve(X,b)        _Generic ((X),                      \
+				        dque_qheadp: dque_reserve   \
+				        ) (X,b)
+    #define compact(X)          _Generic ((X),                      \
+				        dque_qheadp: dque_compact   \
+				        ) (X)
     #define back(X,b)           _Generic ((X),                      \
 				        dque_qheadp: dque_back      \
 				        ) (X,b)
@@ -266,12 +416,27 @@ extern dque_err dque_push_front(dque_qhead *,  void *                          )
     #define pop_front(X,b)      _Generic ((X),                      \
 				        dque_qheadp: dque_pop_front \
 				        ) (X,b)
+    #define pop_front_n(X,b,c,d) _Generic ((X),                     \
+				        dque_qheadp: dque_pop_front_n \
+				        ) (X,b,c,d)
+    #define pop_front_wait(X,b,c) _Generic ((X),                    \
+				        dque_qheadp: dque_pop_front_wait \
+				        ) (X,b,c)
     #define push_back(X,b)      _Generic ((X),                      \
 				        dque_qheadp: dque_push_back \
 				        ) (X,b)
+    #define push_back_n(X,b,c,d) _Generic ((X),                     \
+				        dque_qheadp: dque_push_back_n \
+				        ) (X,b,c,d)
+    #define push_back_wait(X,b,c) _Generic ((X),                    \
+				        dque_qheadp: dque_push_back_wait \
+				        ) (X,b,c)
     #define push_front(X,b)     _Generic ((X),                      \
 				        dque_qheadp: dque_push_front\
 				        ) (X,b)
+    #define steal_back(X,b)     _Generic ((X),                      \
+				        dque_qheadp: dque_steal_back\
+				        ) (X,b)
     #ifndef __cplusplus
       #define delete(X,b,c)       _Generic ((X),                      \
 	  			          dque_qheadp: dque_erase     \
@@ -295,6 +460,19 @@ extern dque_err dque_push_front(dque_qhead *,  void *                          )
       /* member functions */
       #define create(a,b,c)       dque_create(a,b,c)
       #define destroy(a)          dque_destroy(a)
+      #define pool_create(a,b,c)  dque_pool_create(a,b,c)
+      #define pool_destroy(a)     dque_pool_destroy(a)
+      #define create_pool(a,b)    dque_create_pool(a,b)
+      #define create_alloc(a,b,c,d) dque_create_alloc(a,b,c,d)
+      #define pool_create_alloc(a,b,c,d) dque_pool_create_alloc(a,b,c,d)
+      #define create_chunk(a,b)   dque_create_chunk(a,b)
+      #define create_ring(a,b,c)  dque_create_ring(a,b,c)
+      #define create_fifo(a)      dque_create_fifo(a)
+      #define create_xor(a)       dque_create_xor(a)
+      #define create_mpmc(a,b,c)  dque_create_mpmc(a,b,c)
+      #define create_spsc(a,b,c)  dque_create_spsc(a,b,c)
+      #define create_steal(a,b,c) dque_create_steal(a,b,c)
+      #define create_prio(a,b)    dque_create_prio(a,b)
       #define error(a,b,c)        dque_error(a,b,c)
       #define error_len(a,b)      dque_error_len(a,b)
       #if (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)) /* conforms to C99 standard? */
@@ -306,6 +484,9 @@ extern dque_err dque_push_front(dque_qhead *,  void *                          )
       #define empty(a,b)          dque_empty(a,b)
       #define size(a,b)           dque_size(a,b)
       #define max_size(a,b)       dque_max_size(a,b)
+      #define shrink_to_fit(a)    dque_shrink_to_fit(a)
+      #define reserve(a,b)        dque_reserve(a,b)
+      #define compact(a)          dque_compact(a)
       /* element access */
       #define back(a,b)           dque_back(a,b)
       #define front(a,b)          dque_front(a,b)
@@ -327,7 +508,12 @@ extern dque_err dque_push_front(dque_qhead *,  void *                          )
       #define pop_back(a,b)       dque_pop_back(a,b)
       #define pop_front(a,b)      dque_pop_front(a,b)
       #define push_back(a,b)      dque_push_back(a,b)
+      #define pop_front_n(a,b,c,d) dque_pop_front_n(a,b,c,d)
+      #define push_back_n(a,b,c,d) dque_push_back_n(a,b,c,d)
+      #define pop_front_wait(a,b,c) dque_pop_front_wait(a,b,c)
+      #define push_back_wait(a,b,c) dque_push_back_wait(a,b,c)
       #define push_front(a,b)     dque_push_front(a,b)
+      #define steal_back(a,b)     dque_steal_back(a,b)
       #ifndef __cplusplus
         #define delete(a,b,c)       dque_erase(a,b,c)
         #define key_delete(a,b,c,d) dque_key_erase(a,b,c,d)
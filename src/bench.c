@@ -0,0 +1,799 @@
+/**
+ *
+ *  \file	bench.c
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	benchmarks for DQUE library functions.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original, memory per element of each queue type
+ *  1.2		10/17/2026  	agent       Added contended throughput of DQUEOPT_LOCKED
+ *  1.2		10/17/2026  	agent       Added lock-free MPMC scaling
+ *  1.2		10/17/2026  	agent       Added SPSC messages per second and latency
+ *  1.2		10/17/2026  	agent       Added wakeup latency of dque_pop_front_wait
+ *  1.2		10/17/2026  	agent       Added work-stealing task throughput
+ *  1.2		10/17/2026  	agent       Added lock-free priority queue scaling
+ *
+ *      bench [count]
+ *
+ *      Each benchmark pushes count pointers, 1000000 by default, onto a queue and
+ *      reports the heap bytes used per element and the time to push and pop them.
+ *      Heap bytes are measured with glibc's mallinfo2, elsewhere they are shown as 0.
+ *
+ *      The locked benchmark has 1 to 8 threads push and pop count elements in total
+ *      on one queue, with DQUEOPT_LOCKED and with a mutex around every call, the
+ *      way callers had to share a queue before.
+ *
+ *      The MPMC benchmark does the same from 1 thread up to at least twice the
+ *      number of CPUs, with a dque_create_mpmc queue and with a DQUEOPT_LOCKED ring.
+ *
+ *      The SPSC benchmark pins a producer and a consumer thread to different CPUs,
+ *      where there are two, and reports messages per second one way, then the
+ *      one-way latency of a message bounced back and forth between two queues.
+ *
+ *      The wakeup benchmark sends count/1000 messages, at most 2000, 100us apart, so
+ *      the consumer is idle when each arrives, and reports the time from the push to
+ *      the pop and the consumer's CPU use, for dque_pop_front_wait on a LOCKED ring
+ *      and an MPMC queue, and for polling the LOCKED ring with sched_yield or with
+ *      a 50us sleep between pops.
+ *
+ *
+ *      The stealing benchmark has thread 0 spawn count tasks, then every thread
+ *      runs them until none are left, from 1 thread up to at least twice the number
+ *      of CPUs. Each thread has a dque_create_steal deque, pops its own newest task
+ *      and steals the oldest from the others when it has none. This is compared with
+ *      all the threads sharing one DQUEOPT_LOCKED ring.
+ *
+ *      The priority queue benchmark is an event scheduler. It fills a queue with
+ *      BACKLOG random event times, then 1 to 32 threads pop the earliest event and
+ *      push one a random time after it, count pairs in total. It compares
+ *      dque_create_prio with a mutex around dque_pop_front and dque_key_insert on
+ *      a plain queue, O(n) per push, and on one with the DQUEOPT_SKIPLIST index.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define _GNU_SOURCE                         /* need for pthread_setaffinity_np */
+#include <stdio.h>                          /* need NULL definition         */
+#include <stdlib.h>                         /* need for atol                */
+#include <time.h>                           /* need for clock_gettime       */
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>                         /* need for mallinfo2           */
+#define HAVE_MALLINFO2
+#endif
+#include <pthread.h>                        /* need for pthread_create      */
+#include <sched.h>                          /* need for sched_yield         */
+#include <unistd.h>                         /* need for sysconf             */
+#include "dque.h"
+
+typedef dque_err (*CREATEFUNC)( dque_qhead ** );
+
+double  now(       void                     );
+size_t  heapused(  void                     );
+dque_err create_list( dque_qhead **queuep  );
+dque_err create_chnk( dque_qhead **queuep  );
+dque_err create_rng(  dque_qhead **queuep  );
+void    bench_memory( unsigned long cnt     );
+void   *lockedwork(  void *arg              );
+void    bench_locked( unsigned long cnt     );
+void    bench_mpmc(   unsigned long cnt     );
+void    pin(         unsigned int cpu       );
+void    waiting(     unsigned int *spins    );
+void   *producer(    void *arg              );
+void   *ponger(      void *arg              );
+void    bench_spsc(   unsigned long cnt     );
+double  cputime(     void                     );
+void   *wakee(       void *arg              );
+void    bench_wake(   unsigned long cnt     );
+void   *stealwork(   void *arg              );
+void    bench_steal(  unsigned long cnt     );
+int     keycomp(     void *k1, void *k2     );
+void   *priowork(    void *arg              );
+void    bench_prio(   unsigned long cnt     );
+
+/* one thread of the locked benchmark                                       */
+struct work {
+    dque_qhead         *queue;
+    pthread_mutex_t    *mutx;               /* caller's mutex, NULL = none  */
+    unsigned long       cnt;                /* push/pop pairs to do         */
+};
+
+double                                      /* seconds, monotonic clock     */
+now( void )
+{
+    struct timespec ts;
+
+    (void) clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+size_t                                      /* heap bytes in use, 0=unknown */
+heapused( void )
+{
+#ifdef HAVE_MALLINFO2
+    struct mallinfo2 mi = mallinfo2();
+
+    return (mi.uordblks + mi.hblkhd);
+#else
+    return (0);
+#endif
+}
+
+/* wrappers so every queue type is created the same way                     */
+dque_err create_list( dque_qhead **queuep ) { return (dque_create( queuep, 0, NULL )); }
+dque_err create_chnk( dque_qhead **queuep ) { return (dque_create_chunk( queuep, 0 )); }
+dque_err create_rng(  dque_qhead **queuep ) { return (dque_create_ring( queuep, 0, NULL )); }
+
+/* heap bytes per element and push/pop time of each queue type              */
+void
+bench_memory(
+unsigned long   cnt )                       /* elements to push             */
+{
+    static struct { char *name; CREATEFUNC create; } types[] = {
+        { "qnode list",     create_list      },
+        { "chunked",        create_chnk      },
+        { "ring",           create_rng       },
+        { "FIFO snodes",    dque_create_fifo },
+        { "XOR snodes",     dque_create_xor  },
+    };
+    dque_qhead     *queue;
+    void           *data;
+    unsigned long   i;
+    unsigned int    t;
+    size_t          base;
+    size_t          used;
+    double          start;
+    double          push;
+    double          pop;
+
+    (void) printf( "\nmemory, %lu pointers\n", cnt );
+    (void) printf( "%-14s %12s %10s %10s %10s\n", "queue", "heap bytes", "bytes/elt", "push ns", "pop ns" );
+    for (t = 0; t < sizeof(types)/sizeof(types[0]); ++t) {
+        base    = heapused();
+        if ((*types[t].create)( &queue ) != DQUEERR_NOERR) {
+            (void) printf( "%-14s create failed\n", types[t].name );
+            continue;
+        }
+        start   = now();
+        for (i = 0; i < cnt; ++i) {
+            if (dque_push_back( queue, (void *)(i + 1) ) != DQUEERR_NOERR) {
+                break;
+            }
+        }
+        push    = now() - start;
+        used    = heapused() - base;
+        start   = now();
+        for (i = 0; i < cnt; ++i) {
+            (void) dque_pop_front( queue, &data );
+        }
+        pop     = now() - start;
+        (void) dque_destroy( &queue );
+        (void) printf( "%-14s %12zu %10.1f %10.1f %10.1f\n", types[t].name, used,
+                       (double)used / cnt, push * 1e9 / cnt, pop * 1e9 / cnt );
+    }
+}
+
+void *
+lockedwork(
+void           *arg )                       /* struct work                  */
+{
+    struct work    *work    = (struct work *)arg;
+    void           *data;
+    unsigned long   i;
+
+    for (i = 0; i < work->cnt; ++i) {
+        if (work->mutx != NULL) {
+            (void) pthread_mutex_lock( work->mutx );
+        }
+        while (dque_push_back( work->queue, (void *)(i + 1) ) == DQUEERR_FULL) {
+            (void) sched_yield();           /* MPMC queue full, try again   */
+        }
+        if (work->mutx != NULL) {
+            (void) pthread_mutex_unlock( work->mutx );
+            (void) pthread_mutex_lock( work->mutx );
+        }
+        while (dque_pop_front( work->queue, &data ) == DQUEERR_EMPTY) {
+            (void) sched_yield();           /* MPMC push not stored yet     */
+        }
+        if (work->mutx != NULL) {
+            (void) pthread_mutex_unlock( work->mutx );
+        }
+    }
+    return (NULL);
+}
+
+/* push/pop pairs per second on one queue shared by 1 to 8 threads         */
+void
+bench_locked(
+unsigned long   cnt )                       /* push/pop pairs in total      */
+{
+    pthread_t       thrd[8];
+    struct work     work[8];
+    pthread_mutex_t mutx;
+    dque_qhead     *queue;
+    unsigned int    n, t, mode;
+    double          start;
+    double          rate[2];
+
+    (void) printf( "\nlocked, %lu push/pop pairs shared by all threads\n", cnt );
+    (void) printf( "%-8s %16s %16s\n", "threads", "LOCKED Mpairs/s", "caller Mpairs/s" );
+    (void) pthread_mutex_init( &mutx, NULL );
+    for (n = 1; n <= 8; n *= 2) {
+        for (mode = 0; mode < 2; ++mode) {  /* 0 = DQUEOPT_LOCKED, 1 = caller */
+            (void) dque_create( &queue, 0, NULL );
+            if (mode == 0) {
+                (void) dque_options( queue, DQUEOPT_LOCKED, 1 );
+            }
+            start   = now();
+            for (t = 0; t < n; ++t) {
+                work[t].queue   = queue;
+                work[t].mutx    = (mode == 0) ? NULL : &mutx;
+                work[t].cnt     = cnt / n;
+                (void) pthread_create( &thrd[t], NULL, lockedwork, &work[t] );
+            }
+            for (t = 0; t < n; ++t) {
+                (void) pthread_join( thrd[t], NULL );
+            }
+            rate[mode]  = (cnt / n) * n / (now() - start) / 1e6;
+            (void) dque_destroy( &queue );
+        }
+        (void) printf( "%-8u %16.2f %16.2f\n", n, rate[0], rate[1] );
+    }
+    (void) pthread_mutex_destroy( &mutx );
+}
+
+/* push/pop pairs per second on one queue shared by 1 to 2*CPUs threads    */
+void
+bench_mpmc(
+unsigned long   cnt )                       /* push/pop pairs in total      */
+{
+    pthread_t       thrd[64];
+    struct work     work[64];
+    dque_qhead     *queue;
+    long            cpus    = sysconf( _SC_NPROCESSORS_ONLN );
+    unsigned int    most    = 8;
+    unsigned int    n, t, mode;
+    double          start;
+    double          rate[2];
+
+    while (most < 64 && most < 2 * cpus) {
+        most   *= 2;                        /* at least twice the CPUs      */
+    }
+    (void) printf( "\nMPMC, %lu push/pop pairs shared by all threads, %ld CPUs\n", cnt, cpus );
+    (void) printf( "%-8s %16s %16s\n", "threads", "MPMC Mpairs/s", "LOCKED Mpairs/s" );
+    for (n = 1; n <= most; n *= 2) {
+        for (mode = 0; mode < 2; ++mode) {  /* 0 = MPMC, 1 = locked ring    */
+            if (mode == 0) {
+                (void) dque_create_mpmc( &queue, 0, NULL );
+            } else {
+                (void) dque_create_ring( &queue, 0, NULL );
+                (void) dque_options( queue, DQUEOPT_LOCKED, 1 );
+            }
+            start   = now();
+            for (t = 0; t < n; ++t) {
+                work[t].queue   = queue;
+                work[t].mutx    = NULL;
+                work[t].cnt     = cnt / n;
+                (void) pthread_create( &thrd[t], NULL, lockedwork, &work[t] );
+            }
+            for (t = 0; t < n; ++t) {
+                (void) pthread_join( thrd[t], NULL );
+            }
+            rate[mode]  = (cnt / n) * n / (now() - start) / 1e6;
+            (void) dque_destroy( &queue );
+        }
+        (void) printf( "%-8u %16.2f %16.2f\n", n, rate[0], rate[1] );
+    }
+}
+
+/* one side of the SPSC benchmark                                          */
+struct pipe {
+    dque_qhead         *ping;               /* producer to consumer         */
+    dque_qhead         *pong;               /* consumer back to producer    */
+    unsigned long       cnt;                /* messages to send             */
+    unsigned int        batch;              /* push_back_n size, 1 = single */
+    unsigned int        cpu;                /* CPU to pin the thread to     */
+};
+
+/* pin the calling thread to a CPU, where the platform allows it            */
+void
+pin(
+unsigned int    cpu )                       /* CPU number                   */
+{
+#if defined(__GLIBC__) && defined(__USE_GNU)
+    cpu_set_t       set;
+
+    CPU_ZERO( &set );
+    CPU_SET( cpu, &set );
+    (void) pthread_setaffinity_np( pthread_self(), sizeof(set), &set );
+#else
+    (void) cpu;
+#endif
+}
+
+/* spin a while on a full or empty queue, then let the other thread run.   */
+/* With one CPU the other thread can not run until this one yields.         */
+unsigned int    spinmax = 1000;
+
+void
+waiting(
+unsigned int   *spins )                     /* spins so far, 0 after a yield*/
+{
+    if (++*spins > spinmax) {
+        *spins  = 0;
+        (void) sched_yield();
+    }
+}
+
+void *
+producer(
+void           *arg )                       /* struct pipe                  */
+{
+    struct pipe    *pipe    = (struct pipe *)arg;
+    void           *data[64];
+    unsigned long   i;
+    unsigned int    j, n, done, spins = 0;
+
+    pin( pipe->cpu );
+    for (i = 0; i < pipe->cnt; i += n) {
+        n       = (pipe->cnt - i < pipe->batch) ? (unsigned int)(pipe->cnt - i) : pipe->batch;
+        for (j = 0; j < n; ++j) {
+            data[j] = (void *)(i + j + 1);
+        }
+        for (j = 0; j < n; j += done) {
+            if (n == 1) {
+                done    = (dque_push_back( pipe->ping, data[0] ) == DQUEERR_NOERR);
+            } else {
+                (void) dque_push_back_n( pipe->ping, &data[j], n - j, &done );
+            }
+            if (done == 0) {
+                waiting( &spins );
+            }
+        }
+    }
+    return (NULL);
+}
+
+void *
+ponger(
+void           *arg )                       /* struct pipe                  */
+{
+    struct pipe    *pipe    = (struct pipe *)arg;
+    void           *data;
+    unsigned long   i;
+    unsigned int    spins   = 0;
+
+    pin( pipe->cpu );
+    for (i = 0; i < pipe->cnt; ++i) {
+        while (dque_pop_front( pipe->ping, &data ) != DQUEERR_NOERR || data == NULL) {
+            waiting( &spins );
+        }
+        while (dque_push_back( pipe->pong, data ) != DQUEERR_NOERR) {
+            waiting( &spins );
+        }
+    }
+    return (NULL);
+}
+
+/* messages per second and one-way latency between two pinned threads      */
+void
+bench_spsc(
+unsigned long   cnt )                       /* messages to send             */
+{
+    static struct { char *name; unsigned int type; unsigned int batch; } kinds[] = {
+        { "SPSC",           0,  1 },
+        { "SPSC batch 32",  0, 32 },
+        { "MPMC",           1,  1 },
+        { "LOCKED ring",    2,  1 },
+    };
+    pthread_t       thrd;
+    struct pipe     pipe;
+    dque_qhead     *queue[2];
+    void           *data[64];
+    long            cpus    = sysconf( _SC_NPROCESSORS_ONLN );
+    unsigned long   i, sum;
+    unsigned int    k, q, done, spins;
+    double          start;
+    double          rate;
+    double          lat;
+
+    spinmax = (cpus > 1) ? 1000 : 0;
+    (void) printf( "\nSPSC, %lu messages between threads pinned to CPUs 0 and %ld\n", cnt, (cpus > 1) ? 1L : 0L );
+    (void) printf( "%-14s %12s %16s\n", "queue", "Mmsgs/s", "one-way ns" );
+    for (k = 0; k < sizeof(kinds)/sizeof(kinds[0]); ++k) {
+        for (q = 0; q < 2; ++q) {
+            if (kinds[k].type == 0) {
+                (void) dque_create_spsc( &queue[q], 0, NULL );
+            } else if (kinds[k].type == 1) {
+                (void) dque_create_mpmc( &queue[q], 0, NULL );
+            } else {
+                (void) dque_create_ring( &queue[q], 0, NULL );
+                (void) dque_options( queue[q], DQUEOPT_LOCKED, 1 );
+            }
+        }
+        pipe.ping   = queue[0];
+        pipe.pong   = queue[1];
+        pipe.cnt    = cnt;
+        pipe.batch  = kinds[k].batch;
+        pipe.cpu    = 0;
+        pin( (cpus > 1) ? 1 : 0 );          /* consumer on this thread      */
+        start   = now();
+        (void) pthread_create( &thrd, NULL, producer, &pipe );
+        for (i = sum = 0, spins = 0; i < cnt; i += done) {
+            if (kinds[k].batch == 1) {
+                done    = (dque_pop_front( queue[0], &data[0] ) == DQUEERR_NOERR && data[0] != NULL);
+            } else {
+                (void) dque_pop_front_n( queue[0], data, kinds[k].batch, &done );
+            }
+            if (done == 0) {
+                waiting( &spins );
+            }
+            sum    += done;
+        }
+        (void) pthread_join( thrd, NULL );
+        rate    = sum / (now() - start) / 1e6;
+
+        pipe.cnt    = cnt / 10;             /* round trips are slower       */
+        pipe.cpu    = (cpus > 1) ? 1 : 0;
+        pin( 0 );
+        (void) pthread_create( &thrd, NULL, ponger, &pipe );
+        start   = now();
+        for (i = 0, spins = 0; i < pipe.cnt; ++i) {
+            while (dque_push_back( queue[0], (void *)(i + 1) ) != DQUEERR_NOERR) {
+                waiting( &spins );
+            }
+            while (dque_pop_front( queue[1], &data[0] ) != DQUEERR_NOERR || data[0] == NULL) {
+                waiting( &spins );
+            }
+        }
+        lat     = (now() - start) * 1e9 / pipe.cnt / 2;
+        (void) pthread_join( thrd, NULL );
+        (void) dque_destroy( &queue[0] );
+        (void) dque_destroy( &queue[1] );
+        (void) printf( "%-14s %12.2f %16.1f\n", kinds[k].name, rate, lat );
+    }
+}
+
+/* the consumer of the wakeup benchmark                                     */
+struct wake {
+    dque_qhead         *queue;
+    unsigned long       cnt;                /* messages to receive          */
+    unsigned int        mode;               /* 0 = wait, 1 = yield, 2 = sleep */
+    double              lat;                /* returned sum of wakeup times */
+    double              cpu;                /* returned CPU seconds used    */
+};
+
+double                                      /* CPU seconds of this thread   */
+cputime( void )
+{
+    struct timespec ts;
+
+    (void) clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
+    return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+void *
+wakee(
+void           *arg )                       /* struct wake                  */
+{
+    struct wake    *wake    = (struct wake *)arg;
+    struct timespec nap     = { 0, 50000 };
+    void           *data;
+    unsigned long   i;
+    double          start   = cputime();
+
+    for (i = 0, wake->lat = 0; i < wake->cnt; ++i) {
+        if (wake->mode == 0) {
+            (void) dque_pop_front_wait( wake->queue, &data, DQUE_FOREVER );
+        } else {
+            while (dque_pop_front( wake->queue, &data ) != DQUEERR_NOERR || data == NULL) {
+                if (wake->mode == 1) {
+                    (void) sched_yield();
+                } else {
+                    (void) nanosleep( &nap, NULL );
+                }
+            }
+        }
+        wake->lat  += now() - *(double *)data;  /* data is the push time    */
+    }
+    wake->cpu   = cputime() - start;
+    return (NULL);
+}
+
+/* time from a push to the pop by an idle consumer, and its CPU use         */
+void
+bench_wake(
+unsigned long   cnt )                       /* scales the # of messages     */
+{
+    static struct { char *name; unsigned int mpmc; unsigned int mode; } kinds[] = {
+        { "wait, LOCKED ring",  0, 0 },
+        { "wait, MPMC",         1, 0 },
+        { "poll, yield",        0, 1 },
+        { "poll, sleep 50us",   0, 2 },
+    };
+    pthread_t       thrd;
+    struct wake     wake;
+    struct timespec gap     = { 0, 100000 };
+    double         *stamp;
+    double          start;
+    unsigned long   i;
+    unsigned int    k;
+
+    wake.cnt    = (cnt / 1000 < 2000) ? cnt / 1000 : 2000;
+    wake.cnt   += (wake.cnt == 0);
+    if ((stamp = (double *)malloc( wake.cnt * sizeof(double) )) == NULL) {
+        return;
+    }
+    (void) printf( "\nwakeup, %lu messages 100us apart\n", wake.cnt );
+    (void) printf( "%-18s %12s %14s\n", "consumer", "wakeup us", "consumer CPU" );
+    for (k = 0; k < sizeof(kinds)/sizeof(kinds[0]); ++k) {
+        if (kinds[k].mpmc) {
+            (void) dque_create_mpmc( &wake.queue, 0, NULL );
+        } else {
+            (void) dque_create_ring( &wake.queue, 0, NULL );
+            (void) dque_options( wake.queue, DQUEOPT_LOCKED, 1 );
+        }
+        wake.mode   = kinds[k].mode;
+        (void) pthread_create( &thrd, NULL, wakee, &wake );
+        start   = now();
+        for (i = 0; i < wake.cnt; ++i) {
+            (void) nanosleep( &gap, NULL ); /* let the consumer go idle     */
+            stamp[i]    = now();
+            (void) dque_push_back( wake.queue, &stamp[i] );
+        }
+        (void) pthread_join( thrd, NULL );
+        (void) printf( "%-18s %12.1f %13.0f%%\n", kinds[k].name, wake.lat * 1e6 / wake.cnt,
+                       wake.cpu * 100 / (now() - start) );
+        (void) dque_destroy( &wake.queue );
+    }
+    free( stamp );
+}
+
+/* the threads of the stealing benchmark                                    */
+struct tasks {
+    dque_qhead         *deque[64];          /* each thread's, or one shared */
+    unsigned int        n;                  /* # of threads                 */
+    unsigned int        steal;              /* 0 = one shared LOCKED ring   */
+    unsigned long       cnt;                /* tasks thread 0 spawns        */
+    unsigned long       left;               /* tasks not yet run            */
+};
+
+struct tasker {
+    struct tasks       *tasks;
+    unsigned int        me;                 /* this thread's deque          */
+};
+
+void *
+stealwork(
+void           *arg )                       /* struct tasker                */
+{
+    struct tasks   *tasks   = ((struct tasker *)arg)->tasks;
+    unsigned int    me      = ((struct tasker *)arg)->me;
+    dque_qhead     *own     = tasks->deque[me];
+    void           *data;
+    unsigned long   i;
+    unsigned long   ran     = 0;            /* tasks run, not yet counted   */
+    unsigned int    victim  = me;
+    int             found;
+
+    for (i = 0; me == 0 && i < tasks->cnt; ++i) {   /* thread 0 spawns      */
+        if (tasks->steal) {
+            (void) dque_push_front( own, (void *)(i + 1) );
+        } else {
+            (void) dque_push_back( own, (void *)(i + 1) );
+        }
+        if ((i & 3) == 3 && dque_pop_front( own, &data ) == DQUEERR_NOERR && data != NULL) {
+            ++ran;                          /* and runs some as it goes     */
+        }
+    }
+    for (;;) {
+        found   = (dque_pop_front( own, &data ) == DQUEERR_NOERR && data != NULL);
+        if (!found && tasks->steal && tasks->n > 1) {
+            if ((victim = (victim + 1) % tasks->n) == me) {
+                victim  = (victim + 1) % tasks->n;  /* skip our own deque   */
+            }
+            found   = (dque_steal_back( tasks->deque[victim], &data ) == DQUEERR_NOERR);
+        }
+        if (found && ++ran < 64) {
+            continue;
+        }
+        (void) __atomic_sub_fetch( &tasks->left, ran, __ATOMIC_RELAXED );
+        ran     = 0;                        /* counted in batches           */
+        if (!found) {                       /* nothing found, done?         */
+            if (__atomic_load_n( &tasks->left, __ATOMIC_RELAXED ) == 0) {
+                break;
+            }
+            (void) sched_yield();
+        }
+    }
+    return (NULL);
+}
+
+/* tasks per second, spawned by one thread and run by all                   */
+void
+bench_steal(
+unsigned long   cnt )                       /* tasks to spawn               */
+{
+    static struct tasks tasks;
+    pthread_t       thrd[64];
+    struct tasker   tasker[64];
+    long            cpus    = sysconf( _SC_NPROCESSORS_ONLN );
+    unsigned int    most    = 8;
+    unsigned int    n, t, mode;
+    double          start;
+    double          rate[2];
+
+    while (most < 64 && most < 2 * cpus) {
+        most   *= 2;                        /* at least twice the CPUs      */
+    }
+    (void) printf( "\nwork stealing, %lu tasks spawned by one thread, %ld CPUs\n", cnt, cpus );
+    (void) printf( "%-8s %16s %16s\n", "threads", "steal Mtasks/s", "LOCKED Mtasks/s" );
+    for (n = 1; n <= most; n *= 2) {
+        for (mode = 0; mode < 2; ++mode) {  /* 0 = stealing, 1 = locked ring*/
+            tasks.steal = (mode == 0);
+            for (t = 0; t < n; ++t) {
+                if (tasks.steal) {
+                    (void) dque_create_steal( &tasks.deque[t], 0, NULL );
+                } else if (t == 0) {
+                    (void) dque_create_ring( &tasks.deque[0], 0, NULL );
+                    (void) dque_options( tasks.deque[0], DQUEOPT_LOCKED, 1 );
+                } else {
+                    tasks.deque[t]  = tasks.deque[0];
+                }
+            }
+            tasks.n     = n;
+            tasks.cnt   = cnt;
+            tasks.left  = cnt;
+            start   = now();
+            for (t = 0; t < n; ++t) {
+                tasker[t].tasks = &tasks;
+                tasker[t].me    = t;
+                (void) pthread_create( &thrd[t], NULL, stealwork, &tasker[t] );
+            }
+            for (t = 0; t < n; ++t) {
+                (void) pthread_join( thrd[t], NULL );
+            }
+            rate[mode]  = cnt / (now() - start) / 1e6;
+            for (t = 0; t < (tasks.steal ? n : 1); ++t) {
+                (void) dque_destroy( &tasks.deque[t] );
+            }
+        }
+        (void) printf( "%-8u %16.2f %16.2f\n", n, rate[0], rate[1] );
+    }
+}
+
+#define BACKLOG 1000                        /* keys in the queue throughout */
+
+/* one thread of the priority queue benchmark                               */
+struct prio {
+    dque_qhead         *queue;
+    pthread_mutex_t    *mutx;               /* caller's mutex, NULL = prio  */
+    unsigned long       cnt;                /* push/pop pairs to do         */
+    unsigned int        key;                /* random key state             */
+};
+
+/* the keys are the data pointers themselves, event times                  */
+int
+keycomp( void *k1, void *k2 )
+{
+    return (((size_t)k1 > (size_t)k2) - ((size_t)k1 < (size_t)k2));
+}
+
+void *
+priowork(
+void           *arg )                       /* struct prio                  */
+{
+    struct prio    *prio    = (struct prio *)arg;
+    void           *data;
+    unsigned long   i;
+
+    for (i = 0; i < prio->cnt; ++i) {       /* run the next event, schedule */
+        prio->key   = prio->key * 1664525u + 1013904223u;   /* one later    */
+        if (prio->mutx == NULL) {
+            (void) dque_pop_front( prio->queue, &data );
+            data    = (void *)((size_t)data + prio->key % 1000000 + 1);
+            (void) dque_push_back( prio->queue, data );
+        } else {
+            (void) pthread_mutex_lock( prio->mutx );
+            (void) dque_pop_front( prio->queue, &data );
+            (void) pthread_mutex_unlock( prio->mutx );
+            data    = (void *)((size_t)data + prio->key % 1000000 + 1);
+            (void) pthread_mutex_lock( prio->mutx );
+            (void) dque_key_insert( prio->queue, data, keycomp, data );
+            (void) pthread_mutex_unlock( prio->mutx );
+        }
+    }
+    return (NULL);
+}
+
+/* push/pop-min pairs per second on one priority queue, 1 to 32 threads     */
+void
+bench_prio(
+unsigned long   cnt )                       /* push/pop pairs in total      */
+{
+    pthread_t       thrd[32];
+    struct prio     prio[32];
+    pthread_mutex_t mutx;
+    dque_qhead     *queue;
+    void           *data;
+    unsigned int    n, t, mode, key;
+    double          start;
+    double          rate[3];
+
+    (void) printf( "\npriority queue, %lu push/pop-min pairs shared by all threads, %d keys queued\n", cnt, BACKLOG );
+    (void) printf( "%-8s %16s %16s %16s\n", "threads", "prio Mpairs/s", "key_ins Mpairs/s", "skip Mpairs/s" );
+    (void) pthread_mutex_init( &mutx, NULL );
+    for (n = 1; n <= 32; n *= 2) {
+        for (mode = 0; mode < 3; ++mode) {  /* prio, key_insert, skip list  */
+            if (mode == 0) {
+                (void) dque_create_prio( &queue, keycomp );
+            } else {
+                (void) dque_create( &queue, 0, NULL );
+                if (mode == 2) {
+                    (void) dque_options( queue, DQUEOPT_SKIPLIST, keycomp );
+                }
+            }
+            for (key = 1, t = 0; t < BACKLOG; ++t) {
+                key     = key * 1664525u + 1013904223u;
+                data    = (void *)(size_t)(key % 1000000 + 1);
+                if (mode == 0) {
+                    (void) dque_push_back( queue, data );
+                } else {
+                    (void) dque_key_insert( queue, data, keycomp, data );
+                }
+            }
+            start   = now();
+            for (t = 0; t < n; ++t) {
+                prio[t].queue   = queue;
+                prio[t].mutx    = (mode == 0) ? NULL : &mutx;
+                prio[t].cnt     = cnt / n;
+                prio[t].key     = t + 2;
+                (void) pthread_create( &thrd[t], NULL, priowork, &prio[t] );
+            }
+            for (t = 0; t < n; ++t) {
+                (void) pthread_join( thrd[t], NULL );
+            }
+            rate[mode]  = (cnt / n) * n / (now() - start) / 1e6;
+            (void) dque_destroy( &queue );
+        }
+        (void) printf( "%-8u %16.2f %16.2f %16.2f\n", n, rate[0], rate[1], rate[2] );
+    }
+    (void) pthread_mutex_destroy( &mutx );
+}
+
+int
+main( int argc, char *argv[] )
+{
+    unsigned long   cnt = (argc > 1) ? strtoul( argv[1], NULL, 10 ) : 1000000;
+
+    if (cnt == 0) {
+        (void) fprintf( stderr, "usage: %s [count]\n", argv[0] );
+        return (1);
+    }
+    bench_memory( cnt );
+    bench_locked( cnt );
+    bench_mpmc( cnt );
+    bench_spsc( cnt );
+    bench_wake( cnt );
+    bench_steal( cnt );
+    bench_prio( cnt );
+
+    return (0);
+}
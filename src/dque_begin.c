@@ -9,6 +9,12 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Use dque_myslot for chunked, ring, and FIFO queues
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
  *
  *      dque_begin(
  *              qhead          *queue,      queue with element data
@@ -51,17 +57,26 @@ dque_qhead     *queue,                      /* queue to have iterator       */
 dque_qiter    **iter )                      /* pointer to returned iterator */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    void          **slot;                   /* slot in chunked queue        */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (iter == NULL_QITERP) {       /* invalid iterator pointer?    */
         errcode = DQUEERR_NOITERP;
+    } else if (islockfree(queue)) {         /* only push_back and pop_front */
+        errcode = DQUEERR_NOTSUP;
+    } else if (isslots(queue)) {            /* first slot in use            */
+        slot    = dque_myslot_end( queue, 0 );
+        *iter   = (slot == (void **)NULL) ? NULL_QITER : slot2iter( slot );
     } else if (gethead(queue) == NULL_NODE){/* empty queue?                 */
         *iter   = NULL_QITER;               /* equal to dque_end()          */
     } else {
         *iter   = gethead( queue );         /* pointer to first node in queue */
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
@@ -0,0 +1,149 @@
+/**
+ *
+ *  \file	dque_compact.c
+ *  \name	dque_compact
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Relink a queue's qnodes in memory order.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
+ *
+ *      dque_compact(
+ *      dque_qhead             *queue )        queue to compact
+ *
+ *      After a long run of pushes and pops the qnodes of a queue are scattered
+ *      over its blocks, so walking the queue jumps around memory. dque_compact
+ *      gathers the queue's qnodes and the free list's qnodes, sorts them by
+ *      address, and moves the user's data so the queue, front to back, uses the
+ *      lowest addressed qnodes in address order. The remaining qnodes go back on
+ *      the free list in address order, so the next pushes continue upward and
+ *      blocks at the top are left free for dque_shrink_to_fit. The order of the
+ *      data in the queue is unchanged, but every iterator into the queue is
+ *      invalid afterwards. A skip list index is rebuilt. For a queue created with
+ *      dque_create_pool, only the pool's free qnodes are mixed with the queue's.
+ *
+ *      Chunked, ring, FIFO, and XOR queues are already compact and intrusive
+ *      queues link the user's memory, for these DQUEERR_NOTSUP is returned.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stdlib.h>                         /* need for qsort               */
+#include "mydque.h"
+#include "dque.h"
+
+/**
+ *  \name	dque_mynodecmp
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	qsort comparison of qnode addresses.
+ */
+
+static int
+dque_mynodecmp(
+const void     *n1,
+const void     *n2 )
+{
+    const dque_qnode   *p1  = *(dque_qnode * const *)n1;
+    const dque_qnode   *p2  = *(dque_qnode * const *)n2;
+
+    return ((p1 < p2) ? -1 : ((p1 > p2) ? 1 : 0));
+}
+
+dque_err                                    /* returned completion status   */
+dque_compact(                               /* relink qnodes in memory order*/
+dque_qhead     *queue )                     /* queue to compact             */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_qhead     *pool;                   /* qhead with the free list     */
+    dque_qnode    **nodes;                  /* queue and free qnodes        */
+    void          **data    = (void **)NULL;    /* data in queue order  */
+    dque_qnode     *list;                   /* relinked list                */
+    dque_qnode     *currp;
+    COMPFUNC        comp;                   /* skip list to rebuild, if any */
+    unsigned int    hcnt, lcnt, i;
+
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        return (DQUEERR_NOQUEUE);
+    } else if (isslots(queue) || islockfree(queue) || getflag(queue, DQUE_INTRUSIVE)) {
+        return (DQUEERR_NOTSUP);            /* no qnodes to relink          */
+    }
+
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    comp    = getflag(queue, DQUE_SKIPLIST) ? getscmp(queue) : (COMPFUNC)NULL;
+    if (comp != (COMPFUNC)NULL) {           /* index qnodes are freed too   */
+        (void) dque_myskipset( queue, (COMPFUNC)NULL );
+    }
+
+    pool    = getnodes(queue);
+    dque_mylockpool( queue, pool );
+    hcnt    = gethcnt(queue);
+    lcnt    = getfcnt(pool) - getccnt(pool);    /* # on free list           */
+    if (hcnt + lcnt == 0) {                 /* nothing to relink            */
+        ;
+    } else if ((nodes = (dque_qnode **)dque_mymalloc( pool, (hcnt + lcnt) * sizeof(dque_qnode *) )) == NULL_NODEP) {
+        errcode = DQUEERR_NOALLOC;
+    } else if (hcnt != 0 && (data = (void **)dque_mymalloc( pool, hcnt * sizeof(void *) )) == (void **)NULL) {
+        dque_myfree( pool, nodes, (hcnt + lcnt) * sizeof(dque_qnode *) );
+        errcode = DQUEERR_NOALLOC;
+    } else {
+        for (i = 0, currp = gethead(queue); i < hcnt; ++i, currp = getnext(currp)) {
+            nodes[i]    = currp;
+            data[i]     = getdata(currp);
+        }
+        for (i = 0, currp = getfree(pool); i < lcnt; ++i, currp = getnext(currp)) {
+            nodes[hcnt + i] = currp;
+        }
+        qsort( nodes, hcnt + lcnt, sizeof(dque_qnode *), dque_mynodecmp );
+
+        for (i = 0, list = NULL_NODE; i < hcnt; ++i) {  /* lowest for queue */
+            setdata(  nodes[i], data[i] );
+            setowner( nodes[i], queue   );
+            (void) dque_myinsert( &list, nodes[i], NOROTATE, (unsigned int *)NULL );
+        }
+        sethead( queue, list );
+        for (list = NULL_NODE; i < hcnt + lcnt; ++i) {  /* rest are free    */
+            setdata(  nodes[i], (void *)NULL );
+            setowner( nodes[i], NULL_QUEUE   );
+            (void) dque_myinsert( &list, nodes[i], NOROTATE, (unsigned int *)NULL );
+        }
+        setfree( pool, list );
+
+        if (hcnt != 0) {
+            dque_myfree( pool, data, hcnt * sizeof(void *) );
+        }
+        dque_myfree( pool, nodes, (hcnt + lcnt) * sizeof(dque_qnode *) );
+    }
+    dque_myunlockpool( queue, pool );
+
+    if (comp != (COMPFUNC)NULL) {           /* rebuild the skip list index  */
+        (void) dque_myskipset( queue, comp );
+    }
+    dque_myunlock( queue );
+
+    return (errcode);
+}
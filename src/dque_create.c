@@ -9,6 +9,23 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Initialize skip list, growth policy, and watermark fields
+ *  1.2		10/17/2026  	agent       Added dque_pool_create and dque_create_pool
+ *  1.2		10/17/2026  	agent       Static buffer qnodes are carved lazily, create is O(1)
+ *  1.2		10/17/2026  	agent       Added dque_create_alloc and dque_pool_create_alloc
+ *  1.2		10/17/2026  	agent       Added dque_create_chunk
+ *  1.2		10/17/2026  	agent       Added dque_create_ring
+ *  1.2		10/17/2026  	agent       Dynamic queues start with DQUE_INLINECNT inline qnodes
+ *  1.2		10/17/2026  	agent       Added dque_create_fifo
+ *  1.2		10/17/2026  	agent       Added dque_create_xor
+ *  1.2		10/17/2026  	agent       dque_create_pool holds a DQUEOPT_LOCKED pool's mutex
+ *  1.2		10/17/2026  	agent       Added dque_create_mpmc
+ *  1.2		10/17/2026  	agent       Added dque_create_spsc
+ *  1.2		10/17/2026  	agent       Waits on MPMC and SPSC queues
+ *  1.2		10/17/2026  	agent       Added dque_create_steal
+ *  1.2		10/17/2026  	agent       Added dque_create_prio
+ *  1.2		10/17/2026  	agent       Shrink qhead, on-demand lock
+ *  1.2		10/17/2026  	agent       Lock-free block through dque_mymalloc, freed if init fails
  *
  *      create(
  *      dque_qheadp            *queuep,        pointer to pointer to queue head
@@ -24,14 +41,22 @@
  *      option. The third, and final, method is provided as a convenience and is a slight variation of the second
  *      method in that the specified buffer is much larger than the qhead structure. The extra buffer space is then
  *      used to create as many qnodes as possible and placed on the free list. The user can dque_max_size function
- *      to query how many nodes were created.
+ *      to query how many nodes were created. The qnodes are not touched here, they are carved one at a time from
+ *      the buffer as the queue first needs them, see dque_mypopulate, so create is O(1) for any buffer size.
  *
  *      The queue head structure contains pointers to three lists. The first, called head, is the actual user queue,
  *      the second, called free, is the free list holding the nodes that are available for the user, but not yet used.
  *      The third list, called blks, is used by the library to track dynamic memory allocations. The qnodes are
  *      created in groups as a single dynamic memory allocation. The pointer to the memory allocation is also a pointer
  *      to the first node, so the first node is inserted onto the third list, blks, to be used later to free the memory
- *      allocations. The remaining qnodes are put on the free list.
+ *      allocations. The remaining qnodes are put on the free list. A dynamically allocated qhead is followed by
+ *      DQUE_INLINECNT qnodes of its own which are carved before any block is allocated, so a queue that never
+ *      holds more than a few elements costs one allocation, the qhead, and no block list is created until the
+ *      inline qnodes run out. Queues that do not link qnodes, and queues using a pool, are created without them.
+ *
+ *      Only the fields of the queue's own backend are kept, in a union keyed on the DQUE_CHUNKED, DQUE_RING,
+ *      DQUE_FIFO, DQUE_XOR, or lock-free flag, and the DQUEOPT_LOCKED mutex and the waiters' condvars are
+ *      allocated only when they are turned on, see dque_mylockset.
  *
  *      The queue head also contains counts for each of the three lists plus a variable of bit flags to be used to
  *      control the behavior of the library functions by getting and setting the bit flags. The last variable
@@ -81,6 +106,161 @@ dque_qhead     *queue )                     /* pointer to queue             */
     setfcnt( queue, 0            );         /* current # nodes on free list */
     setbcnt( queue, 0            );         /* current # nodes on blks list */
     setacnt( queue, DQUE_NODECNT );         /* default node count allocation*/
+    setncnt( queue, DQUE_NODECNT );         /* restored by DQUEOPT_GROWFIX  */
+    setgcap( queue, 0            );         /* fixed size node allocation   */
+    setwmhi( queue, 0            );         /* no free node watermarks      */
+    setwmlo( queue, 0            );
+    setwtrg( queue, 0            );
+    setpool( queue, NULL_QUEUE   );         /* queue has its own free list  */
+    setqcnt( queue, 0            );         /* # of queues using this pool  */
+    setcarv( queue, NULL_NODE    );         /* no qnodes to carve           */
+    setccnt( queue, 0            );         /* # of qnodes not yet carved   */
+    setskip( queue, NULL_NODE    );         /* no skip list index           */
+    setscmp( queue, (COMPFUNC)NULL );       /* no skip list compare function*/
+    setslvl( queue, 0            );         /* # of skip list index levels  */
+    setsran( queue, DQUE_SKIPSEED );        /* skip list random level state */
+    setamal( queue, (DQUEMALLOC)NULL );     /* use malloc and free          */
+    setafre( queue, (DQUEFREE)NULL   );
+    setactx( queue, (void *)NULL     );
+    setaren( queue, (void *)NULL     );     /* no mmap'd node arena         */
+    setalen( queue, 0                );
+    setioff( queue, 0                );     /* not an intrusive queue       */
+    setkhead( queue, NULL_CHUNK      );     /* not a chunked queue          */
+    setktail( queue, NULL_CHUNK      );
+    setkspr(  queue, NULL_CHUNK      );
+    setkcur(  queue, NULL_CHUNK      );
+    setkslt(  queue, 0               );
+    setkcnt(  queue, 0               );
+    setrbuf(  queue, (void **)NULL   );     /* not a ring queue             */
+    setrcap(  queue, 0               );
+    setrhed(  queue, 0               );
+    setshed(  queue, NULL_SNODE      );     /* not a FIFO queue             */
+    setstal(  queue, NULL_SNODE      );
+    setsfre(  queue, NULL_SNODE      );
+    setsblk(  queue, NULL_SNODE      );
+    setxcur(  queue, NULL_SNODE      );     /* not an XOR queue             */
+    setxprv(  queue, NULL_SNODE      );
+    setlbuf(  queue, NULL            );     /* not a lock-free queue        */
+    setlcap(  queue, 0               );
+#ifdef DQUE_LOCK
+    setlckp(  queue, NULL            );     /* no mutex or condvars yet     */
+#endif
+#ifdef DQUE_COMPACT
+    setnlo(  queue, NULL_NODE        );     /* no qnode memory yet          */
+    setnhi(  queue, NULL_NODE        );
+#endif
+
+    return (errcode);
+}
+
+/**
+ *  \name 	dque_create_lockfree
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create a lock-free queue, in the user's buffer or allocated.
+ */
+
+dque_err static                             /* returned completion status   */
+dque_create_lockfree(                       /* internal helper function     */
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+unsigned int    siz,                        /* size of the buffer, 0=allocate */
+char           *buf,                        /* ptr to buffer to use for head*/
+unsigned int    flg )                       /* DQUE_MPMC, SPSC, STEAL or PRIO */
+{
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+#ifdef DQUE_ATOMIC
+    size_t          len     = (flg == DQUE_MPMC) ? DQUE_MPMCLEN( DQUE_MPMCCNT )
+                            : (flg == DQUE_SPSC) ? DQUE_SPSCLEN( DQUE_SPSCCNT )
+                            : (flg == DQUE_PRIO) ? DQUE_PRIOLEN : DQUE_STEALLEN( DQUE_STEALCNT );
+    unsigned int    alloc   = (siz == 0);   /* block is freed on failure    */
+    dque_qhead      dflt;                   /* no allocator callbacks yet   */
+#endif
+
+#ifndef DQUE_ATOMIC
+    errcode = DQUEERR_NOTSUP;               /* no atomic builtins           */
+#else
+    setamal( &dflt, (DQUEMALLOC)NULL );     /* dque_mymalloc uses malloc    */
+    setafre( &dflt, (DQUEFREE)NULL   );
+    setactx( &dflt, NULL             );
+    if (queuep == NULL_QUEUEP) {            /* invalid queue head pointer?  */
+        errcode = DQUEERR_NOQUEUEP;
+    } else if (siz == 0 && (buf = (char *)dque_mymalloc( &dflt, len )) == (char *)NULL) {
+        errcode = DQUEERR_NOALLOC;          /* qhead and cells allocation fail? */
+    } else if (siz <= sizeof(dque_qhead) + DQUE_LOCKLEN && siz != 0) {  /* no room for cells? */
+        if ((errcode = dque_create( queuep, siz, buf )) == DQUEERR_NOERR) {
+            errcode = DQUEERR_MINCNT;
+        }
+    } else if ((errcode = dque_create( queuep, sizeof(dque_qhead), buf )) != DQUEERR_NOERR) {
+        ;                                   /* same checks as dque_create   */
+    } else {                                /* cells follow qhead in buffer */
+        if (siz == 0) {                     /* qhead and cells in one block */
+            resetflag( *queuep, DQUE_NOALLOC );     /* dque_destroy frees it*/
+            siz     = (unsigned int)len;
+        }
+#ifdef DQUE_WAIT
+        setlckp( *queuep, (dque_lock *)(buf + sizeof(dque_qhead)) );   /* waiters' */
+#endif                                      /* condvars follow the qhead    */
+        buf    += DQUE_LOCKLEN;
+        siz    -= DQUE_LOCKLEN;
+        if (flg == DQUE_MPMC) {
+            errcode = dque_mympmc_init( *queuep, buf + sizeof(dque_qhead), siz - sizeof(dque_qhead) );
+        } else if (flg == DQUE_SPSC) {
+            errcode = dque_myspsc_init( *queuep, buf + sizeof(dque_qhead), siz - sizeof(dque_qhead) );
+        } else if (flg == DQUE_PRIO) {
+            errcode = dque_myprio_init( *queuep, buf + sizeof(dque_qhead), siz - sizeof(dque_qhead) );
+        } else {
+            errcode = dque_mysteal_init( *queuep, buf + sizeof(dque_qhead), siz - sizeof(dque_qhead) );
+        }
+        if (errcode == DQUEERR_NOERR) {
+            setflag( *queuep, flg );
+            (void) dque_mywaitset( *queuep, 1 );        /* condvars for waits */
+        } else if (alloc) {                 /* release the block again      */
+            dque_myfree( *queuep, *queuep, len );
+            *queuep = NULL_QUEUE;
+        }
+    }
+#endif
+
+    return (errcode);
+}
+
+/**
+ *  \name 	dque_create_head
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Allocate and initialize a qhead, with inl inline qnodes after it.
+ */
+
+dque_err static                             /* returned completion status   */
+dque_create_head(                           /* internal helper function     */
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+DQUEMALLOC      amal,                       /* user's malloc, NULL = malloc */
+DQUEFREE        afre,                       /* user's free, NULL = free     */
+void           *ctx,                        /* context for amal and afre    */
+unsigned int    inl )                       /* # of inline qnodes, 0 = none */
+{
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_qhead     *queue   = NULL_QUEUE;
+    size_t          len     = sizeof(dque_qhead) + (size_t)inl * sizeof(dque_qnode);
+
+    if (queuep == NULL_QUEUEP) {            /* invalid queue head pointer?  */
+        errcode = DQUEERR_NOQUEUEP;
+    } else if ((amal == (DQUEMALLOC)NULL) != (afre == (DQUEFREE)NULL)) {
+        errcode = DQUEERR_INVARG;           /* need both callbacks or none  */
+    } else if (amal == (DQUEMALLOC)NULL && (queue = (dque_qhead *)malloc( len )) == NULL_QUEUE) {
+        errcode = DQUEERR_NOALLOC;          /* queue head allocation fail?  */
+    } else if (amal != (DQUEMALLOC)NULL && (queue = (dque_qhead *)amal( ctx, len )) == NULL_QUEUE) {
+        errcode = DQUEERR_NOALLOC;          /* user's allocation fail?      */
+    } else if ((errcode = dque_populate_head( queue )) == DQUEERR_NOERR) {
+        setamal( queue, amal );             /* allocator for everything else */
+        setafre( queue, afre );
+        setactx( queue, ctx  );
+        if (inl != 0) {                     /* first qnodes are inline      */
+            setflag( queue, DQUE_INLINE );
+            errcode = dque_mypopulate( queue, inl, getinln(queue) );
+        }
+        *queuep = queue;
+    }
 
     return (errcode);
 }
@@ -98,11 +278,7 @@ char           *buf )                       /* ptr to buffer to use for head*/
     if (queuep == NULL_QUEUEP) {            /* invalid queue head pointer?  */
         errcode = DQUEERR_NOQUEUEP;
     } else if (siz == 0) {                  /* use dynamic memory allocation? */
-        if ((queue = (dque_qhead *)malloc( sizeof(dque_qhead) )) == NULL_QUEUE) {
-	    errcode = DQUEERR_NOALLOC;      /* queue head allocation fail?  */
-        } else if ((errcode = dque_populate_head( queue )) == DQUEERR_NOERR) {
-            *queuep = queue;
-        }
+        errcode = dque_create_alloc( queuep, (DQUEMALLOC)NULL, (DQUEFREE)NULL, (void *)NULL );
     } else {                                /* do not use dynamic memory    */
         if (siz < sizeof(dque_qhead)) {     /* buffer size too small?       */
             errcode = DQUEERR_BUFSIZE;
@@ -130,3 +306,538 @@ char           *buf )                       /* ptr to buffer to use for head*/
     return (errcode);
 }
 
+/**
+ *
+ *  \name	dque_create_alloc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty queue that uses the user's allocator.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_alloc(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      DQUEMALLOC              amal,          user's malloc, called as amal( ctx, siz )
+ *      DQUEFREE                afre,          user's free, called as afre( ctx, ptr, siz )
+ *      void                   *ctx )          user's context passed to amal and afre
+ *
+ *      Create an empty queue like dque_create with a buffer size of 0 (zero), except
+ *      the qhead, every qnode block, and any scratch memory are allocated with amal
+ *      and released with afre instead of malloc and free. The size given to amal is
+ *      passed back to afre, so a size-class or per-thread arena allocator can be used
+ *      without LD_PRELOAD. Either both callbacks or neither must be given, passing
+ *      NULL for both is the same as dque_create( queuep, 0, NULL ).
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_alloc(                          /* create a queue, user allocator */
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+DQUEMALLOC      amal,                       /* user's malloc, NULL = malloc */
+DQUEFREE        afre,                       /* user's free, NULL = free     */
+void           *ctx )                       /* context for amal and afre    */
+{                                           /*------------------------------*/
+#ifdef DQUE_COMPACT
+    return (dque_create_head( queuep, amal, afre, ctx, 0 ));   /* heap qhead is */
+#else                                       /* outside the compact window   */
+    return (dque_create_head( queuep, amal, afre, ctx, DQUE_INLINECNT ));
+#endif
+}
+
+/**
+ *
+ *  \name	dque_pool_create
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty node pool to be shared by many queues.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_pool_create(
+ *      dque_pool             **poolp,         pointer to pointer to node pool
+ *      unsigned                siz,           size of the static memory buffer
+ *      char                   *buf )          pointer to static memory to use for pool and qnode allocations
+ *
+ *      A node pool is a qhead that is only used for its free and blks lists. Queues
+ *      created against the pool with dque_create_pool take their qnodes from, and
+ *      return them to, the pool's free list instead of their own, so qnodes freed by
+ *      one queue are reused by the next queue that needs one. With thousands of small
+ *      queues this replaces thousands of partly used blocks with one set of blocks.
+ *      The arguments are the same as dque_create, and DQUEOPT_NODECNT, DQUEOPT_GROWGEO,
+ *      DQUEOPT_WATERMARK, and dque_shrink_to_fit may be used on the pool.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the node pool
+ */
+
+dque_err                                    /* returned completion status   */
+dque_pool_create(                           /* create a node pool           */
+dque_poolp     *poolp,                      /* ptr to ptr to pool           */
+unsigned int    siz,                        /* size of the buffer           */
+char           *buf )                       /* ptr to buffer to use for pool*/
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if ((errcode = dque_create( poolp, siz, buf )) == DQUEERR_NOERR) {
+        setflag( *poolp, DQUE_POOL );       /* mark qhead as a pool         */
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_pool_create_alloc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty node pool that uses the user's allocator.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_pool_create_alloc(
+ *      dque_pool             **poolp,         pointer to pointer to node pool
+ *      DQUEMALLOC              amal,          user's malloc, called as amal( ctx, siz )
+ *      DQUEFREE                afre,          user's free, called as afre( ctx, ptr, siz )
+ *      void                   *ctx )          user's context passed to amal and afre
+ *
+ *      Create a node pool like dque_pool_create whose memory comes from the user's
+ *      allocator, see dque_create_alloc. Queues created with dque_create_pool on
+ *      this pool allocate their qheads with the same allocator.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the node pool
+ */
+
+dque_err                                    /* returned completion status   */
+dque_pool_create_alloc(                     /* create a pool, user allocator*/
+dque_poolp     *poolp,                      /* ptr to ptr to pool           */
+DQUEMALLOC      amal,                       /* user's malloc, NULL = malloc */
+DQUEFREE        afre,                       /* user's free, NULL = free     */
+void           *ctx )                       /* context for amal and afre    */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if ((errcode = dque_create_alloc( poolp, amal, afre, ctx )) == DQUEERR_NOERR) {
+        setflag( *poolp, DQUE_POOL );       /* mark qhead as a pool         */
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_create_pool
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty queue that uses a shared node pool.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_pool(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      dque_pool              *pool )         node pool from dque_pool_create
+ *
+ *      Create an empty queue with a dynamically allocated qhead whose qnodes come
+ *      from the specified node pool. The pool cannot be destroyed until every queue
+ *      using it has been destroyed.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_pool(                           /* create a queue using a pool  */
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+dque_pool      *pool )                      /* shared node pool             */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (queuep == NULL_QUEUEP) {            /* invalid queue head pointer?  */
+        errcode = DQUEERR_NOQUEUEP;
+    } else if (pool == NULL_QUEUE) {        /* invalid pool pointer?        */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (getflag( pool, DQUE_POOL ) == 0) {   /* not a node pool?     */
+        errcode = DQUEERR_INVARG;
+    } else if ((errcode = dque_create_head( queuep, getamal(pool), getafre(pool), getactx(pool), 0 )) == DQUEERR_NOERR) {
+        setpool( *queuep, pool );           /* use the pool's free list     */
+        dque_mylock( pool );                /* DQUEOPT_LOCKED pool?         */
+        inc_uns( getqcnt(pool) );
+        dque_myunlock( pool );
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_create_chunk
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty queue that keeps its data in chunks.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_chunk(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      unsigned                cnt )          # of data pointers in each chunk, 0 = DQUE_CHUNKCNT
+ *
+ *      Create an empty queue with a dynamically allocated qhead that keeps the user's
+ *      data pointers in chunks of cnt contiguous slots, like std::deque, instead of
+ *      one qnode per element. Pushing and popping at either end is O(1) and only
+ *      allocates a chunk every cnt pushes, and walking the queue with dque_begin and
+ *      dque_next reads consecutive memory. Iterators work as for any other queue but,
+ *      as with std::deque, dque_insert and dque_erase invalidate the iterators to
+ *      elements in the same chunk. A chunked queue can not be used with the
+ *      DQUEOPT_SKIPLIST or DQUEOPT_INTRUSIVE options.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_chunk(                          /* create a chunked queue       */
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+unsigned int    cnt )                       /* # of slots per chunk, 0=default */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (queuep == NULL_QUEUEP) {            /* invalid queue head pointer?  */
+        errcode = DQUEERR_NOQUEUEP;
+    } else if (cnt == 1) {                  /* need room to split a chunk   */
+        errcode = DQUEERR_MINCNT;
+    } else if ((errcode = dque_create_head( queuep, (DQUEMALLOC)NULL, (DQUEFREE)NULL, (void *)NULL, 0 )) == DQUEERR_NOERR) {
+        setflag( *queuep, DQUE_CHUNKED );
+        setkslt( *queuep, (cnt == 0) ? DQUE_CHUNKCNT : cnt );
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_create_ring
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty queue that keeps its data in a ring buffer.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_ring(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      unsigned                siz,           size of the static memory buffer
+ *      char                   *buf )          pointer to static memory to use for qhead and ring
+ *
+ *      Create an empty queue that keeps the user's data pointers in a power of two
+ *      ring of slots instead of qnodes. It is meant for a queue that is only used as
+ *      a FIFO or LIFO, for example through the que_* and stk_* functions of
+ *      dque_util.h: push and pop at either end, front, back, size, empty, key_find,
+ *      and iteration work as for any other queue. dque_insert, dque_erase,
+ *      dque_key_insert, and dque_key_erase would have to move elements and return
+ *      DQUEERR_NOTSUP instead, as do DQUEOPT_SKIPLIST and DQUEOPT_INTRUSIVE.
+ *
+ *      With a buffer size of 0 (zero) the qhead and ring are allocated dynamically,
+ *      the ring starts with DQUE_RINGCNT slots and doubles whenever it is full, and
+ *      dque_reserve grows it ahead of time. Otherwise the qhead and the ring are put
+ *      in the user's buffer, the ring gets the largest power of two number of slots
+ *      that fits after the qhead, and a push onto a full ring returns DQUEERR_ALLOCNA.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_ring(                           /* create a ring buffer queue   */
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+unsigned int    siz,                        /* size of the buffer           */
+char           *buf )                       /* ptr to buffer to use for head*/
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    unsigned int    cnt     = 0;            /* # of ring slots in buffer    */
+    unsigned int    cap     = 1;
+
+    if (siz > sizeof(dque_qhead)) {         /* # of slots after the qhead   */
+        cnt     = (unsigned int)((siz - sizeof(dque_qhead)) / sizeof(void *));
+    }
+    while (cap <= cnt / 2) {                /* largest power of two <= cnt  */
+        cap    *= 2;
+    }
+
+    if (siz != 0 && siz >= sizeof(dque_qhead) && buf != (char *)NULL && cnt < (unsigned int)DQUE_MINCNT) {
+        errcode = DQUEERR_MINCNT;           /* no room for a ring?          */
+    } else if (siz == 0 && (errcode = dque_create_head( queuep, (DQUEMALLOC)NULL, (DQUEFREE)NULL, (void *)NULL, 0 )) != DQUEERR_NOERR) {
+        ;                                   /* no inline qnodes for a ring  */
+    } else if (siz != 0 && (errcode = dque_create( queuep, sizeof(dque_qhead), buf )) != DQUEERR_NOERR) {
+        ;                                   /* same checks as dque_create   */
+    } else if (siz != 0) {                  /* ring follows qhead in buffer */
+        setflag( *queuep, DQUE_RING );
+        setrbuf( *queuep, (void **)(buf + sizeof(dque_qhead)) );
+        setrcap( *queuep, cap );
+    } else {                                /* ring allocated on first push */
+        setflag( *queuep, DQUE_RING );
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_create_fifo
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty singly-linked FIFO queue.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_fifo(
+ *      dque_qheadp            *queuep )       pointer to pointer to queue head
+ *
+ *      Create an empty queue with a dynamically allocated qhead that links its data
+ *      with forward links only, plus a pointer to the last element, for a queue that
+ *      is only pushed onto the back and popped off the front. Each element uses half
+ *      the memory of a qnode and each push or pop stores one link instead of two.
+ *      push_back, push_front, pop_front, front, back, size, empty, max_size, key_find,
+ *      begin, and next work as for any other queue. pop_back, rbegin, rnext, insert,
+ *      erase, key_insert, key_erase, DQUEOPT_SKIPLIST, and DQUEOPT_INTRUSIVE need
+ *      backward links and return DQUEERR_NOTSUP.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_fifo(                           /* create a FIFO queue          */
+dque_qheadp    *queuep )                    /* ptr to ptr to queue          */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if ((errcode = dque_create_head( queuep, (DQUEMALLOC)NULL, (DQUEFREE)NULL, (void *)NULL, 0 )) == DQUEERR_NOERR) {
+        setflag( *queuep, DQUE_FIFO );      /* snodes, no inline qnodes     */
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_create_xor
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty XOR-linked queue.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_xor(
+ *      dque_qheadp            *queuep )       pointer to pointer to queue head
+ *
+ *      Create an empty queue with a dynamically allocated qhead whose elements have
+ *      a single link, the XOR of the addresses of their neighbours, see dque_myxor.c.
+ *      Each element uses half the memory of a qnode, like dque_create_fifo, but the
+ *      queue can still be pushed and popped at both ends and iterated from either
+ *      end with dque_begin and dque_next or dque_rbegin and dque_rnext. The queue
+ *      remembers the neighbour of the element an iterator last moved to, so these
+ *      loops are O(1) per step. insert, erase, key_insert, key_erase, DQUEOPT_SKIPLIST,
+ *      and DQUEOPT_INTRUSIVE return DQUEERR_NOTSUP.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_xor(                            /* create an XOR-linked queue   */
+dque_qheadp    *queuep )                    /* ptr to ptr to queue          */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if ((errcode = dque_create_fifo( queuep )) == DQUEERR_NOERR) {
+        resetflag( *queuep, DQUE_FIFO );    /* same snodes, XOR links       */
+        setflag(   *queuep, DQUE_XOR  );
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_create_mpmc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty lock-free bounded MPMC queue.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_mpmc(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      unsigned                siz,           size of the static memory buffer
+ *      char                   *buf )          pointer to static memory to use for qhead and cells
+ *
+ *      Create an empty queue that many threads may push onto the back of and pop
+ *      off the front of at the same time without a lock, see dque_mympmc.c. It is
+ *      bounded: dque_push_back onto a full queue returns DQUEERR_FULL, and
+ *      dque_pop_front off an empty one returns DQUEERR_EMPTY with NULL data, so the
+ *      caller decides whether to retry, back off, drop, or block in
+ *      dque_push_back_wait or dque_pop_front_wait. dque_size and dque_empty
+ *      return a snapshot that may be stale by the time it is read, and dque_max_size
+ *      returns the number of cells. Every other call, and DQUEOPT_LOCKED,
+ *      DQUEOPT_SKIPLIST, and DQUEOPT_INTRUSIVE, returns DQUEERR_NOTSUP, since it
+ *      could not be made safe against a concurrent push or pop.
+ *
+ *      As with dque_create_ring, a buffer size of 0 (zero) allocates the qhead and
+ *      DQUE_MPMCCNT cells dynamically, in one block. Otherwise the qhead and the cells are put in
+ *      the user's buffer, and the cells get the largest power of two that fits after
+ *      the qhead and the two cache lines holding the positions. dque_destroy must
+ *      not race a push or pop. Without atomic builtins, see DQUE_ATOMIC in mydque.h,
+ *      DQUEERR_NOTSUP is returned.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_mpmc(                           /* create a lock-free MPMC queue*/
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+unsigned int    siz,                        /* size of the buffer           */
+char           *buf )                       /* ptr to buffer to use for head*/
+{                                           /*------------------------------*/
+
+    return (dque_create_lockfree( queuep, siz, buf, DQUE_MPMC ));
+}
+
+/**
+ *
+ *  \name	dque_create_spsc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty wait-free single-producer, single-consumer queue.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_spsc(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      unsigned                siz,           size of the static memory buffer
+ *      char                   *buf )          pointer to static memory to use for qhead and slots
+ *
+ *      Create an empty queue for exactly one producer thread, which calls
+ *      dque_push_back or dque_push_back_n, and one consumer thread, which calls
+ *      dque_pop_front or dque_pop_front_n, without a lock, see dque_myspsc.c. Each
+ *      push and pop is a few loads and stores on the thread's own cache line, and
+ *      the _n forms move a batch of pointers for the cost of one. As with
+ *      dque_create_mpmc, a push onto a full queue returns DQUEERR_FULL, a pop off an
+ *      empty one returns DQUEERR_EMPTY, dque_size and dque_empty return a snapshot,
+ *      and every other call returns DQUEERR_NOTSUP. The producer may block in
+ *      dque_push_back_wait and the consumer in dque_pop_front_wait. A second producer or consumer
+ *      thread corrupts the queue, use dque_create_mpmc for that.
+ *
+ *      A buffer size of 0 (zero) allocates the qhead and DQUE_SPSCCNT slots
+ *      dynamically, in one block. Otherwise the qhead and the slots are put in the
+ *      user's buffer, and the slots get the largest power of two that fits after the
+ *      qhead and the two cache lines holding the indexes.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_spsc(                           /* create a wait-free SPSC queue*/
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+unsigned int    siz,                        /* size of the buffer           */
+char           *buf )                       /* ptr to buffer to use for head*/
+{                                           /*------------------------------*/
+
+    return (dque_create_lockfree( queuep, siz, buf, DQUE_SPSC ));
+}
+
+/**
+ *
+ *  \name	dque_create_steal
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty Chase-Lev work-stealing deque.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_steal(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      unsigned                siz,           size of the static memory buffer
+ *      char                   *buf )          pointer to static memory to use for qhead and slots
+ *
+ *      Create an empty deque for the work-stealing pattern, see dque_mysteal.c. One
+ *      thread owns it and is the only one that may call dque_push_front and
+ *      dque_pop_front, which push and pop its newest work without a lock. Any number
+ *      of other threads may call dque_steal_back at the same time to take the oldest
+ *      work. dque_pop_front and dque_steal_back off an empty deque return
+ *      DQUEERR_EMPTY with NULL data. dque_size and dque_empty return a snapshot, and
+ *      dque_max_size the size of the array. dque_reserve, from the owner, grows the
+ *      array ahead of time. Every other call returns DQUEERR_NOTSUP.
+ *
+ *      A buffer size of 0 (zero) allocates the qhead and an array of DQUE_STEALCNT
+ *      slots dynamically, in one block, and the owner doubles the array when it is
+ *      full. Otherwise the qhead and the array are put in the user's buffer, the
+ *      array gets the largest power of two that fits, and a push onto a full deque
+ *      returns DQUEERR_FULL. Without atomic builtins DQUEERR_NOTSUP is returned.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_steal(                          /* create a work-stealing deque */
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+unsigned int    siz,                        /* size of the buffer           */
+char           *buf )                       /* ptr to buffer to use for head*/
+{                                           /*------------------------------*/
+
+    return (dque_create_lockfree( queuep, siz, buf, DQUE_STEAL ));
+}
+
+/**
+ *
+ *  \name	dque_create_prio
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Create an empty lock-free priority queue.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_create_prio(
+ *      dque_qheadp            *queuep,        pointer to pointer to queue head
+ *      COMPFUNC                comp )         user defined comparison function
+ *
+ *      Create an empty priority queue that any number of threads may push onto and
+ *      pop off at the same time without a lock, see dque_myprio.c. dque_push_back
+ *      puts the data in the queue in the order of comp, called as comp( new, old ),
+ *      behind any data it compares equal to, like dque_key_insert. dque_pop_front
+ *      returns the smallest data, or DQUEERR_EMPTY with NULL data when there is
+ *      none. A pop that overlaps a push of smaller data may return the next data
+ *      instead. dque_size and dque_empty return a snapshot, dque_pop_front_wait and
+ *      dque_push_back_wait may be used, and every other call returns DQUEERR_NOTSUP.
+ *
+ *      The queue is allocated and each push allocates a skip list node, which is
+ *      freed a while after its pop, once no other thread can still be reading it.
+ *      Another thread's push or pop may likewise still call comp on data for a
+ *      moment after it is popped, so popped data must stay readable to comp until
+ *      the pushes and pops running when it was popped have returned. Without atomic
+ *      builtins DQUEERR_NOTSUP is returned.
+ *
+ *      \return non-zero for failure, zero for success and a pointer to the head of the queue
+ */
+
+dque_err                                    /* returned completion status   */
+dque_create_prio(                           /* create a lock-free prio queue*/
+dque_qheadp    *queuep,                     /* ptr to ptr to queue          */
+COMPFUNC        comp )                      /* user comparison function     */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (queuep == NULL_QUEUEP) {            /* invalid queue head pointer?  */
+        errcode = DQUEERR_NOQUEUEP;
+    } else if (comp == (COMPFUNC)NULL) {    /* no comparison function?      */
+        errcode = DQUEERR_NOCOMP;
+    } else if ((errcode = dque_create_lockfree( queuep, 0, (char *)NULL, DQUE_PRIO )) == DQUEERR_NOERR) {
+        getprio(*queuep)->comp = comp;      /* order of the skip list       */
+    }
+
+    return (errcode);
+}
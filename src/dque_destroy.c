@@ -9,6 +9,18 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Added shared node pools and dque_pool_destroy
+ *  1.2		10/17/2026  	agent       Release memory through the queue's allocator
+ *  1.2		10/17/2026  	agent       Unmap the node arena
+ *  1.2		10/17/2026  	agent       Clear the user's dque_links of an intrusive queue
+ *  1.2		10/17/2026  	agent       Free the chunks of a chunked queue
+ *  1.2		10/17/2026  	agent       Free the ring of a ring buffer queue
+ *  1.2		10/17/2026  	agent       Free the snode blocks of a FIFO queue
+ *  1.2		10/17/2026  	agent       Destroy the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       Destroy the condvars for waits
+ *  1.2		10/17/2026  	agent       Free a work-stealing deque's grown arrays
+ *  1.2		10/17/2026  	agent       Free a priority queue's skip list pnodes
+ *  1.2		10/17/2026  	agent       Shrink qhead, on-demand lock
  *
  *      dque_destroy(
  *      dque_qheadp            *queuep )       pointer to pointer to queue head
@@ -20,6 +32,15 @@
  *      opposite order of their allocation. The function then frees the
  *      qhead and sets the user's qhead pointer to NULL.
  *
+ *      A queue created with dque_create_pool has no blocks of its own, so
+ *      its qnodes are returned to the pool's free list instead, which is
+ *      O(n) in the number of qnodes in the queue. A node pool cannot be
+ *      destroyed while any queue is still using it.
+ *
+ *      The objects on a DQUEOPT_INTRUSIVE queue belong to the user, so their
+ *      dque_links are only cleared, which is O(n), and they can be linked
+ *      on another queue afterwards.
+ *
  *      \return non-zero for failure, zero for success
  *
  * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
@@ -43,10 +64,33 @@
  */
 
 #include <stdio.h>                          /* need NULL definition         */
-#include <stdlib.h>                         /* need for malloc and free     */
 #include "mydque.h"
 #include "dque.h"
 
+/**
+ *  \name 	dque_unlink_all
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Remove every object from an intrusive queue.
+ */
+
+dque_err static                             /* returned completion status   */
+dque_unlink_all(                            /* internal helper function     */
+dque_qhead     *queue )                     /* pointer to intrusive queue   */
+{
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_qnode     *node;
+
+    (void) dque_myskipset( queue, (COMPFUNC)NULL );     /* drop skip list index */
+    while (gethead(queue) != NULL_NODE && errcode == DQUEERR_NOERR) {
+        if ((errcode = dque_mydelete( &gethead(queue), &node, NOROTATE, &gethcnt(queue) )) == DQUEERR_NOERR) {
+            errcode = dque_myunlink( queue, node );
+        }
+    }
+
+    return (errcode);
+}
+
 dque_err                                    /* returned completion status   */
 dque_destroy(                               /* destroy a queue              */
 dque_qheadp    *queuep )                    /* ptr to ptr to a queue        */
@@ -59,18 +103,48 @@ dque_qheadp    *queuep )                    /* ptr to ptr to a queue        */
         errcode = DQUEERR_NOQUEUEP;
     } else if ((queue = *queuep) == NULL_QUEUE) {   /* no pointer to queue? */
         errcode = DQUEERR_NOQUEUE;
+    } else if (getflag(queue, DQUE_POOL) != 0 && getqcnt(queue) != 0) {
+        errcode = DQUEERR_INUSE;                    /* pool still in use?   */
+    } else if (getflag(queue, DQUE_INTRUSIVE) != 0 && (errcode = dque_unlink_all( queue )) != DQUEERR_NOERR) {
+        ;                                           /* user's links cleared */
     } else if (getflag(queue, DQUE_NOALLOC) != 0) { /* no dynamic allocation? */
-        ;                                           /* yes, so nothing to free*/
+        (void) dque_mylockset( queue, 0 );          /* yes, so nothing to free*/
+        (void) dque_mywaitset( queue, 0 );
+    } else if (getpool(queue) != NULL_QUEUE) {      /* qnodes belong to a pool? */
+        (void) dque_myskipset( queue, (COMPFUNC)NULL );     /* drop skip list index */
+        while (gethead(queue) != NULL_NODE && errcode == DQUEERR_NOERR) {
+            /* return every qnode in the queue to the pool's free list      */
+            if ((errcode = dque_mydelete( &gethead(queue), &node, NOROTATE, &gethcnt(queue) )) == DQUEERR_NOERR) {
+                errcode = dque_myput( queue, node );
+            }
+        }
+
+        if (errcode == DQUEERR_NOERR) {
+            dque_mylock( getpool(queue) );
+            dec_uns( getqcnt(getpool(queue)) );
+            dque_myunlock( getpool(queue) );
+            (void) dque_mylockset( queue, 0 );
+            dque_myfree( queue, queue, DQUE_HEADLEN(queue) );
+            *queuep = NULL_QUEUE;
+        }
     } else {                                /* no, free the allocated memory  */
         while (getblks(queue) != NULL_NODE && errcode == DQUEERR_NOERR) {
             /* while block list is not empty, remove last memory block and free it  */
             if ((errcode = dque_mydelete( &getblks(queue), &node, ROTATE, &getbcnt(queue) )) == DQUEERR_NOERR) {
-                free( node );
+                dque_myblkfree( queue, node, (size_t)(getbend(node) - node) * sizeof(dque_qnode) );
             }
         }
 
         if (errcode == DQUEERR_NOERR) {
-            free( queue );
+            dque_myunarena( queue );        /* unmap node arena, if any     */
+            dque_mychunk_destroy( queue );  /* free chunks, if any          */
+            dque_myring_destroy( queue );   /* free ring buffer, if any     */
+            dque_myfifo_destroy( queue );   /* free snode blocks, if any    */
+            dque_mysteal_destroy( queue );  /* free grown arrays, if any    */
+            dque_myprio_destroy( queue );   /* free skip list pnodes, if any*/
+            (void) dque_mylockset( queue, 0 );  /* destroy mutex, if any    */
+            (void) dque_mywaitset( queue, 0 );  /* and condvars, if any     */
+            dque_myfree( queue, queue, DQUE_HEADLEN(queue) );
             *queuep = NULL_QUEUE;
         }
     }
@@ -78,3 +152,40 @@ dque_qheadp    *queuep )                    /* ptr to ptr to a queue        */
     return (errcode);
 }
 
+/**
+ *
+ *  \name	dque_pool_destroy
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Destroy a node pool.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_pool_destroy(
+ *      dque_poolp             *poolp )        pointer to pointer to node pool
+ *
+ *      Destroy a node pool created with dque_pool_create. Every queue created
+ *      with the pool must be destroyed first, otherwise DQUEERR_INUSE is returned.
+ *
+ *      \return non-zero for failure, zero for success
+ */
+
+dque_err                                    /* returned completion status   */
+dque_pool_destroy(                          /* destroy a node pool          */
+dque_poolp     *poolp )                     /* ptr to ptr to a pool         */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (poolp == NULL_QUEUEP) {             /* no pointer to pool?          */
+        errcode = DQUEERR_NOQUEUEP;
+    } else if (*poolp == NULL_QUEUE) {      /* no pool?                     */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (getflag( *poolp, DQUE_POOL ) == 0) { /* not a node pool?     */
+        errcode = DQUEERR_INVARG;
+    } else {
+        errcode = dque_destroy( poolp );
+    }
+
+    return (errcode);
+}
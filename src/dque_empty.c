@@ -9,6 +9,14 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Added FIFO queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       Snapshot of a lock-free MPMC queue
+ *  1.2		10/17/2026  	agent       Added SPSC queue support
+ *  1.2		10/17/2026  	agent       Added work-stealing deques
+ *  1.2		10/17/2026  	agent       Added lock-free priority queues
  *
  *      dque_empty(
  *      dque_qhead             *queue,         queue to check for nodes
@@ -50,14 +58,25 @@ unsigned int   *data )                      /* pointer to returned data     */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (void *)NULL) {      /* invalid data pointer?        */
         errcode = DQUEERR_NODATA;
+    } else if (ismpmc(queue)) {             /* empty when it was looked at  */
+        *data   = (unsigned int)((dque_mympmc_size(queue) == 0) ? 1 : 0);
+    } else if (isspsc(queue)) {
+        *data   = (unsigned int)((dque_myspsc_size(queue) == 0) ? 1 : 0);
+    } else if (issteal(queue)) {
+        *data   = (unsigned int)((dque_mysteal_size(queue) == 0) ? 1 : 0);
+    } else if (isprio(queue)) {
+        *data   = (unsigned int)((dque_myprio_size(queue) == 0) ? 1 : 0);
     } else {                                /* return non-zero if empty     */
-	*data   = (unsigned int)(gethead(queue) == NULL_NODE ? 1 : 0);
+	*data   = (unsigned int)((isslots(queue) ? gethcnt(queue) == 0 : gethead(queue) == NULL_NODE) ? 1 : 0);
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
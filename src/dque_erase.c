@@ -10,6 +10,16 @@
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
  *  1.1		07/30/2019  	D.Anderson  Renamed from "remove" to "erase" to conform to C++ terminology
+ *  1.2		10/17/2026  	agent       Use dque_myget/dque_myput for free list qnodes, keep skip list index
+ *  1.2		10/17/2026  	agent       O(1) iterator check with dque_mysearch
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Not supported on FIFO queues
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
  *
  *      dque_erase(
  *      dque_qhead             *queue,         queue to have node deleted
@@ -23,8 +33,10 @@
  *      the queue, then use the iterator as a temporary queue head to
  *      remove the node at the front of the temporary 'queue'. Also, if the
  *      iterator is not pointing to the first node in the queue, and if the
- *      DQUE_NOSCAN flag is not set, then the queue is searched to insure
- *      that the iterator is pointing to a node in the specified queue.
+ *      DQUE_NOSCAN flag is not set, then the owner of the qnode is checked
+ *      to insure that the iterator is pointing to a node in the specified
+ *      queue. The check is O(1), so erasing at an iterator in the middle
+ *      of a long queue costs the same as dque_pop_front.
  *
  *      \return non-zero for failure, zero for success and pointer to data from removed qnode
  *
@@ -52,8 +64,9 @@
 #include "mydque.h"
 #include "dque.h"
 
-dque_err                                    /* returned status              */
-dque_erase(                                 /* remove node from queue       */
+/* the body of dque_erase, called holding the DQUEOPT_LOCKED mutex, if any */
+static dque_err
+dque_myerase(                               /* remove node from queue       */
 dque_qhead     *queue,                      /* queue to have node deleted   */
 void          **data,                       /* returned data pointer        */
 dque_qiter     *iter )                      /* iterator to specified node   */
@@ -68,25 +81,53 @@ dque_qiter     *iter )                      /* iterator to specified node   */
         errcode = DQUEERR_NODATAP;
     } else if (iter == NULL_QITER) {        /* invalid iterator?            */
         errcode = DQUEERR_NOITER;
+    } else if (isring(queue) || isfifo(queue) || isxor(queue) || islockfree(queue)) { /* only push and pop */
+        errcode = DQUEERR_NOTSUP;
+    } else if (ischunked(queue)) {          /* remove iterator's slot       */
+        if ((errcode = dque_mychunk_erase( queue, iter2slot(iter), data )) == DQUEERR_NOTFOUND) {
+            *data    = (void *)NULL;        /* technically OK, but no data  */
+            errcode  = DQUEERR_NOERR;
+        }
+        return (errcode);
     } else if ((headp = gethead(queue)) == NULL_NODE) {     /* empty queue? */
         *data    = (void *)NULL;            /* technically OK, but no data  */
         return (DQUEERR_NOERR);
+    } else if (headp != iter && !getflag(queue,DQUE_NOSCAN) && (errcode = dque_mysearch( queue, iter )) != DQUEERR_NOERR) {
+        if (errcode == DQUEERR_NOTFOUND) {  /* iter specified node not found? */
+            *data    = (void *)NULL;        /* technically OK, but no data  */
+            errcode  = DQUEERR_NOERR;
+        }
+        return (errcode);
+    } else if (getflag(queue,DQUE_SKIPLIST) && (errcode = dque_myunindex( queue, iter )) != DQUEERR_NOERR) {
+        ;                                   /* remove from skip list index  */
     } else if (headp == iter) {             /* specified node is first node */
         errcode = dque_mydelete( &gethead( queue ), &node, NOROTATE, &gethcnt( queue ) );
-    } else if (getflag(queue,DQUE_NOSCAN) || (errcode = dque_mysearch( &gethead( queue ), iter )) == DQUEERR_NOERR) {
-        errcode = dque_mydelete( &iter, &node, NOROTATE, &gethcnt(queue) ); /* node in queue? */
-    } else if (errcode == DQUEERR_NOTFOUND) {   /* iter specified node not found? */
-        *data    = (void *)NULL;            /* technically OK, but no data  */
-        return (DQUEERR_NOERR);
+    } else {                                /* node is in the queue         */
+        errcode = dque_mydelete( &iter, &node, NOROTATE, &gethcnt(queue) );
     }
 
     if (errcode != DQUEERR_NOERR) {         /* error? do not free node      */
         ;
-    } else if ((errcode = dque_myinsert( &getfree( queue ), node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        *data   = getdata( node );
-	setdata( node, (void *)NULL );      /* set to null for safety       */
+    } else {
+        *data   = getdata( node );          /* get data before freeing node */
+        errcode = dque_myunlink( queue, node );
     }
 
     return (errcode);
 }
 
+dque_err                                    /* returned status              */
+dque_erase(                                 /* remove node from queue       */
+dque_qhead     *queue,                      /* queue to have node deleted   */
+void          **data,                       /* returned data pointer        */
+dque_qiter     *iter )                      /* iterator to specified node   */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    errcode = dque_myerase( queue, data, iter );
+    dque_myunlock( queue );
+
+    return (errcode);
+}
+
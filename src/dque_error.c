@@ -11,6 +11,7 @@
  *  1.0		07/11/2019  	D.Anderson  Original
  *  1.1		07/30/2019  	D.Anderson  Return error status instead of buffer pointer (buf),
  *                                          removed header (hdr) argument, added size (siz) of buffer.
+ *  1.2		10/17/2026  	agent       Added DQUEERR_FULL
  *
  *      dque_error(
  *      int                     err,    error code
@@ -71,7 +72,13 @@ static const char  *emsg[]  = {
     "No duplicates allowed in priority queue",
     "invalid iterator to deleted node",
     "invalid pointer to buffer",
-    "invalid header buffer"
+    "invalid header buffer",
+    "invalid options argument",
+    "node pool still in use by a queue",
+    "operation not supported on this platform",
+    "node memory outside the compact node range",
+    "object's dque_link is already on a queue",
+    "bounded queue is full"
 };
 
 static const int DQUEERR_MAXERR = sizeof(emsg)/sizeof(char *); /* maximum error code */
@@ -9,6 +9,12 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Use dque_myslot for chunked, ring, and FIFO queues
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
  *
  *      dque_front(
  *              dque_qhead     *queue,      queue with element data
@@ -52,11 +58,18 @@ void          **data )                      /* ptr to ptr to returned data  */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *node;
+    void          **slot;                   /* slot in chunked queue        */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (void **)NULL) {     /* invalid data pointer?        */
         errcode = DQUEERR_NODATAP;
+    } else if (islockfree(queue)) {         /* only push_back and pop_front */
+        errcode = DQUEERR_NOTSUP;
+    } else if (isslots(queue)) {            /* first slot in use            */
+        slot    = dque_myslot_end( queue, 0 );
+        *data   = (slot == (void **)NULL) ? (void *)NULL : *slot;
     } else if (gethead(queue) == NULL_NODE){/* empty queue?                 */
         *data    = (void *)NULL;            /* technically OK, but no data  */
     } else {
@@ -64,6 +77,8 @@ void          **data )                      /* ptr to ptr to returned data  */
 	*data   = getdata( node  );
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
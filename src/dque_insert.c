@@ -9,6 +9,18 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use dque_myget/dque_myput for free list qnodes, keep skip list index
+ *  1.2		10/17/2026  	agent       O(1) iterator check with dque_mysearch
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Not supported on FIFO queues
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Check the iterator before taking a qnode, freed qnodes are reused first
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       Wake a thread waiting in dque_pop_front_wait
  *
  *      dque_insert(
  *      dque_qhead             *queue,         queue to insert node into
@@ -26,8 +38,8 @@
  *      temporary 'queue' which is also just before the where the iterator
  *      is pointing. Also, if the iterator is not pointing to the first
  *      node in the queue, and if the DQUE_NOSCAN flag is not set, then
- *      the queue is searched to insure that the iterator is pointing to
- *      a node in the specified queue.
+ *      the owner of the qnode is checked, in O(1), to insure that the
+ *      iterator is pointing to a node in the specified queue.
  *
  *      \return non-zero for failure, zero for success
  *
@@ -55,23 +67,31 @@
 #include "mydque.h"
 #include "dque.h"
 
-dque_err                                    /* returned completion status   */
-dque_insert(                                /* insert node in a queue       */
+/* the body of dque_insert, called holding the DQUEOPT_LOCKED mutex, if any */
+static dque_err
+dque_myinsertat(                            /* insert node in a queue       */
 dque_qhead     *queue,                      /* queue to have node inserted  */
 void           *data,                       /* data to insert with new node */
 dque_qiter     *iter )                      /* iterator to specified node   */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *node;
+    void          **slot;                   /* slot in chunked queue        */
 
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (void *)NULL) {      /* invalid data pointer         */
         errcode = DQUEERR_NODATA;
-    } else if (getfree( queue ) == NULL_NODE && ((errcode = dque_myalloc( queue )) != DQUEERR_NOERR)) {
-        ;                   /* no free nodes? try to create more free nodes */
-    } else if ((errcode = dque_mydelete( &getfree( queue ), &node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        setdata( node, data );              /* set the data                 */
+    } else if (isring(queue) || isfifo(queue) || isxor(queue) || islockfree(queue)) { /* only push and pop */
+        return (DQUEERR_NOTSUP);
+    } else if (ischunked(queue)) {          /* insert before iterator's slot*/
+        slot    = (iter == NULL_QITER) ? (void **)NULL : iter2slot( iter );
+        return (dque_mychunk_insert( queue, data, slot ));
+    } else if (iter != NULL_QITER && gethead(queue) != iter && !getflag(queue,DQUE_NOSCAN)
+               && (errcode = dque_mysearch( queue, iter )) != DQUEERR_NOERR) {
+        ;                                   /* check iterator before a qnode*/
+    } else {                                /* is reused, maybe iterator's  */
+        errcode = dque_mylink( queue, data, &node );    /* qnode with data  */
     }
 
     if (errcode != DQUEERR_NOERR) {         /* error? do not insert node    */
@@ -80,8 +100,28 @@ dque_qiter     *iter )                      /* iterator to specified node   */
         errcode = dque_myinsert( &gethead(queue), node, NOROTATE, &gethcnt( queue ) ); 
     } else if (gethead(queue) == iter) {    /* first node is specified node?*/
         errcode = dque_myinsert( &gethead(queue), node, ROTATE, &gethcnt( queue ) );  /* insert at head of queue  */
-    } else if (getflag(queue,DQUE_NOSCAN) || (errcode = dque_mysearch( &gethead(queue), iter )) == DQUEERR_NOERR) {
-        errcode = dque_myinsert( &iter, node, NOROTATE, &gethcnt( queue ) ); /* insert at iterator used as headp */
+    } else {                                /* insert at iterator used as headp */
+        errcode = dque_myinsert( &iter, node, NOROTATE, &gethcnt( queue ) );
+    }
+
+    return (errcode);
+}
+
+dque_err                                    /* returned completion status   */
+dque_insert(                                /* insert node in a queue       */
+dque_qhead     *queue,                      /* queue to have node inserted  */
+void           *data,                       /* data to insert with new node */
+dque_qiter     *iter )                      /* iterator to specified node   */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    dque_myrefill( queue );                 /* malloc outside of the lock   */
+    errcode = dque_myinsertat( queue, data, iter );
+    dque_myunlock( queue );
+
+    if (errcode == DQUEERR_NOERR) {
+        dque_mynotify( queue, DQUE_WAITPOP, 1 );    /* wake one waiting pop */
     }
 
     return (errcode);
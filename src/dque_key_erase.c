@@ -9,6 +9,15 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.1		07/30/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use skip list index when enabled
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Not supported on FIFO queues
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
  *
  *      dque_key_erase(
  *      dque_qhead             *queue,         queue to scan for insertion
@@ -56,8 +65,9 @@
 #include "mydque.h"
 #include "dque.h"
 
-dque_err                                    /* returned completion status   */
-dque_key_erase(                             /* remove node w/specified key  */
+/* the body of dque_key_erase, called holding the DQUEOPT_LOCKED mutex, if any */
+static dque_err
+dque_mykeyerase(                            /* remove node w/specified key  */
 dque_qhead     *queue,                      /* queue to have node removed   */
 void           *key,                        /* key to use to find node      */
 COMPFUNC        comp,                       /* user comparison function     */
@@ -67,6 +77,7 @@ void          **data )                      /* data from deleted found node */
     dque_qnode     *headp;                  /* pointer to first qnode in queue */
     dque_qnode     *node;                   /* removed node                 */
     dque_qnode     *temp;                   /* node for temporary head      */
+    void          **slot;                   /* found slot in chunked queue  */
 
     if (queue == NULL_QUEUE) {              /* invalid queue?               */
         errcode = DQUEERR_NOQUEUE;
@@ -76,12 +87,32 @@ void          **data )                      /* data from deleted found node */
         errcode = DQUEERR_NOCOMP;
     } else if (data == (void **)NULL) {     /* invalid data pointer?        */
         errcode = DQUEERR_NODATAP;
+    } else if (isring(queue) || isfifo(queue) || isxor(queue) || islockfree(queue)) { /* only push and pop */
+        errcode = DQUEERR_NOTSUP;
+    } else if (ischunked(queue)) {          /* scan the chunks' slots       */
+        if ((slot = dque_mychunk_scan( queue, key, comp, 1 )) == (void **)NULL) {
+            *data   = (void *)NULL;
+            return (DQUEERR_NOERR);         /* OK, data is not in the queue */
+        }
+        return (dque_mychunk_erase( queue, slot, data ));
     } else if ((headp = gethead(queue)) == NULL_NODE) {     /* empty queue? */
         *data   = (void *)NULL;
 	return (DQUEERR_NOERR);             /* OK, qnode is not in the queue*/
+    } else if (useskip(queue, comp)) {      /* search skip list index       */
+        (void) dque_myskip( queue, key, comp, 0, NULL_NODEP, &temp );
+        if (temp == NULL_NODE || (*comp)( key, getdata(temp) ) != 0) {
+            *data   = (void *)NULL;
+            return (DQUEERR_NOERR);         /* OK, qnode is not in the queue*/
+        }
     } else if ((errcode = dque_myfind( &headp, key, comp, &temp )) != DQUEERR_NOERR) {
         *data   = (void *)NULL;
 	return (DQUEERR_NOERR);             /* OK, qnode is not in the queue*/
+    }
+
+    if (errcode != DQUEERR_NOERR) {         /* error? do not delete node    */
+        ;
+    } else if (getflag(queue,DQUE_SKIPLIST) && (errcode = dque_myunindex( queue, temp )) != DQUEERR_NOERR) {
+        ;                                   /* remove from skip list index  */
     } else if (temp == headp) {             /* delete the first node?       */
         errcode = dque_mydelete( &gethead(queue), &node, NOROTATE, &gethcnt(queue) );
     } else {                                /* no, delete qnode in the queue*/
@@ -90,11 +121,27 @@ void          **data )                      /* data from deleted found node */
 
     if (errcode != DQUEERR_NOERR) {         /* error? do not free node      */
         ;
-    } else if ((errcode = dque_myinsert( &getfree( queue ), node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        *data   = getdata( node );
-        setdata( node, (void *)NULL );      /* set to null to show invalid  */
+    } else {
+        *data   = getdata( node );          /* get data before freeing node */
+        errcode = dque_myunlink( queue, node );
     }
 
     return (errcode);
 }
 
+dque_err                                    /* returned completion status   */
+dque_key_erase(                             /* remove node w/specified key  */
+dque_qhead     *queue,                      /* queue to have node removed   */
+void           *key,                        /* key to use to find node      */
+COMPFUNC        comp,                       /* user comparison function     */
+void          **data )                      /* data from deleted found node */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    errcode = dque_mykeyerase( queue, key, comp, data );
+    dque_myunlock( queue );
+
+    return (errcode);
+}
+
@@ -9,6 +9,14 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.1		07/30/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use skip list index when enabled
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Added FIFO queue support
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
  *
  *      dque_key_find(
  *      dque_qhead             *queue,         queue to search for node w/key
@@ -63,7 +71,9 @@ dque_qiter    **iter )                      /* iterator to specified node   */
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *headp;                  /* pointer to 1st qnode in queue*/
     dque_qnode     *node;                   /* returned node as iterator    */
+    void          **slot;                   /* found slot in chunked queue  */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (key == (void *)NULL) {       /* no key?                      */
@@ -72,8 +82,32 @@ dque_qiter    **iter )                      /* iterator to specified node   */
         errcode = DQUEERR_NOCOMP;
     } else if (iter == NULL_QITERP) {       /* invalid iterator pointer?    */
         errcode = DQUEERR_NOITERP;
+    } else if (islockfree(queue)) {         /* only push_back and pop_front */
+        errcode = DQUEERR_NOTSUP;
+    } else if (isslots(queue)) {            /* scan the slots               */
+        if (ischunked(queue)) {
+            slot    = dque_mychunk_scan( queue, key, comp, 1 );
+        } else if (isring(queue)) {
+            slot    = dque_myring_scan( queue, key, comp );
+        } else if (isxor(queue)) {
+            slot    = dque_myxor_scan( queue, key, comp );
+        } else {
+            slot    = dque_myfifo_scan( queue, key, comp );
+        }
+        if (slot == (void **)NULL) {
+            errcode = DQUEERR_NOTFOUND;
+        } else {
+            *iter   = slot2iter( slot );
+        }
     } else if ((headp = gethead(queue)) == NULL_NODE) {     /* empty queue? */
         errcode = DQUEERR_NOTFOUND;
+    } else if (useskip(queue, comp)) {      /* search skip list index       */
+        (void) dque_myskip( queue, key, comp, 0, NULL_NODEP, &node );
+        if (node == NULL_NODE || (*comp)( key, getdata(node) ) != 0) {
+            errcode = DQUEERR_NOTFOUND;
+        } else {
+            *iter   = (dque_qiter *)node;
+        }
     } else if ((errcode = dque_myfind( &headp, key, comp, &node )) == DQUEERR_NOERR) {
         *iter   = (dque_qiter *)node;       /* set the data                 */
     }
@@ -82,6 +116,8 @@ dque_qiter    **iter )                      /* iterator to specified node   */
         *iter   = NULL_QITER;               /* just to make sure            */
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
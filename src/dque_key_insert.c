@@ -9,6 +9,16 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.1		07/30/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use skip list index when enabled, return qnode to free list on NODUPE
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Not supported on FIFO queues
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       Wake a thread waiting in dque_pop_front_wait
  *
  *      dque_key_insert(
  *      dque_qhead             *queue,         queue to scan for insertion
@@ -81,8 +91,9 @@
 #include "mydque.h"
 #include "dque.h"
 
-dque_err                                    /* returned completion status   */
-dque_key_insert(                            /* insert node at specified pnt */
+/* the body of dque_key_insert, called holding the DQUEOPT_LOCKED mutex, if any */
+static dque_err
+dque_mykeyinsert(                           /* insert node at specified pnt */
 dque_qhead     *queue,                      /* queue to have node inserted  */
 void           *key,                        /* key to use 4 insertion point */
 COMPFUNC        comp,                       /* user comparison function     */
@@ -92,6 +103,9 @@ void           *data )                      /* data to insert               */
     dque_qnode     *headp;                  /* pointer to first qnode in queue */
     dque_qnode     *node;                   /* node to insert               */
     dque_qnode     *temp;                   /* node for insertion point     */
+    dque_qnode     *pred[DQUE_SKIPMAX];     /* skip list search path        */
+    void          **slot;                   /* insertion slot, chunked queue*/
+    void          **prev;                   /* slot before insertion slot   */
     int             val;
 
     if (key == (void *)NULL) {              /* no key? use specified node   */
@@ -104,14 +118,42 @@ void           *data )                      /* data to insert               */
         errcode = DQUEERR_NOCOMP;
     } else if (data == (void *)NULL) {      /* invalid data pointer?        */
         errcode = DQUEERR_NODATA;
-    } else if (getfree( queue ) == NULL_NODE && ((errcode = dque_myalloc( queue )) != DQUEERR_NOERR)) {
-        ;                   /* no free nodes? try to create more free nodes */
-    } else if ((errcode = dque_mydelete( &getfree( queue ), &node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        setdata( node, data );              /* set the data                 */
+    } else if (isring(queue) || isfifo(queue) || isxor(queue) || islockfree(queue)) { /* only push and pop */
+        return (DQUEERR_NOTSUP);
+    } else if (ischunked(queue)) {          /* first slot > key, NULL = back*/
+        slot    = dque_mychunk_scan( queue, key, comp, 0 );
+        prev    = slot;
+        if (getflag(queue, DQUE_NODUPE) && slot == (void **)NULL) {
+            prev    = dque_mychunk_end( queue, 1 );
+        } else if (getflag(queue, DQUE_NODUPE)) {
+            (void) dque_mychunk_step( queue, &prev, 0 );
+        }
+        if (getflag(queue, DQUE_NODUPE) && prev != (void **)NULL && !(*comp)( key, *prev )) {
+            return (DQUEERR_NODUPE);        /* dupe not allowed?            */
+        }
+        return (dque_mychunk_insert( queue, data, slot ));
+    } else {                                /* qnode with the data set      */
+        errcode = dque_mylink( queue, data, &node );
     }
 
     if (errcode != DQUEERR_NOERR) {         /* error? do not insert node    */
         ;
+    } else if (useskip(queue, comp)) {      /* skip list finds insertion pnt*/
+        (void) dque_myskip( queue, key, comp, 1, pred, &temp );     /* first node > key */
+        headp   = gethead(queue);
+        if (headp != NULL_NODE && temp != headp && getflag(queue, DQUE_NODUPE)
+        &&  !(*comp)( key, getdata(getprev(temp == NULL_NODE ? headp : temp)) )) { /* dupe not allowed? */
+            errcode = DQUEERR_NODUPE;
+        } else if (temp == NULL_NODE) {                                     /* node goes in back?   */
+            errcode = dque_myinsert( &gethead(queue), node, NOROTATE, &gethcnt(queue) );
+        } else if (temp == headp) {                                         /* node goes in front?  */
+            errcode = dque_myinsert( &gethead(queue), node, ROTATE, &gethcnt(queue) );
+        } else {                                                            /* node goes in middle  */
+            errcode = dque_myinsert( &temp, node, NOROTATE, &gethcnt(queue) );
+        }
+        if (errcode == DQUEERR_NOERR) {     /* add node to skip list index  */
+            errcode = dque_myindex( queue, node, pred );
+        }
     } else if ( ((headp = gethead(queue)) == NULL_NODE) || ((*comp)( key, getdata(headp)) < 0) ) {     /* node goes in front?  */
         errcode = dque_myinsert( &gethead(queue), node, ROTATE, &gethcnt(queue) );
     } else if ((val = (*comp)( key, getdata(getprev(headp)) )) >= 0) {              /* node goes in back?   */
@@ -128,6 +170,31 @@ void           *data )                      /* data to insert               */
         }
     }
 
+    if (errcode == DQUEERR_NODUPE) {        /* node not used? return it     */
+        (void) dque_myunlink( queue, node );
+    }
+
+    return (errcode);
+}
+
+dque_err                                    /* returned completion status   */
+dque_key_insert(                            /* insert node at specified pnt */
+dque_qhead     *queue,                      /* queue to have node inserted  */
+void           *key,                        /* key to use 4 insertion point */
+COMPFUNC        comp,                       /* user comparison function     */
+void           *data )                      /* data to insert               */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    dque_myrefill( queue );                 /* malloc outside of the lock   */
+    errcode = dque_mykeyinsert( queue, key, comp, data );
+    dque_myunlock( queue );
+
+    if (errcode == DQUEERR_NOERR) {
+        dque_mynotify( queue, DQUE_WAITPOP, 1 );    /* wake one waiting pop */
+    }
+
     return (errcode);
 }
 
@@ -9,6 +9,12 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Count free list of shared node pool
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       Added MPMC queue support
+ *  1.2		10/17/2026  	agent       Added SPSC queue support
  *
  *      dque_max_size(
  *      dque_qhead             *queue,         queue to count nodes
@@ -17,6 +23,8 @@
  *      Return number of nodes available to use in the queue. This includes
  *      qnodes currently in the queue and those on the free list, but not on the
  *      allocated blocks list (blks) since they cannot be used by the user.
+ *      For a queue created with dque_create_pool the free list is the pool's,
+ *      which is shared with the other queues using the pool.
  *
  *      \return non-zero for failure, zero for success and the maximum qnode count.
  *
@@ -51,14 +59,23 @@ unsigned int   *data )                      /* pointer to returned data     */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (unsigned *)NULL) {  /* invalid data pointer?        */
         errcode = DQUEERR_NODATA;
+    } else if (ischunked(queue)) {          /* return # of chunk slots      */
+        *data   = getkcnt(queue) * getkslt(queue);
+    } else if (isring(queue)) {             /* return # of ring slots       */
+        *data   = getrcap(queue);
+    } else if (islockfree(queue)) {         /* return # of lock-free cells  */
+        *data   = (unsigned int)getlcap(queue);
     } else {                                /* return head and free counts  */
-        *data   = gethcnt(queue) + getfcnt(queue);
+        *data   = gethcnt(queue) + getfcnt(getnodes(queue));
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
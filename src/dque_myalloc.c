@@ -9,8 +9,27 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Added geometric growth policy
+ *  1.2		10/17/2026  	agent       Block header points past its last qnode for dque_myreclaim
+ *  1.2		10/17/2026  	agent       Added block size argument for dque_reserve
+ *  1.2		10/17/2026  	agent       Allocate blocks through the queue's allocator
+ *  1.2		10/17/2026  	agent       Keep DQUE_COMPACT qnodes inside the 32-bit window
+ *  1.2		10/17/2026  	agent       Split out dque_myaddblk, added dque_myrefill for DQUEOPT_LOCKED
+ *  1.2		10/17/2026  	agent       Align DQUE_COMPACT user buffers to a qnode
+ *
+ *      dque_myalloc(
+ *      qhead                  *queue,         queue to allocate qnodes for
+ *      unsigned int            cnt )          # of qnodes in the block, 0 = use growth policy
  *
  *      Dynamically allocate memory space for qnodes and place them on the free list.
+ *      The first qnode of the block is its header on the blks list, so cnt-1 qnodes
+ *      are made available.
+ *
+ *      By default every allocation is acnt qnodes, set with DQUEOPT_NODECNT. With the
+ *      DQUEOPT_GROWGEO option acnt is doubled after each allocation until it reaches
+ *      the cap, so a queue that grows to n qnodes makes O(log n) calls to malloc and
+ *      keeps O(log n) blocks on the blks list instead of O(n). A non-zero cnt, from
+ *      dque_reserve, allocates exactly that many qnodes and leaves acnt alone.
  *
  *      \return non-zero for failure, zero for success
  *
@@ -35,28 +54,125 @@
  */
 
 #include <stdio.h>                          /* need NULL definition         */
-#include <stdlib.h>                         /* need for malloc and free     */
 #include "mydque.h"
 #include "dque.h"
 
+/**
+ *  \name	dque_mygrow
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Step the geometric growth policy after a block is allocated.
+ */
+
+static void
+dque_mygrow(
+dque_qhead    *queue )                      /* pointer to queue head        */
+{
+    if (getgcap(queue) == 0) {              /* fixed size blocks            */
+        ;
+    } else if (getacnt(queue) >= getgcap(queue) / 2) {
+        setacnt( queue, getgcap(queue) );                       /* cap reached      */
+    } else {
+        setacnt( queue, getacnt(queue) * 2 );                   /* double next block*/
+    }
+}
+
 dque_err                                    /* returned completion status   */
 dque_myalloc(                               /* internal qnode allocation    */
-dque_qhead    *queue )                      /* pointer to queue head        */
+dque_qhead    *queue,                       /* pointer to queue head        */
+unsigned int   cnt )                        /* # of qnodes, 0 = growth policy */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *array;
+    unsigned int    grow    = (cnt == 0);   /* apply growth policy?         */
+
+    if (grow) {                             /* next block of growth policy  */
+        cnt     = getacnt(queue);
+    }
 
     if (getflag( queue, DQUE_NOALLOC ) != 0) {
         errcode = DQUEERR_ALLOCNA;          /* allowed to allocate memory?  */
-    } else if ((array = (dque_qnode *)malloc( getacnt(queue) * sizeof(dque_qnode) )) == NULL_NODE) {
+    } else if ((array = (dque_qnode *)dque_myblkalloc( queue, (size_t)cnt * sizeof(dque_qnode) )) == NULL_NODE) {
         errcode = DQUEERR_NOALLOC;          /* memory allocation fail?      */
+    } else if ((errcode = dque_myaddblk( queue, array, cnt )) == DQUEERR_NOERR && grow) {
+        dque_mygrow( queue );               /* geometric growth?            */
+    }
+
+    return (errcode);
+}
+
+/**
+ *  \name	dque_myaddblk
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Add an allocated block of qnodes to the queue.
+ *
+ *      The first qnode of the block is its header on the blks list, the other
+ *      cnt-1 qnodes become the carve region. A block that can not be linked, see
+ *      dque_mywindow, is released again.
+ */
+
+dque_err                                    /* returned completion status   */
+dque_myaddblk(                              /* internal add qnode block     */
+dque_qhead    *queue,                       /* pointer to queue head        */
+dque_qnode    *array,                       /* block from dque_myblkalloc   */
+unsigned int   cnt )                        /* # of qnodes in the block     */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if ((errcode = dque_mywindow( queue, array, cnt )) != DQUEERR_NOERR) {
+        dque_myblkfree( queue, array, (size_t)cnt * sizeof(dque_qnode) );  /* cannot be linked */
     } else if ((errcode = dque_myinsert( &getblks( queue ), &array[0], NOROTATE, &getbcnt( queue ) )) == DQUEERR_NOERR) {
-        errcode = dque_mypopulate( queue, getacnt(queue)-1, &array[1] );   /* save first node to free allocation later */
+        setbend( &array[0], &array[cnt] );                                 /* block header knows its size */
+        errcode = dque_mypopulate( queue, cnt-1, &array[1] );              /* save first node to free allocation later */
+        setwtrg( queue, getwmhi(queue) );                                  /* all older nodes in use, reset trigger */
     }                                                                      /* put the remaining nodes on the free list */
 
     return (errcode);
 }
 
+/**
+ *  \name	dque_myrefill
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Allocate the next block of a locked queue outside its lock.
+ *
+ *      With DQUEOPT_LOCKED a push that finds no free qnodes would call malloc
+ *      while holding the lock. The push functions call this first, holding the
+ *      queue's lock but before changing the queue. If the free list is empty, the
+ *      lock guarding it is released while the block is allocated, and only taken
+ *      again to link the block in. If another thread takes the new qnodes first,
+ *      the push allocates under the lock as before. Errors are left for the push.
+ */
+
+void
+dque_myrefill(                              /* refill free list, unlocked   */
+dque_qhead    *queue )                      /* locked queue about to push   */
+{                                           /*------------------------------*/
+    dque_qhead     *pool;                   /* qhead with the free list     */
+    dque_qnode     *array;
+    unsigned int    cnt;
+    int             need;
+
+    if (!islocked(queue) || isslots(queue) || getflag(queue, DQUE_INTRUSIVE)
+    ||  !islocked( pool = getnodes(queue) )) {
+        return;                             /* not a locked qnode free list */
+    }
+
+    dque_mylockpool( queue, pool );
+    need    = getfree(pool) == NULL_NODE && getccnt(pool) == 0 && getflag(pool, DQUE_NOALLOC) == 0;
+    cnt     = getacnt(pool);
+    if (need) {
+        dque_myunlock( pool );              /* queue's or pool's lock       */
+        array   = (dque_qnode *)dque_myblkalloc( pool, (size_t)cnt * sizeof(dque_qnode) );
+        dque_mylock( pool );
+        if (array != NULL_NODE && dque_myaddblk( pool, array, cnt ) == DQUEERR_NOERR && cnt == getacnt(pool)) {
+            dque_mygrow( pool );            /* same block size as myalloc   */
+        }
+    }
+    dque_myunlockpool( queue, pool );
+}
+
 /**
  *  \name	dque_mypopulate
  *  \author	Dale Anderson
@@ -65,8 +181,21 @@ dque_qhead    *queue )                      /* pointer to queue head        */
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Carve qnodes lazily from the array instead of linking them all
  *
  *      Put specified cnt qnodes from specified array onto free list.
+ *
+ *      The qnodes are not linked onto the free list one at a time any more, which
+ *      touched every qnode of a large static buffer before the first push. The array
+ *      becomes the carve region, a bump pointer and count in the qhead, and dque_myget
+ *      carves the next qnode from it only when the free list is empty. The free list
+ *      only holds recycled qnodes, and fcnt counts both. Any qnodes left in an older
+ *      carve region are linked onto the free list first so none are lost.
+ *
+ *      In a DQUE_COMPACT build the array must fit the queue's window, see dque_mywindow.
+ *      Links count whole qnodes, so an array that is not qnode aligned, like a user's
+ *      char buffer after a qhead, is moved up to the next qnode boundary and loses a
+ *      qnode. Blocks from malloc, mmap, or the user's allocator are already aligned.
  */
  
 dque_err                                    /* returned completion status   */
@@ -76,15 +205,87 @@ unsigned int   cnt,                         /* number of qnodes to populate */
 dque_qnode    *array )                      /* array of qnodes              */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
-    int             i;
+    dque_qnode     *node;
+#ifdef DQUE_COMPACT
+    size_t          skip    = (size_t)((uintptr_t)array % sizeof(dque_qnode));
 
-    for (i = 0; i < cnt; ++i) {             /* put remaining nodes on free list */
-        setdata( &array[i], (void *)NULL ); /* set data to null to show invalid qnode */
-        if ((errcode = dque_myinsert( &getfree( queue ), &array[i], NOROTATE, &getfcnt( queue ) )) != DQUEERR_NOERR) {
-            break;
-        }
+    if (skip != 0 && cnt > 0) {             /* align to a qnode boundary    */
+        array   = (dque_qnode *)((char *)array + (sizeof(dque_qnode) - skip));
+        --cnt;
+    }
+#endif
+
+    errcode = dque_mywindow( queue, array, cnt );   /* can qnodes be linked? */
+
+    while (getccnt(queue) > 0 && errcode == DQUEERR_NOERR) {   /* old carve region left? */
+        node    = getcarv(queue);
+        setcarv( queue, node + 1 );
+        dec_uns( getccnt(queue) );
+        setdata(  node, (void *)NULL );     /* set data to null to show invalid qnode */
+        setowner( node, NULL_QUEUE   );     /* free qnodes have no owner    */
+        errcode = dque_myinsert( &getfree( queue ), node, NOROTATE, (unsigned int *)NULL );
+    }                                       /* already counted in fcnt      */
+
+    if (errcode == DQUEERR_NOERR) {         /* new carve region             */
+        setcarv( queue, array );
+        setccnt( queue, cnt   );
+        setfcnt( queue, getfcnt(queue) + cnt );
     }
 
     return (errcode);
 }
 
+#ifdef DQUE_COMPACT
+/**
+ *  \name	dque_mywindow
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Check new qnode memory can be linked with 32-bit offsets.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_mywindow(
+ *      qhead                  *queue,         queue, or pool, that owns the qnodes
+ *      qnode                  *array,         new qnode memory
+ *      unsigned int            cnt )          # of qnodes in array
+ *
+ *      A DQUE_COMPACT link is the signed 32-bit distance, in qnodes, between two
+ *      qnodes, so every qnode of a queue must be within DQUE_SPAN qnodes of every
+ *      other one and at a whole number of qnodes from it. The qhead keeps the lowest
+ *      and highest qnode addresses it has been given, and new memory is only taken if
+ *      the window that includes it still fits, otherwise DQUEERR_RANGE is returned.
+ *      The window never shrinks when blocks are released. dque_myblkalloc maps blocks
+ *      next to the window to keep it small.
+ *
+ *      \return non-zero for failure, zero for success
+ */
+
+dque_err                                    /* returned completion status   */
+dque_mywindow(                              /* internal compact range check */
+dque_qhead    *queue,                       /* pointer to queue head        */
+dque_qnode    *array,                       /* new qnode memory             */
+unsigned int   cnt )                        /* # of qnodes in array         */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    intptr_t        lo      = (intptr_t)array;
+    intptr_t        hi      = (intptr_t)(array + cnt);
+
+    if (getnlo(queue) != NULL_NODE) {       /* widen the existing window    */
+        if ((lo - (intptr_t)getnlo(queue)) % (intptr_t)sizeof(dque_qnode) != 0) {
+            return (DQUEERR_RANGE);         /* not a whole # of qnodes away */
+        }
+        lo  = (lo < (intptr_t)getnlo(queue)) ? lo : (intptr_t)getnlo(queue);
+        hi  = (hi > (intptr_t)getnhi(queue)) ? hi : (intptr_t)getnhi(queue);
+    }
+
+    if ((uintptr_t)(hi - lo) / sizeof(dque_qnode) > (uintptr_t)DQUE_SPAN) {
+        errcode = DQUEERR_RANGE;            /* too far apart to link        */
+    } else {
+        setnlo( queue, (dque_qnode *)lo );
+        setnhi( queue, (dque_qnode *)hi );
+    }
+
+    return (errcode);
+}
+#endif
@@ -0,0 +1,167 @@
+
+/**
+ *
+ *  \file	dque_myarena.c
+ *  \name	dque_myarena
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal mmap'd node arena for latency-critical queues.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_myarena(
+ *      qhead                  *queue,         queue to give the arena's qnodes
+ *      unsigned int            cnt,           minimum # of qnodes in the arena
+ *      unsigned int            flgs )         DQUEARENA_* flags
+ *
+ *      Map one anonymous region for at least cnt qnodes and make it the queue's
+ *      carve region, see dque_mypopulate. The length is rounded up to whole pages,
+ *      or to whole 2MB hugepages with DQUEARENA_HUGETLB or DQUEARENA_THP, and every
+ *      qnode in the rounded length is used. The flags are:
+ *
+ *      DQUEARENA_HUGETLB   - map with MAP_HUGETLB, falls back to normal pages with
+ *                            transparent hugepage advice if no hugepages are reserved
+ *      DQUEARENA_THP       - madvise(MADV_HUGEPAGE) the region
+ *      DQUEARENA_POPULATE  - write to every page now, so pushes take no first-touch faults
+ *      DQUEARENA_MLOCK     - mlock the region, fails with DQUEERR_NOALLOC if RLIMIT_MEMLOCK is too low
+ *
+ *      The arena is not on the blks list, so dque_shrink_to_fit and watermarks never
+ *      release it and later blocks still come from dque_myalloc. It is unmapped by
+ *      dque_destroy. A queue has at most one arena, and a queue that may not use
+ *      dynamic memory cannot have one. The user's allocator callbacks are not used
+ *      for the arena. Without mmap DQUEERR_NOTSUP is returned.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE                     /* need MAP_ANONYMOUS, madvise  */
+#endif
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+#ifdef DQUE_MMAP
+#include <sys/mman.h>                       /* need for mmap, mlock         */
+#include <unistd.h>                         /* need for sysconf             */
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS   MAP_ANON
+#endif
+#endif
+
+#define DQUEARENA_ALL   (DQUEARENA_HUGETLB|DQUEARENA_THP|DQUEARENA_POPULATE|DQUEARENA_MLOCK)
+
+dque_err                                    /* returned completion status   */
+dque_myarena(                               /* internal node arena          */
+dque_qhead     *queue,                      /* queue to give the qnodes     */
+unsigned int    cnt,                        /* minimum # of qnodes          */
+unsigned int    flgs )                      /* DQUEARENA_* flags            */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+#ifdef DQUE_MMAP
+    char           *addr    = (char *)MAP_FAILED;
+    size_t          pag     = (size_t)sysconf( _SC_PAGESIZE );
+    size_t          len     = (flgs & (DQUEARENA_HUGETLB|DQUEARENA_THP)) ? DQUE_HUGEPAGE : pag;
+    size_t          off;
+
+    len     = ((size_t)cnt * sizeof(dque_qnode) + len - 1) / len * len;
+
+    if (getflag( queue, DQUE_NOALLOC ) != 0) {
+        errcode = DQUEERR_ALLOCNA;          /* allowed to allocate memory?  */
+    } else if (getaren( queue ) != (void *)NULL || (flgs & ~DQUEARENA_ALL) != 0) {
+        errcode = DQUEERR_INVARG;           /* already has one, bad flags?  */
+    } else if (cnt < (unsigned int)DQUE_MINCNT) {
+        errcode = DQUEERR_MINCNT;
+    } else if (len / sizeof(dque_qnode) > UINT_MAX) {
+        errcode = DQUEERR_NOALLOC;          /* more qnodes than we can count*/
+    } else {
+#ifdef MAP_HUGETLB
+        if (flgs & DQUEARENA_HUGETLB) {     /* try explicit hugepages first */
+            addr = (char *)mmap( NULL, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0 );
+        }
+#endif
+        if (addr == (char *)MAP_FAILED) {   /* normal pages                 */
+            addr = (char *)mmap( NULL, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+#ifdef MADV_HUGEPAGE
+            if (addr != (char *)MAP_FAILED && (flgs & (DQUEARENA_HUGETLB|DQUEARENA_THP))) {
+                (void) madvise( addr, len, MADV_HUGEPAGE );  /* advice only, ignore failure */
+            }
+#endif
+        }
+
+        if (addr == (char *)MAP_FAILED) {
+            errcode = DQUEERR_NOALLOC;      /* mapping failed?              */
+        } else if ((flgs & DQUEARENA_MLOCK) && mlock( addr, len ) != 0) {
+            (void) munmap( addr, len );
+            errcode = DQUEERR_NOALLOC;      /* could not lock arena         */
+        } else {
+            if (flgs & DQUEARENA_POPULATE) {    /* fault in every page now  */
+                for (off = 0; off < len; off += pag) {
+                    addr[off] = 0;          /* a write, so no shared zero page */
+                }
+            }
+            setaren( queue, (void *)addr );
+            setalen( queue, len );
+            errcode = dque_mypopulate( queue, (unsigned int)(len / sizeof(dque_qnode)), (dque_qnode *)addr );
+        }
+    }
+#else
+    errcode = DQUEERR_NOTSUP;               /* no mmap on this platform     */
+#endif
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_myunarena
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal release of the mmap'd node arena.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_myunarena(
+ *      qhead                  *queue )        queue to release the arena from
+ *
+ *      Unmap the queue's node arena, if it has one. Only dque_destroy calls this,
+ *      after which none of the arena's qnodes may be used.
+ */
+
+void
+dque_myunarena(                             /* internal node arena release  */
+dque_qhead     *queue )                     /* queue to release arena from  */
+{                                           /*------------------------------*/
+
+#ifdef DQUE_MMAP
+    if (getaren( queue ) != (void *)NULL) {
+        (void) munmap( getaren( queue ), getalen( queue ) );   /* also unlocks */
+        setaren( queue, (void *)NULL );
+        setalen( queue, 0 );
+    }
+#endif
+}
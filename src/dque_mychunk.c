@@ -0,0 +1,453 @@
+
+/**
+ *
+ *  \file	dque_mychunk.c
+ *  \name	dque_mychunk
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal chunked (unrolled) storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       A list of spare chunks, dque_mychunk_reserve
+ *  1.2		10/17/2026  	agent       Shrink qhead, on-demand lock
+ *
+ *      A queue created with dque_create_chunk keeps the user's data pointers in
+ *      chunks of kslt slots instead of one qnode per element, like std::deque. The
+ *      chunks are on a doubly-linked list from khead to ktail, and each chunk uses
+ *      the slots from lo up to, but not including, hi. Pushes and pops at either end
+ *      are O(1), a new chunk is only needed every kslt pushes, and a scan reads kslt
+ *      data pointers from consecutive memory before following a link.
+ *
+ *      An iterator into a chunked queue is the address of its slot, offset so that
+ *      getdata() of the iterator reads the slot, so dque_get_data and dque_set_data
+ *      work unchanged. Stepping an iterator needs the chunk holding the slot. The
+ *      chunk last stepped through is kept in kcur, so walking the queue is O(1) per
+ *      step, and any other slot is found with a walk of the chunk list. As with
+ *      std::deque, dque_insert and dque_erase move the slots after the iterator in
+ *      its chunk, so other iterators into that chunk are no longer valid.
+ *
+ *      One empty chunk is kept as a spare, so a queue that pushes and pops across
+ *      a chunk boundary does not allocate and free a chunk each time. The spares
+ *      are linked through their next pointers from kspr, and dque_reserve adds
+ *      enough of them that the queue can grow to the reserved number of elements
+ *      at either end without a malloc.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stdint.h>                         /* need for uintptr_t           */
+#include <string.h>                         /* need for memmove             */
+#include "mydque.h"
+#include "dque.h"
+
+#define CHUNKSIZ(q)     (offsetof(dque_chunk, slot) + (size_t)getkslt(q) * sizeof(void *))
+
+/* is slot s one of the used slots of chunk c?                              */
+#define inchunk(c,s)    ((uintptr_t)(s) >= (uintptr_t)&(c)->slot[(c)->lo] && \
+                         (uintptr_t)(s) <  (uintptr_t)&(c)->slot[(c)->hi])
+
+/**
+ *  \name 	dque_mychunk_get
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Return an empty chunk, the spare one if there is one.
+ */
+
+static dque_chunk *                         /* returned chunk, NULL = fail  */
+dque_mychunk_get(                           /* internal chunk allocation    */
+dque_qhead     *queue,                      /* chunked queue                */
+unsigned int    lo )                        /* first slot to use            */
+{
+    dque_chunk     *chunk;
+
+    if ((chunk = getkspr(queue)) != NULL_CHUNK) {
+        setkspr( queue, chunk->next );      /* reuse a spare chunk          */
+    } else if ((chunk = (dque_chunk *)dque_mymalloc( queue, CHUNKSIZ(queue) )) != NULL_CHUNK) {
+        inc_uns( getkcnt(queue) );
+    }
+
+    if (chunk != NULL_CHUNK) {
+        chunk->next = NULL_CHUNK;
+        chunk->prev = NULL_CHUNK;
+        chunk->lo   = lo;
+        chunk->hi   = lo;
+    }
+
+    return (chunk);
+}
+
+/**
+ *  \name 	dque_mychunk_put
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Unlink an empty chunk, keep it as the spare or free it.
+ */
+
+static void
+dque_mychunk_put(                           /* internal chunk release       */
+dque_qhead     *queue,                      /* chunked queue                */
+dque_chunk     *chunk )                     /* empty chunk                  */
+{
+
+    if (chunk->prev == NULL_CHUNK && chunk->next == NULL_CHUNK) {
+        chunk->lo = chunk->hi = getkslt(queue) / 2;     /* last chunk, keep */
+        return;                             /* it centered for both ends    */
+    }
+
+    if (chunk->prev == NULL_CHUNK) {        /* unlink from the chunk list   */
+        setkhead( queue, chunk->next );
+    } else {
+        chunk->prev->next = chunk->next;
+    }
+    if (chunk->next == NULL_CHUNK) {
+        setktail( queue, chunk->prev );
+    } else {
+        chunk->next->prev = chunk->prev;
+    }
+    if (getkcur(queue) == chunk) {
+        setkcur( queue, NULL_CHUNK );
+    }
+
+    if (getkspr(queue) == NULL_CHUNK) {     /* keep one spare chunk         */
+        chunk->next = NULL_CHUNK;
+        setkspr( queue, chunk );
+    } else {
+        dec_uns( getkcnt(queue) );
+        dque_myfree( queue, chunk, CHUNKSIZ(queue) );
+    }
+}
+
+/**
+ *  \name 	dque_mychunk_link
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Link a new chunk after the specified chunk, NULL = in front.
+ */
+
+static void
+dque_mychunk_link(                          /* internal chunk list insert   */
+dque_qhead     *queue,                      /* chunked queue                */
+dque_chunk     *after,                      /* chunk before the new one     */
+dque_chunk     *chunk )                     /* new chunk                    */
+{
+
+    chunk->prev = after;
+    chunk->next = (after == NULL_CHUNK) ? getkhead(queue) : after->next;
+    if (chunk->prev == NULL_CHUNK) {
+        setkhead( queue, chunk );
+    } else {
+        chunk->prev->next = chunk;
+    }
+    if (chunk->next == NULL_CHUNK) {
+        setktail( queue, chunk );
+    } else {
+        chunk->next->prev = chunk;
+    }
+}
+
+dque_err                                    /* returned completion status   */
+dque_mychunk_push(                          /* push onto chunked queue      */
+dque_qhead     *queue,                      /* chunked queue                */
+void           *data,                       /* user's data                  */
+int             back )                      /* non-zero = back, zero = front*/
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_chunk     *chunk   = back ? getktail(queue) : getkhead(queue);
+
+    if (chunk == NULL_CHUNK) {              /* first chunk, centered        */
+        if ((chunk = dque_mychunk_get( queue, getkslt(queue) / 2 )) == NULL_CHUNK) {
+            return (DQUEERR_NOALLOC);
+        }
+        dque_mychunk_link( queue, NULL_CHUNK, chunk );
+    } else if (back && chunk->hi == getkslt(queue)) {   /* back chunk full? */
+        if ((chunk = dque_mychunk_get( queue, 0 )) == NULL_CHUNK) {
+            return (DQUEERR_NOALLOC);
+        }
+        dque_mychunk_link( queue, getktail(queue), chunk );
+    } else if (!back && chunk->lo == 0) {   /* front chunk full?            */
+        if ((chunk = dque_mychunk_get( queue, getkslt(queue) )) == NULL_CHUNK) {
+            return (DQUEERR_NOALLOC);
+        }
+        dque_mychunk_link( queue, NULL_CHUNK, chunk );
+    }
+
+    if (back) {
+        chunk->slot[chunk->hi++] = data;
+    } else {
+        chunk->slot[--chunk->lo] = data;
+    }
+    inc_uns( gethcnt(queue) );
+
+    return (errcode);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mychunk_pop(                           /* pop off chunked queue        */
+dque_qhead     *queue,                      /* chunked queue                */
+void          **data,                       /* returned user's data         */
+int             back )                      /* non-zero = back, zero = front*/
+{                                           /*------------------------------*/
+    dque_chunk     *chunk   = back ? getktail(queue) : getkhead(queue);
+
+    if (gethcnt(queue) == 0) {              /* empty queue?                 */
+        *data   = (void *)NULL;
+        return (DQUEERR_NOERR);
+    }
+
+    *data   = back ? chunk->slot[--chunk->hi] : chunk->slot[chunk->lo++];
+    dec_uns( gethcnt(queue) );
+    if (chunk->lo == chunk->hi) {           /* chunk is empty now?          */
+        dque_mychunk_put( queue, chunk );
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+void **                                     /* slot of first/last, NULL=none*/
+dque_mychunk_end(                           /* first or last slot in queue  */
+dque_qhead     *queue,                      /* chunked queue                */
+int             back )                      /* non-zero = last, zero = first*/
+{                                           /*------------------------------*/
+
+    if (gethcnt(queue) == 0) {              /* empty queue?                 */
+        return ((void **)NULL);
+    } else if (back) {
+        setkcur( queue, getktail(queue) );
+        return (&getktail(queue)->slot[getktail(queue)->hi - 1]);
+    }
+    setkcur( queue, getkhead(queue) );
+
+    return (&getkhead(queue)->slot[getkhead(queue)->lo]);
+}
+
+dque_chunk *                                /* chunk holding slot, NULL=none*/
+dque_mychunk_find(                          /* find the chunk of a slot     */
+dque_qhead     *queue,                      /* chunked queue                */
+void          **slot )                      /* slot to find                 */
+{                                           /*------------------------------*/
+    dque_chunk     *chunk   = getkcur(queue);
+
+    if (chunk == NULL_CHUNK || !inchunk( chunk, slot )) {
+        for (chunk = getkhead(queue); chunk != NULL_CHUNK; chunk = chunk->next) {
+            if (inchunk( chunk, slot )) {   /* walk the chunk list          */
+                break;
+            }
+        }
+        setkcur( queue, chunk );
+    }
+
+    return (chunk);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mychunk_step(                          /* step an iterator's slot      */
+dque_qhead     *queue,                      /* chunked queue                */
+void         ***slotp,                      /* slot, NULL at the end        */
+int             back )                      /* non-zero = next, zero = prev */
+{                                           /*------------------------------*/
+    dque_chunk     *chunk;
+    void          **slot    = *slotp;
+
+    if ((chunk = dque_mychunk_find( queue, slot )) == NULL_CHUNK) {
+        *slotp  = (void **)NULL;            /* not a slot in this queue     */
+        return (DQUEERR_INVITER);
+    } else if (back && slot + 1 < &chunk->slot[chunk->hi]) {
+        *slotp  = slot + 1;                 /* next slot, same chunk        */
+    } else if (!back && slot > &chunk->slot[chunk->lo]) {
+        *slotp  = slot - 1;                 /* prev slot, same chunk        */
+    } else if ((chunk = back ? chunk->next : chunk->prev) == NULL_CHUNK) {
+        *slotp  = (void **)NULL;            /* end of the queue             */
+    } else {                                /* first/last slot, next chunk  */
+        setkcur( queue, chunk );
+        *slotp  = back ? &chunk->slot[chunk->lo] : &chunk->slot[chunk->hi - 1];
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mychunk_insert(                        /* insert before a slot         */
+dque_qhead     *queue,                      /* chunked queue                */
+void           *data,                       /* user's data                  */
+void          **slot )                      /* insert before, NULL = back   */
+{                                           /*------------------------------*/
+    dque_chunk     *chunk;
+    dque_chunk     *next;
+    unsigned int    idx, mid;
+
+    if (slot == (void **)NULL) {            /* insert at the back           */
+        return (dque_mychunk_push( queue, data, 1 ));
+    } else if ((chunk = dque_mychunk_find( queue, slot )) == NULL_CHUNK) {
+        return (DQUEERR_NOTFOUND);
+    }
+
+    idx = (unsigned int)(slot - chunk->slot);
+    if (chunk->lo == 0 && chunk->hi == getkslt(queue)) {    /* chunk full?  */
+        if ((next = dque_mychunk_get( queue, 0 )) == NULL_CHUNK) {
+            return (DQUEERR_NOALLOC);
+        }
+        mid = getkslt(queue) / 2;           /* move upper half to new chunk */
+        (void) memcpy( next->slot, &chunk->slot[mid], (chunk->hi - mid) * sizeof(void *) );
+        next->hi    = chunk->hi - mid;
+        chunk->hi   = mid;
+        dque_mychunk_link( queue, chunk, next );
+        if (idx > mid) {                    /* slot moved to new chunk?     */
+            idx    -= mid;
+            chunk   = next;
+        }
+    }
+
+    if (chunk->hi < getkslt(queue)) {       /* open a hole at idx           */
+        (void) memmove( &chunk->slot[idx + 1], &chunk->slot[idx], (chunk->hi - idx) * sizeof(void *) );
+        ++chunk->hi;
+    } else {                                /* open a hole before idx       */
+        (void) memmove( &chunk->slot[chunk->lo - 1], &chunk->slot[chunk->lo], (idx - chunk->lo) * sizeof(void *) );
+        --chunk->lo;
+        --idx;
+    }
+    chunk->slot[idx] = data;
+    inc_uns( gethcnt(queue) );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mychunk_erase(                         /* remove the data in a slot    */
+dque_qhead     *queue,                      /* chunked queue                */
+void          **slot,                       /* slot to remove               */
+void          **data )                      /* returned user's data         */
+{                                           /*------------------------------*/
+    dque_chunk     *chunk;
+    unsigned int    idx;
+
+    if ((chunk = dque_mychunk_find( queue, slot )) == NULL_CHUNK) {
+        return (DQUEERR_NOTFOUND);
+    }
+
+    *data   = *slot;
+    idx     = (unsigned int)(slot - chunk->slot);
+    if (idx - chunk->lo < chunk->hi - 1 - idx) {    /* close toward the front */
+        (void) memmove( &chunk->slot[chunk->lo + 1], &chunk->slot[chunk->lo], (idx - chunk->lo) * sizeof(void *) );
+        ++chunk->lo;
+    } else {                                /* close toward the back        */
+        (void) memmove( &chunk->slot[idx], &chunk->slot[idx + 1], (chunk->hi - 1 - idx) * sizeof(void *) );
+        --chunk->hi;
+    }
+    dec_uns( gethcnt(queue) );
+    if (chunk->lo == chunk->hi) {           /* chunk is empty now?          */
+        dque_mychunk_put( queue, chunk );
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+void **                                     /* found slot, NULL = none/back */
+dque_mychunk_scan(                          /* scan an ordered chunked queue*/
+dque_qhead     *queue,                      /* chunked queue                */
+void           *key,                        /* key to search for            */
+COMPFUNC        comp,                       /* user comparison function     */
+int             exact )                     /* non-zero = find key, zero =  */
+{                                           /*   insertion point after key  */
+    dque_chunk     *chunk;
+    unsigned int    i;
+    int             val;
+
+    for (chunk = getkhead(queue); chunk != NULL_CHUNK; chunk = chunk->next) {
+        for (i = chunk->lo; i < chunk->hi; ++i) {
+            val = (*comp)( key, chunk->slot[i] );
+            if (exact && val == 0) {        /* found the key?               */
+                setkcur( queue, chunk );
+                return (&chunk->slot[i]);
+            } else if (val < 0) {           /* past where key is in queue?  */
+                setkcur( queue, chunk );
+                return (exact ? (void **)NULL : &chunk->slot[i]);
+            }
+        }
+    }
+
+    return ((void **)NULL);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mychunk_reserve(                       /* add spare chunks             */
+dque_qhead     *queue,                      /* chunked queue                */
+unsigned int    cnt )                       /* # of elements wanted         */
+{                                           /*------------------------------*/
+    dque_chunk     *chunk;
+    unsigned int    need;                   /* spare chunks wanted          */
+
+    if (cnt <= gethcnt(queue)) {            /* already holds cnt elements   */
+        return (DQUEERR_NOERR);
+    }
+    cnt    -= gethcnt(queue);               /* spares for the rest, ignoring*/
+    need    = cnt / getkslt(queue) + (cnt % getkslt(queue) != 0);  /* room */
+                                            /* left in the end chunks       */
+    for (chunk = getkspr(queue); chunk != NULL_CHUNK && need > 0; chunk = chunk->next) {
+        --need;                             /* count the spares kept        */
+    }
+    while (need-- > 0) {
+        if (getflag(queue, DQUE_NOALLOC)) {
+            return (DQUEERR_ALLOCNA);
+        } else if ((chunk = (dque_chunk *)dque_mymalloc( queue, CHUNKSIZ(queue) )) == NULL_CHUNK) {
+            return (DQUEERR_NOALLOC);
+        }
+        chunk->next = getkspr(queue);       /* onto the spare chunk list    */
+        setkspr( queue, chunk );
+        inc_uns( getkcnt(queue) );
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+void
+dque_mychunk_shrink(                        /* free the spare chunks        */
+dque_qhead     *queue )                     /* chunked queue                */
+{                                           /*------------------------------*/
+    dque_chunk     *chunk;
+
+    while ((chunk = getkspr(queue)) != NULL_CHUNK) {
+        setkspr( queue, chunk->next );
+        dec_uns( getkcnt(queue) );
+        dque_myfree( queue, chunk, CHUNKSIZ(queue) );
+    }
+}
+
+void
+dque_mychunk_destroy(                       /* free every chunk             */
+dque_qhead     *queue )                     /* chunked queue                */
+{                                           /*------------------------------*/
+    dque_chunk     *chunk;
+
+    if (ischunked(queue)) {                 /* chunk fields are in use      */
+        dque_mychunk_shrink( queue );
+        while ((chunk = getkhead(queue)) != NULL_CHUNK) {
+            setkhead( queue, chunk->next );
+            dque_myfree( queue, chunk, CHUNKSIZ(queue) );
+        }
+        setktail( queue, NULL_CHUNK );
+        setkcur(  queue, NULL_CHUNK );
+        setkcnt(  queue, 0 );
+        sethcnt(  queue, 0 );
+    }
+}
@@ -0,0 +1,225 @@
+
+/**
+ *
+ *  \file	dque_myfifo.c
+ *  \name	dque_myfifo
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal singly-linked FIFO storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       dque_myfifo_get and dque_myfifo_put shared with XOR queues
+ *  1.2		10/17/2026  	agent       Shrink qhead, on-demand lock
+ *
+ *      A queue created with dque_create_fifo links its data with snodes, which only
+ *      have a next pointer and the user's data, instead of qnodes. An snode is half
+ *      the size of a qnode, and a push or pop only stores the one link. The qhead
+ *      keeps the first snode in shed and the last in stal, so push_back, push_front,
+ *      pop_front, front, and back are O(1). Anything that needs to walk backwards,
+ *      pop_back, rbegin, rnext, and the middle insert and erase functions, returns
+ *      DQUEERR_NOTSUP.
+ *
+ *      Snodes are allocated DQUEOPT_NODECNT at a time. The first snode of each block
+ *      is its header, linked on sblk, with the block's snode count in its data. The
+ *      other snodes go on the sfre free list and are counted in fcnt, so max_size
+ *      works as for any other queue. Blocks are only freed by dque_destroy.
+ *
+ *      An iterator into a FIFO queue is the address of an snode's data, offset so
+ *      that getdata() of the iterator reads it, the same as a chunked queue.
+ *
+ *      XOR queues, see dque_myxor.c, use the same snodes, blocks, and free list.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stdint.h>                         /* need for uintptr_t           */
+#include "mydque.h"
+#include "dque.h"
+
+#define slot2snode(s)   ((dque_snode *)((char *)(s) - offsetof(dque_snode, data)))
+
+dque_err                                    /* returned completion status   */
+dque_myfifo_alloc(                          /* allocate a block of snodes   */
+dque_qhead     *queue,                      /* FIFO queue                   */
+unsigned int    cnt )                       /* # of snodes, with the header */
+{                                           /*------------------------------*/
+    dque_snode     *node;
+    unsigned int    i;
+
+    if ((node = (dque_snode *)dque_mymalloc( queue, (size_t)cnt * sizeof(dque_snode) )) == NULL_SNODE) {
+        return (DQUEERR_NOALLOC);
+    }
+
+    node[0].next    = getsblk(queue);       /* block header                 */
+    node[0].data    = (void *)(uintptr_t)cnt;
+    setsblk( queue, node );
+    for (i = cnt - 1; i > 0; --i) {         /* rest of block on free list   */
+        node[i].next    = getsfre(queue);
+        node[i].data    = (void *)NULL;
+        setsfre( queue, &node[i] );
+    }
+    setfcnt( queue, getfcnt(queue) + cnt - 1 );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_snode *                                /* returned snode, NULL = fail  */
+dque_myfifo_get(                            /* take snode off free list     */
+dque_qhead     *queue )                     /* FIFO or XOR queue            */
+{                                           /*------------------------------*/
+    dque_snode     *node;
+
+    if (getsfre(queue) == NULL_SNODE && dque_myfifo_alloc( queue, getacnt(queue) ) != DQUEERR_NOERR) {
+        return (NULL_SNODE);                /* free list empty, no new block*/
+    }
+
+    node    = getsfre(queue);
+    setsfre( queue, node->next );
+    dec_uns( getfcnt(queue) );
+
+    return (node);
+}
+
+void
+dque_myfifo_put(                            /* put snode on free list       */
+dque_qhead     *queue,                      /* FIFO or XOR queue            */
+dque_snode     *node )                      /* unlinked snode               */
+{                                           /*------------------------------*/
+
+    node->data  = (void *)NULL;             /* mark iterators to it invalid */
+    node->next  = getsfre(queue);
+    setsfre( queue, node );
+    inc_uns( getfcnt(queue) );
+}
+
+dque_err                                    /* returned completion status   */
+dque_myfifo_push(                           /* push onto FIFO queue         */
+dque_qhead     *queue,                      /* FIFO queue                   */
+void           *data,                       /* user's data                  */
+int             back )                      /* non-zero = back, zero = front*/
+{                                           /*------------------------------*/
+    dque_snode     *node;
+
+    if ((node = dque_myfifo_get( queue )) == NULL_SNODE) {
+        return (DQUEERR_NOALLOC);
+    }
+
+    node->data  = data;
+    if (getshed(queue) == NULL_SNODE) {     /* first snode is head and tail */
+        node->next  = NULL_SNODE;
+        setshed( queue, node );
+        setstal( queue, node );
+    } else if (back) {                      /* link after the tail          */
+        node->next  = NULL_SNODE;
+        getstal(queue)->next = node;
+        setstal( queue, node );
+    } else {                                /* link before the head         */
+        node->next  = getshed(queue);
+        setshed( queue, node );
+    }
+    inc_uns( gethcnt(queue) );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myfifo_pop(                            /* pop off front of FIFO queue  */
+dque_qhead     *queue,                      /* FIFO queue                   */
+void          **data )                      /* returned user's data         */
+{                                           /*------------------------------*/
+    dque_snode     *node    = getshed(queue);
+
+    if (node == NULL_SNODE) {               /* empty queue?                 */
+        *data   = (void *)NULL;
+        return (DQUEERR_NOERR);
+    }
+
+    *data   = node->data;
+    setshed( queue, node->next );
+    if (node->next == NULL_SNODE) {         /* popped the last snode?       */
+        setstal( queue, NULL_SNODE );
+    }
+    dec_uns( gethcnt(queue) );
+    dque_myfifo_put( queue, node );
+
+    return (DQUEERR_NOERR);
+}
+
+void **                                     /* slot of first/last, NULL=none*/
+dque_myfifo_end(                            /* first or last data in queue  */
+dque_qhead     *queue,                      /* FIFO queue                   */
+int             back )                      /* non-zero = last, zero = first*/
+{                                           /*------------------------------*/
+    dque_snode     *node    = back ? getstal(queue) : getshed(queue);
+
+    return ((node == NULL_SNODE) ? (void **)NULL : &node->data);
+}
+
+void **                                     /* next slot, NULL at the end   */
+dque_myfifo_step(                           /* step an iterator forward     */
+void          **slot )                      /* iterator's slot              */
+{                                           /*------------------------------*/
+    dque_snode     *node    = slot2snode( slot )->next;
+
+    return ((node == NULL_SNODE) ? (void **)NULL : &node->data);
+}
+
+void **                                     /* found slot, NULL = none      */
+dque_myfifo_scan(                           /* find key in ordered FIFO     */
+dque_qhead     *queue,                      /* FIFO queue                   */
+void           *key,                        /* key to search for            */
+COMPFUNC        comp )                      /* user comparison function     */
+{                                           /*------------------------------*/
+    dque_snode     *node;
+    int             val;
+
+    for (node = getshed(queue); node != NULL_SNODE; node = node->next) {
+        if ((val = (*comp)( key, node->data )) == 0) {
+            return (&node->data);           /* found the key                */
+        } else if (val < 0) {               /* past where key is in queue?  */
+            break;
+        }
+    }
+
+    return ((void **)NULL);
+}
+
+void
+dque_myfifo_destroy(                        /* free every snode block       */
+dque_qhead     *queue )                     /* FIFO queue                   */
+{                                           /*------------------------------*/
+    dque_snode     *node;
+
+    if (isfifo(queue) || isxor(queue)) {    /* snode fields are in use      */
+        while ((node = getsblk(queue)) != NULL_SNODE) {
+            setsblk( queue, node->next );
+            dque_myfree( queue, node, (size_t)(uintptr_t)node->data * sizeof(dque_snode) );
+        }
+        setshed( queue, NULL_SNODE );
+        setstal( queue, NULL_SNODE );
+        setsfre( queue, NULL_SNODE );
+        setfcnt( queue, 0 );
+        sethcnt( queue, 0 );
+    }
+}
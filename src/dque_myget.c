@@ -0,0 +1,82 @@
+
+/**
+ *
+ *  \file	dque_myget.c
+ *  \name	dque_myget
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal take a qnode off the free list.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *
+ *      dque_myget(
+ *      qhead                  *queue,         queue owning the free list
+ *      qnode                 **node )         pointer to pointer to returned qnode
+ *
+ *      Internal function to take the first qnode off the free list of the specified
+ *      queue. If the free list is empty, the next qnode is carved from the carve
+ *      region set up by dque_mypopulate, and if that is empty too, dque_myalloc is
+ *      called to create more free qnodes first. Every function that needs a qnode,
+ *      for the queue itself or for the skip list index, gets it here so the free
+ *      list is managed in one place.
+ *      With DQUE_OWNER the qnode is stamped with its queue, see dque_mysearch. A queue
+ *      created with dque_create_pool takes its qnodes from the pool's free list.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success and pointer to the qnode
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_myget(                                 /* take qnode off free list     */
+dque_qhead     *queue,                      /* queue owning the free list   */
+dque_qnode    **node )                      /* returned qnode               */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_qhead     *pool    = getnodes(queue);  /* qhead with the free list */
+
+    dque_mylockpool( queue, pool );         /* pool's DQUEOPT_LOCKED mutex  */
+    if (getfree( pool ) == NULL_NODE && getccnt( pool ) == 0 && ((errcode = dque_myalloc( pool, 0 )) != DQUEERR_NOERR)) {
+        ;                   /* no free nodes? try to create more free nodes */
+    } else if (getfree( pool ) == NULL_NODE) {  /* carve a new qnode        */
+        *node   = getcarv( pool );
+        setcarv( pool, *node + 1 );
+        dec_uns( getccnt( pool ) );
+        dec_uns( getfcnt( pool ) );
+        setdata( *node, (void *)NULL );
+    } else {                                /* reuse a recycled qnode       */
+        errcode = dque_mydelete( &getfree( pool ), node, NOROTATE, &getfcnt( pool ) );
+    }
+
+    if (errcode == DQUEERR_NOERR) {
+        setowner( *node, queue );           /* stamp qnode with its queue   */
+    }
+    dque_myunlockpool( queue, pool );
+
+    return (errcode);
+}
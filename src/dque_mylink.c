@@ -0,0 +1,114 @@
+
+/**
+ *
+ *  \file	dque_mylink.c
+ *  \name	dque_mylink
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal qnode for the user's data, from the free list or the user's object.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Linked dque_link found by its data pointer, not its owner
+ *
+ *      dque_mylink(
+ *      qhead                  *queue,         queue the qnode is for
+ *      void                   *data,          user's data
+ *      qnode                 **node )         returned qnode with data set
+ *
+ *      Return the qnode that will hold the user's data in the queue. Normally this
+ *      is a qnode from dque_myget. A queue with DQUEOPT_INTRUSIVE has no qnodes of
+ *      its own for the user's data: the user's struct embeds a dque_link, which is a
+ *      qnode, at the offset given to the option and that is linked into the queue
+ *      directly. Nothing is allocated, and the qnode is in the same cache lines as
+ *      the user's data. A dque_link that is already on a queue cannot be linked
+ *      again, DQUEERR_LINKED, so dque_link must be zeroed before its first use.
+ *      Skip list index entries still come from the free list.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_mylink(                                /* qnode for the user's data    */
+dque_qhead     *queue,                      /* queue the qnode is for       */
+void           *data,                       /* user's data                  */
+dque_qnode    **node )                      /* returned qnode               */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (getflag( queue, DQUE_INTRUSIVE ) == 0) {    /* qnode off free list  */
+        if ((errcode = dque_myget( queue, node )) == DQUEERR_NOERR) {
+            setdata( *node, data );
+        }
+    } else if (getdata( (dque_qnode *)((char *)data + getioff(queue)) ) != (void *)NULL) {
+        errcode = DQUEERR_LINKED;           /* already on a queue?          */
+    } else {                                /* user's embedded dque_link    */
+        *node   = (dque_qnode *)((char *)data + getioff(queue));
+        setdata(  *node, data  );
+        setowner( *node, queue );           /* stamp qnode with its queue   */
+    }
+
+    return (errcode);
+}
+
+/**
+ *
+ *  \name	dque_myunlink
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal release of a qnode from dque_mylink.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_myunlink(
+ *      qhead                  *queue,         queue the qnode was in
+ *      qnode                  *node )         qnode already removed from the queue
+ *
+ *      Put a qnode from dque_mylink back on the free list, or for an intrusive
+ *      queue clear the user's dque_link so the object can be linked again.
+ *
+ *      \return non-zero for failure, zero for success
+ */
+
+dque_err                                    /* returned completion status   */
+dque_myunlink(                              /* release qnode of user's data */
+dque_qhead     *queue,                      /* queue the qnode was in       */
+dque_qnode     *node )                      /* qnode to release             */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (getflag( queue, DQUE_INTRUSIVE ) == 0) {    /* back on free list    */
+        errcode = dque_myput( queue, node );
+    } else {                                /* user's dque_link is unused   */
+        setdata(  node, (void *)NULL );
+        setowner( node, NULL_QUEUE   );
+    }
+
+    return (errcode);
+}
@@ -0,0 +1,145 @@
+/**
+ *
+ *  \file	dque_mylock.c
+ *  \name	dque_mylockset
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal turn the DQUEOPT_LOCKED mutex on or off.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Create the condvars for dque_pop_front_wait
+ *  1.2		10/17/2026  	agent       Shrink qhead, on-demand lock
+ *
+ *      dque_mylockset(
+ *      qhead                  *queue,         queue, or pool, to lock
+ *      int                     on )           !0 = create the mutex, 0 = destroy it
+ *
+ *      Create or destroy the mutex in the qhead used by DQUEOPT_LOCKED. Where the
+ *      C library has one, the mutex is adaptive, it spins briefly before sleeping,
+ *      since it is only held while a few pointers are changed. The option must be
+ *      set before the queue is shared between threads and cleared after it no
+ *      longer is, dque_destroy clears it. Turning it on also creates the condvars
+ *      dque_pop_front_wait and dque_push_back_wait sleep on, see dque_mywaitset.
+ *      In a build with -DDQUE_NOLOCK turning the lock on returns DQUEERR_NOTSUP.
+ *
+ *      dque_mylockmem(
+ *      qhead                  *queue,         queue, or pool, to lock
+ *      int                     on )           !0 = get the lock memory, 0 = release it
+ *
+ *      The qhead only points to its dque_lock, so a queue that is never LOCKED or
+ *      waited on does not carry a mutex and two condvars. The memory is allocated
+ *      when the mutex or the condvars are first created, and released when both
+ *      are gone. A queue without dynamic allocation takes it from the top of its
+ *      uncarved qnodes, DQUE_LOCKPAD of them, and returns DQUEERR_ALLOCNA if there
+ *      are not that many. A lock-free queue has its dque_lock in the same block, or
+ *      static buffer, as its qhead, see dque_create_lockfree.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define _GNU_SOURCE                         /* need PTHREAD_MUTEX_ADAPTIVE_NP*/
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_mylockset(                             /* create or destroy the mutex  */
+dque_qhead     *queue,                      /* queue to lock                */
+int             on )                        /* !0 = on, 0 = off             */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+#ifdef DQUE_LOCK
+    pthread_mutexattr_t attr;
+
+    if (on && getflag(queue, DQUE_LOCKED) == 0) {
+        if ((errcode = dque_mylockmem( queue, 1 )) != DQUEERR_NOERR) {
+            return (errcode);
+        } else if (pthread_mutexattr_init( &attr ) != 0) {
+            (void) dque_mylockmem( queue, 0 );
+            return (DQUEERR_NOALLOC);
+        }
+#if defined(__GLIBC__) && defined(__USE_GNU)
+        (void) pthread_mutexattr_settype( &attr, PTHREAD_MUTEX_ADAPTIVE_NP );
+#endif
+        if (pthread_mutex_init( &getlock(queue), &attr ) != 0) {
+            errcode = DQUEERR_NOALLOC;      /* no resources for a mutex     */
+            (void) dque_mylockmem( queue, 0 );
+        } else {
+            setflag( queue, DQUE_LOCKED );
+            (void) dque_mywaitset( queue, 1 );      /* condvars for waits */
+        }
+        (void) pthread_mutexattr_destroy( &attr );
+    } else if (!on && getflag(queue, DQUE_LOCKED) != 0) {
+        resetflag( queue, DQUE_LOCKED );
+        (void) pthread_mutex_destroy( &getlock(queue) );
+        (void) dque_mywaitset( queue, 0 );
+        (void) dque_mylockmem( queue, 0 );  /* mutex and condvars are gone  */
+    }
+#else
+    if (on) {
+        errcode = DQUEERR_NOTSUP;           /* built without pthreads       */
+    }
+#endif
+
+    return (errcode);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mylockmem(                             /* get or release dque_lock     */
+dque_qhead     *queue,                      /* queue to lock                */
+int             on )                        /* !0 = get, 0 = release        */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+#ifdef DQUE_LOCK
+    dque_lock      *lock;
+
+    if (on && getlckp(queue) == (dque_lock *)NULL) {
+        if (getflag(queue, DQUE_NOALLOC) == 0) {
+            if ((lock = (dque_lock *)dque_mymalloc( queue, sizeof(dque_lock) )) == (dque_lock *)NULL) {
+                errcode = DQUEERR_NOALLOC;
+            } else {
+                setlckp( queue, lock );
+            }
+        } else if (getccnt(queue) >= DQUE_LOCKPAD) {    /* top uncarved qnodes */
+            setccnt( queue, getccnt(queue) - DQUE_LOCKPAD );
+            setfcnt( queue, getfcnt(queue) - DQUE_LOCKPAD );
+            setlckp( queue, (dque_lock *)(getcarv(queue) + getccnt(queue)) );
+        } else {
+            errcode = DQUEERR_ALLOCNA;      /* no room in the static buffer */
+        }
+    } else if (!on && getlckp(queue) != (dque_lock *)NULL && !islockfree(queue)
+               && getflag(queue, DQUE_LOCKED|DQUE_CONDVAR) == 0) {
+        if (getflag(queue, DQUE_NOALLOC) == 0) {
+            dque_myfree( queue, getlckp(queue), sizeof(dque_lock) );
+        } else if ((dque_qnode *)getlckp(queue) == getcarv(queue) + getccnt(queue)) {
+            setccnt( queue, getccnt(queue) + DQUE_LOCKPAD );    /* uncarved */
+            setfcnt( queue, getfcnt(queue) + DQUE_LOCKPAD );    /* again    */
+        }
+        setlckp( queue, (dque_lock *)NULL );
+    }
+#endif
+
+    return (errcode);
+}
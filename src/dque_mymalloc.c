@@ -0,0 +1,184 @@
+
+/**
+ *
+ *  \file	dque_mymalloc.c
+ *  \name	dque_mymalloc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal memory allocation through the queue's allocator.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Added dque_myblkalloc and dque_myblkfree for qnode blocks
+ *
+ *      dque_mymalloc(
+ *      qhead                  *queue,         queue whose allocator is used
+ *      size_t                  siz )          # of bytes to allocate
+ *
+ *      Every dynamic allocation in the library goes through here, so a queue
+ *      created with dque_create_alloc gets its qnode blocks and scratch memory
+ *      from the user's allocator. Without one, malloc is used.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return pointer to the allocated memory, NULL for failure
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE                     /* need MAP_ANONYMOUS           */
+#endif
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stdlib.h>                         /* need for malloc and free     */
+#include "mydque.h"
+#include "dque.h"
+
+#if defined(DQUE_COMPACT) && defined(DQUE_MMAP)
+#include <sys/mman.h>                       /* need for mmap, munmap        */
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS   MAP_ANON
+#endif
+#define DQUE_BLKMMAP                        /* compact blocks are mapped    */
+#endif
+
+void *                                      /* returned memory, NULL = fail */
+dque_mymalloc(                              /* internal memory allocation   */
+dque_qhead     *queue,                      /* queue whose allocator is used*/
+size_t          siz )                       /* # of bytes to allocate       */
+{                                           /*------------------------------*/
+
+    if (getamal(queue) == (DQUEMALLOC)NULL) {   /* no user allocator?       */
+        return (malloc( siz ));
+    }
+
+    return (getamal(queue)( getactx(queue), siz ));
+}
+
+/**
+ *
+ *  \name	dque_myfree
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal memory release through the queue's allocator.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_myfree(
+ *      qhead                  *queue,         queue whose allocator is used
+ *      void                   *ptr,           memory from dque_mymalloc
+ *      size_t                  siz )          # of bytes passed to dque_mymalloc
+ *
+ *      Release memory from dque_mymalloc. The size is passed on so size-class
+ *      allocators do not need a header in front of every block. The allocator is
+ *      read before ptr is released, so ptr may be the queue head itself.
+ */
+
+void
+dque_myfree(                                /* internal memory release      */
+dque_qhead     *queue,                      /* queue whose allocator is used*/
+void           *ptr,                        /* memory to release            */
+size_t          siz )                       /* # of bytes allocated         */
+{                                           /*------------------------------*/
+    DQUEFREE        afre    = getafre(queue);
+
+    if (afre == (DQUEFREE)NULL) {           /* no user allocator?           */
+        free( ptr );
+    } else {
+        afre( getactx(queue), ptr, siz );
+    }
+}
+
+/**
+ *
+ *  \name	dque_myblkalloc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal allocation of a qnode block.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_myblkalloc(
+ *      qhead                  *queue,         queue, or pool, that owns the block
+ *      size_t                  siz )          # of bytes in the block
+ *
+ *      Allocate a block of qnodes for dque_myalloc, release it with dque_myblkfree.
+ *      This is dque_mymalloc, except in a DQUE_COMPACT build without the user's
+ *      allocator, where malloc may put small blocks in the heap and large ones in
+ *      far away mappings, too far apart for 32-bit links. There the block is mapped
+ *      with the end of the queue's qnode window as the address hint, so the kernel
+ *      places it next to the queue's other qnodes whenever it can.
+ *
+ *      \return pointer to the allocated block, NULL for failure
+ */
+
+void *                                      /* returned block, NULL = fail  */
+dque_myblkalloc(                            /* internal block allocation    */
+dque_qhead     *queue,                      /* queue that owns the block    */
+size_t          siz )                       /* # of bytes in the block      */
+{                                           /*------------------------------*/
+#ifdef DQUE_BLKMMAP
+    void           *blk;
+
+    if (getamal(queue) == (DQUEMALLOC)NULL) {   /* no user allocator?       */
+        blk = mmap( (void *)getnhi(queue), siz, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+        return ((blk == MAP_FAILED) ? (void *)NULL : blk);
+    }
+#endif
+
+    return (dque_mymalloc( queue, siz ));
+}
+
+/**
+ *
+ *  \name	dque_myblkfree
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal release of a qnode block.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_myblkfree(
+ *      qhead                  *queue,         queue, or pool, that owns the block
+ *      void                   *blk,           block from dque_myblkalloc
+ *      size_t                  siz )          # of bytes in the block
+ *
+ *      Release a block from dque_myblkalloc.
+ */
+
+void
+dque_myblkfree(                             /* internal block release       */
+dque_qhead     *queue,                      /* queue that owns the block    */
+void           *blk,                        /* block to release             */
+size_t          siz )                       /* # of bytes in the block      */
+{                                           /*------------------------------*/
+#ifdef DQUE_BLKMMAP
+    if (getamal(queue) == (DQUEMALLOC)NULL) {   /* no user allocator?       */
+        (void) munmap( blk, siz );
+        return;
+    }
+#endif
+
+    dque_myfree( queue, blk, siz );
+}
@@ -0,0 +1,174 @@
+/**
+ *
+ *  \file	dque_mympmc.c
+ *  \name	dque_mympmc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal lock-free bounded MPMC storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Cells kept in the qhead's lock-free block fields
+ *
+ *      A queue created with dque_create_mpmc keeps the user's data pointers in a
+ *      ring of lcap cells, lcap a power of two, that any number of threads may push
+ *      onto and pop from at the same time without a lock. It is D. Vyukov's bounded
+ *      MPMC queue. Every cell carries a sequence number. Cell i starts at i, which
+ *      says it is free for the push at position i. A push claims position enq with
+ *      a compare and swap, stores the data, then sets the sequence to enq + 1 so the
+ *      pop at that position may take it. The pop claims deq the same way, takes the
+ *      data, and sets the sequence to deq + lcap, freeing the cell for the push one
+ *      lap later. A thread that loses the compare and swap rereads the position and
+ *      tries again, so no thread ever waits for another to be scheduled.
+ *
+ *      A cell whose sequence is behind the position wanted means the ring is full
+ *      for a push, DQUEERR_FULL, or empty for a pop, DQUEERR_EMPTY. The queue never
+ *      grows. The two positions are each written by every thread, so each has a
+ *      cache line to itself, and the cells follow them, see dque_mpmc in mydque.h.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stddef.h>                         /* need for ptrdiff_t, offsetof */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_mympmc_init(                           /* lay out an MPMC block in buf */
+dque_qhead     *queue,                      /* MPMC queue                   */
+char           *buf,                        /* memory for positions, cells  */
+size_t          siz )                       /* # of bytes in buf            */
+{                                           /*------------------------------*/
+    dque_mpmc      *mpmc;
+    size_t          pad;                    /* bytes to the next cache line */
+    size_t          cnt;                    /* # of cells that fit          */
+    size_t          cap     = 1;
+    size_t          i;
+
+    pad     = (DQUE_CACHELINE - (size_t)buf % DQUE_CACHELINE) % DQUE_CACHELINE;
+    if (siz < pad + offsetof(dque_mpmc, cell) + DQUE_MINCNT * sizeof(dque_cell)) {
+        return (DQUEERR_MINCNT);            /* no room for a ring?          */
+    }
+
+    cnt     = (siz - pad - offsetof(dque_mpmc, cell)) / sizeof(dque_cell);
+    while (cap <= cnt / 2 && cap <= UINT_MAX / 4) {
+        cap    *= 2;                        /* largest power of two <= cnt  */
+    }
+
+    mpmc    = (dque_mpmc *)(buf + pad);
+    mpmc->enq   = 0;
+    mpmc->deq   = 0;
+    for (i = 0; i < cap; ++i) {             /* cell i is free for push i    */
+        mpmc->cell[i].seq   = i;
+        mpmc->cell[i].data  = (void *)NULL;
+    }
+    setlbuf( queue, mpmc );
+    setlcap( queue, cap  );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mympmc_push(                           /* push onto back of MPMC queue */
+dque_qhead     *queue,                      /* MPMC queue                   */
+void           *data )                      /* user's data                  */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_mpmc      *mpmc    = getmpmc( queue );
+    dque_cell      *cell;
+    size_t          pos     = dque_mypeek( &mpmc->enq );
+    size_t          seq;
+
+    for (;;) {
+        cell    = &mpmc->cell[pos & (getlcap(queue) - 1)];
+        seq     = dque_myload( &cell->seq );
+        if (seq == pos) {                   /* cell free, claim position    */
+            if (dque_mycas( &mpmc->enq, &pos, pos + 1 )) {
+                break;
+            }                               /* lost, pos is the new enq     */
+        } else if ((ptrdiff_t)(seq - pos) < 0) {    /* not popped a lap ago */
+            return (DQUEERR_FULL);
+        } else {                            /* another push took it         */
+            pos     = dque_mypeek( &mpmc->enq );
+        }
+    }
+
+    cell->data  = data;
+    dque_mystore( &cell->seq, pos + 1 );    /* hand the cell to its pop     */
+
+    return (DQUEERR_NOERR);
+#else
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+dque_err                                    /* returned completion status   */
+dque_mympmc_pop(                            /* pop off front of MPMC queue  */
+dque_qhead     *queue,                      /* MPMC queue                   */
+void          **data )                      /* returned user's data         */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_mpmc      *mpmc    = getmpmc( queue );
+    dque_cell      *cell;
+    size_t          pos     = dque_mypeek( &mpmc->deq );
+    size_t          seq;
+
+    for (;;) {
+        cell    = &mpmc->cell[pos & (getlcap(queue) - 1)];
+        seq     = dque_myload( &cell->seq );
+        if (seq == pos + 1) {               /* cell pushed, claim position  */
+            if (dque_mycas( &mpmc->deq, &pos, pos + 1 )) {
+                break;
+            }                               /* lost, pos is the new deq     */
+        } else if ((ptrdiff_t)(seq - pos - 1) < 0) { /* not pushed yet   */
+            *data   = (void *)NULL;
+            return (DQUEERR_EMPTY);
+        } else {                            /* another pop took it          */
+            pos     = dque_mypeek( &mpmc->deq );
+        }
+    }
+
+    *data   = cell->data;
+    dque_mystore( &cell->seq, pos + getlcap(queue) );   /* free for next lap*/
+
+    return (DQUEERR_NOERR);
+#else
+    *data   = (void *)NULL;
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+unsigned int                                /* # of elements, a snapshot    */
+dque_mympmc_size(                           /* count MPMC queue elements    */
+dque_qhead     *queue )                     /* MPMC queue                   */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_mpmc      *mpmc    = getmpmc( queue );
+    size_t          deq     = dque_myload( &mpmc->deq );
+    size_t          cnt     = dque_myload( &mpmc->enq ) - deq;  /* enq >= deq */
+
+    return ((unsigned int)((cnt > getlcap(queue)) ? getlcap(queue) : cnt));
+#else
+    return (0);
+#endif
+}
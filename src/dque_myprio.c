@@ -0,0 +1,456 @@
+/**
+ *
+ *  \file	dque_myprio.c
+ *  \name	dque_myprio
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal lock-free skip list priority queue storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      A queue created with dque_create_prio keeps the user's data in a skip list of
+ *      pnodes, ordered by the user's comparison function, comp( new, old ), with ties
+ *      broken by push order, so every pnode has a place of its own. Any number of
+ *      threads may push and pop at the same time, no thread ever holds a lock, and
+ *      a thread that is stopped part way through never stops the others.
+ *
+ *      The list is the lock-free skip list of Fraser and of Herlihy and Shavit, "The
+ *      Art of Multiprocessor Programming". A push finds its place at every level,
+ *      links level 0 with a compare and swap, which puts it in the queue, and then
+ *      links the levels above, one at a time. The low bit of a pnode's next link at
+ *      a level marks the pnode deleted at that level. Marked links are never changed
+ *      again, and any thread that walks past a marked pnode unlinks it.
+ *
+ *      A pop is the delete-min of Lotan and Shavit: it walks level 0 from the front
+ *      and claims the first pnode no other pop has, with an exchange of ptak. That is
+ *      the logical delete, the pnode is no longer in the queue. The pop then marks
+ *      the pnode's links from the top level down and walks the list to it, which
+ *      unlinks it, the physical delete. A pop that overlaps a push of a smaller
+ *      element may return the next one instead, the queue is quiescently consistent.
+ *
+ *      A popped pnode may still be in use by a thread that was walking the list, so
+ *      it is retired, not freed. A thread counts itself in the current epoch while it
+ *      is in the list, in one of DQUE_PRIOSLOT stripes so the counts do not share a
+ *      cache line. Every DQUE_PRIOFREE pops the epoch is moved on if no thread is
+ *      still in the one before it, and the pnodes retired three epochs ago are freed.
+ *      A thread that stops inside a push or pop delays the freeing, not the queue.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stddef.h>                         /* need for offsetof            */
+#include "mydque.h"
+#include "dque.h"
+
+#define PNODELEN(l)     (offsetof(dque_pnode, next) + (size_t)(l) * sizeof(dque_pnode *))
+
+#ifdef DQUE_ATOMIC
+#define pmark(p)        ((dque_pnode *)((size_t)(p) | 1))
+#define punmark(p)      ((dque_pnode *)((size_t)(p) & ~(size_t)1))
+#define pismark(p)      (((size_t)(p) & 1) != 0)
+#define dque_mycaslink(p,e,v)   __atomic_compare_exchange_n( (p), (e), (v), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE )
+#define dque_mysync(p)          __atomic_load_n( (p), __ATOMIC_SEQ_CST )
+
+/* level of a new pnode, 1 + the # of low one bits of a hash of its push    */
+/* order, so each level has half the pnodes of the one below it. Threads    */
+/* can not share the skip list's random state in the qhead.                 */
+static unsigned int
+dque_myprio_level(                          /* pick a pnode's # of levels   */
+size_t          seq )                       /* pnode's push order           */
+{                                           /*------------------------------*/
+    unsigned int    bits    = (unsigned int)seq * 2654435761u;
+    unsigned int    lvl     = 1;
+
+    bits   ^= bits >> 16;                   /* fold the well mixed high bits*/
+    while ((bits & 1) != 0 && lvl < DQUE_SKIPMAX) {
+        bits  >>= 1;
+        lvl++;
+    }
+
+    return (lvl);
+}
+
+/* non-zero if node comes before data pushed seq'th                         */
+static int
+dque_myprio_before(                         /* compare a pnode to new data  */
+dque_prio      *prio,                       /* priority queue               */
+dque_pnode     *node,                       /* pnode in the list            */
+void           *data,                       /* data being placed            */
+size_t          seq )                       /* its push order               */
+{                                           /*------------------------------*/
+    int             val     = (*prio->comp)( data, node->data );
+
+    return (val > 0 || (val == 0 && node->pseq < seq));
+}
+
+/* count this thread in the current epoch, in the stripe picked by where   */
+/* its stack is, and return the epoch. A thread that counts itself just as  */
+/* the epoch moves on takes itself out and counts again.                    */
+static size_t
+dque_myprio_enter(                          /* start a walk of the list     */
+dque_prio      *prio,                       /* priority queue               */
+dque_pslot    **slotp )                     /* returned stripe counted in   */
+{                                           /*------------------------------*/
+    unsigned int    hash    = (unsigned int)((size_t)&slotp >> 12) * 2654435761u;
+    dque_pslot     *slot    = &prio->slot[(hash >> 16) % DQUE_PRIOSLOT];
+    size_t          gen;
+
+    for (;;) {
+        gen     = dque_mysync( &prio->pgen );
+        __atomic_fetch_add( &slot->actv[gen % 3], 1, __ATOMIC_SEQ_CST );
+        if (dque_mysync( &prio->pgen ) == gen) {
+            break;
+        }
+        __atomic_fetch_sub( &slot->actv[gen % 3], 1, __ATOMIC_SEQ_CST );
+    }
+    *slotp  = slot;
+
+    return (gen);
+}
+
+static void
+dque_myprio_leave(                          /* end a walk of the list       */
+dque_pslot     *slot,                       /* stripe counted in            */
+size_t          gen )                       /* epoch counted in             */
+{                                           /*------------------------------*/
+
+    __atomic_fetch_sub( &slot->actv[gen % 3], 1, __ATOMIC_RELEASE );
+}
+
+/* find the pnodes before and after where data pushed seq'th goes at each   */
+/* level, unlinking every marked pnode on the way. A compare and swap that  */
+/* fails means the list changed under us, so start over from the top.       */
+static void
+dque_myprio_find(                           /* find data's place in the list*/
+dque_prio      *prio,                       /* priority queue               */
+void           *data,                       /* data being placed            */
+size_t          seq,                        /* its push order               */
+dque_pnode    **preds,                      /* returned pnode before, each level */
+dque_pnode    **succs )                     /* returned pnode after, each level  */
+{                                           /*------------------------------*/
+    dque_pnode     *pred;
+    dque_pnode     *curr;
+    dque_pnode     *succ;
+    int             lvl;
+
+retry:
+    pred    = &prio->head;
+    for (lvl = DQUE_SKIPMAX - 1; lvl >= 0; lvl--) {
+        curr    = punmark( dque_myload( &pred->next[lvl] ) );
+        while (curr != (dque_pnode *)NULL) {
+            succ    = dque_myload( &curr->next[lvl] );
+            if (pismark(succ)) {            /* curr deleted, unlink it      */
+                if (!dque_mycaslink( &pred->next[lvl], &curr, punmark(succ) )) {
+                    goto retry;
+                }
+                curr    = punmark(succ);
+            } else if (dque_myprio_before( prio, curr, data, seq )) {
+                pred    = curr;
+                curr    = succ;
+            } else {
+                break;
+            }
+        }
+        preds[lvl]  = pred;
+        succs[lvl]  = curr;
+    }
+}
+
+/* mark node deleted at lvl, unless it already is                           */
+static void
+dque_myprio_mark(                           /* mark one of a pnode's links  */
+dque_pnode     *node,                       /* pnode being popped           */
+unsigned int    lvl )                       /* level to mark                */
+{                                           /*------------------------------*/
+    dque_pnode     *succ    = dque_mypeek( &node->next[lvl] );
+
+    while (!pismark(succ) && !dque_mycaslink( &node->next[lvl], &succ, pmark(succ) )) {
+        ;
+    }
+}
+
+/* put node on the stripe's list for the epoch it is retired in. A thread   */
+/* that could still reach node is in this epoch or the one before, and the  */
+/* epoch can not move on twice while this thread is counted.                */
+static void
+dque_myprio_retire(                         /* retire a popped pnode        */
+dque_prio      *prio,                       /* priority queue               */
+dque_pslot     *slot,                       /* stripe counted in            */
+dque_pnode     *node )                      /* pnode unlinked from the list */
+{                                           /*------------------------------*/
+    dque_pnode    **pfre;
+
+    node->pgen  = dque_mysync( &prio->pgen );
+    pfre        = &slot->pfre[node->pgen % 3];
+    node->pfre  = dque_mypeek( pfre );
+    while (!dque_mycaslink( pfre, &node->pfre, node )) {
+        ;                                   /* node->pfre is the new first  */
+    }
+}
+
+/* move the epoch from gen to gen + 1 if no thread is still in gen - 1.     */
+/* Then every thread is in gen or gen + 1, and no thread can reach a pnode  */
+/* retired in gen - 2 or before. Those share gen + 1's lists, so the winner */
+/* takes the lists, frees what is that old, and puts back what is not.      */
+static void
+dque_myprio_reclaim(                        /* free what no thread can reach*/
+dque_qhead     *queue,                      /* priority queue               */
+size_t          gen )                       /* epoch to move on from        */
+{                                           /*------------------------------*/
+    dque_prio      *prio    = getprio( queue );
+    dque_pnode     *node;
+    dque_pnode     *next;
+    dque_pnode    **pfre;
+    int             i;
+
+    for (i = 0; i < DQUE_PRIOSLOT; i++) {
+        if (dque_mysync( &prio->slot[i].actv[(gen + 2) % 3] ) != 0) {
+            return;                         /* still a thread in gen - 1    */
+        }
+    }
+    if (!__atomic_compare_exchange_n( &prio->pgen, &gen, gen + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED )) {
+        return;                             /* another thread moved it on   */
+    }
+
+    for (i = 0; i < DQUE_PRIOSLOT; i++) {
+        pfre    = &prio->slot[i].pfre[(gen + 1) % 3];
+        node    = __atomic_exchange_n( pfre, (dque_pnode *)NULL, __ATOMIC_ACQUIRE );
+        for (; node != (dque_pnode *)NULL; node = next) {
+            next    = node->pfre;
+            if (node->pgen + 2 <= gen) {    /* retired in gen - 2 or before */
+                dque_myfree( queue, node, PNODELEN(node->plvl) );
+            } else {                        /* retired in gen + 1, keep it  */
+                node->pfre  = dque_mypeek( pfre );
+                while (!dque_mycaslink( pfre, &node->pfre, node )) {
+                    ;
+                }
+            }
+        }
+    }
+}
+#endif
+
+dque_err                                    /* returned completion status   */
+dque_myprio_init(                           /* lay out a priority queue     */
+dque_qhead     *queue,                      /* priority queue               */
+char           *buf,                        /* memory for the list's state  */
+size_t          siz )                       /* # of bytes in buf            */
+{                                           /*------------------------------*/
+    dque_prio      *prio;
+    size_t          pad;                    /* bytes to the next cache line */
+    int             i;
+
+    pad     = (DQUE_CACHELINE - (size_t)buf % DQUE_CACHELINE) % DQUE_CACHELINE;
+    if (siz < pad + sizeof(dque_prio)) {    /* no room for the list's state?*/
+        return (DQUEERR_MINCNT);
+    }
+
+    prio    = (dque_prio *)(buf + pad);
+    prio->pgen      = 0;
+    prio->comp      = (COMPFUNC)NULL;
+    prio->pseq      = 0;
+    for (i = 0; i < DQUE_PRIOSLOT; i++) {
+        prio->slot[i].actv[0]   = prio->slot[i].actv[1] = prio->slot[i].actv[2] = 0;
+        prio->slot[i].pfre[0]   = prio->slot[i].pfre[1] = prio->slot[i].pfre[2] = (dque_pnode *)NULL;
+    }
+    prio->head.data = (void *)NULL;
+    prio->head.pseq = 0;
+    prio->head.ptak = 0;
+    prio->head.plvl = DQUE_SKIPMAX;
+    for (i = 0; i < DQUE_SKIPMAX; i++) {
+        prio->head.next[i]  = (dque_pnode *)NULL;
+    }
+    setlbuf( queue, prio );
+    setlcap( queue, UINT_MAX );             /* bounded only by memory       */
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myprio_push(                           /* push in priority order       */
+dque_qhead     *queue,                      /* priority queue               */
+void           *data )                      /* user's data                  */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_prio      *prio    = getprio( queue );
+    dque_pnode     *preds[DQUE_SKIPMAX];
+    dque_pnode     *succs[DQUE_SKIPMAX];
+    dque_pnode     *node;
+    dque_pnode     *succ;
+    dque_pslot     *slot;
+    size_t          seq     = __atomic_fetch_add( &prio->pseq, 1, __ATOMIC_RELAXED );
+    size_t          gen;
+    unsigned int    lvl     = dque_myprio_level( seq );
+    unsigned int    i;
+
+    if ((node = (dque_pnode *)dque_mymalloc( queue, PNODELEN(lvl) )) == (dque_pnode *)NULL) {
+        return (DQUEERR_NOALLOC);
+    }
+    node->data  = data;
+    node->pseq  = seq;
+    node->ptak  = 0;
+    node->plvl  = lvl;
+
+    gen     = dque_myprio_enter( prio, &slot );
+    do {                                    /* link level 0, now it is in   */
+        dque_myprio_find( prio, data, seq, preds, succs );
+        for (i = 0; i < lvl; i++) {
+            node->next[i]   = succs[i];
+        }
+    } while (!dque_mycaslink( &preds[0]->next[0], &succs[0], node ));
+
+    for (i = 1; i < lvl; i++) {             /* then the levels above it     */
+        for (;;) {
+            succ    = dque_myload( &node->next[i] );
+            if (pismark(succ)) {            /* popped already, stop linking */
+                goto done;
+            } else if (succ != succs[i] && !dque_mycaslink( &node->next[i], &succ, succs[i] )) {
+                continue;                   /* a pop just marked it         */
+            } else if (dque_mycaslink( &preds[i]->next[i], &succs[i], node )) {
+                break;
+            }
+            dque_myprio_find( prio, data, seq, preds, succs );
+        }
+        if (pismark(dque_myload( &node->next[i] ))) {
+            /* popped while this level was linked, its pop may have walked  */
+            /* past already, so unlink it here before it can be freed       */
+            dque_myprio_find( prio, data, seq, preds, succs );
+            break;
+        }
+    }
+
+done:
+    dque_myprio_leave( slot, gen );
+
+    return (DQUEERR_NOERR);
+#else
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+dque_err                                    /* returned completion status   */
+dque_myprio_pop(                            /* pop the smallest element     */
+dque_qhead     *queue,                      /* priority queue               */
+void          **data )                      /* returned user's data         */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_prio      *prio    = getprio( queue );
+    dque_pnode     *preds[DQUE_SKIPMAX];
+    dque_pnode     *succs[DQUE_SKIPMAX];
+    dque_pnode     *node;
+    dque_pnode     *succ;
+    dque_pslot     *slot;
+    size_t          seq;
+    size_t          gen;
+    unsigned int    lvl;
+
+    gen     = dque_myprio_enter( prio, &slot );
+    node    = punmark( dque_myload( &prio->head.next[0] ) );
+    while (node != (dque_pnode *)NULL
+        && (dque_mypeek( &node->ptak ) != 0 || __atomic_exchange_n( &node->ptak, 1, __ATOMIC_ACQ_REL ) != 0)) {
+        node    = punmark( dque_myload( &node->next[0] ) );
+    }                                       /* skip pnodes other pops have  */
+
+    if (node == (dque_pnode *)NULL) {       /* none left to claim           */
+        dque_myprio_leave( slot, gen );
+        *data   = (void *)NULL;
+        return (DQUEERR_EMPTY);
+    }
+
+    for (lvl = node->plvl; lvl-- > 0; ) {   /* top down, level 0 last       */
+        dque_myprio_mark( node, lvl );
+    }
+    *data   = node->data;
+    seq     = node->pseq;
+    for (lvl = node->plvl; lvl-- > 0; ) {   /* usually first at each level  */
+        succ    = node;
+        if (!dque_mycaslink( &prio->head.next[lvl], &succ, punmark( dque_mypeek( &node->next[lvl] ) ) )) {
+            dque_myprio_find( prio, node->data, seq, preds, succs );
+            break;                          /* not, walk the list to it     */
+        }
+    }
+    dque_myprio_retire( prio, slot, node ); /* unlinked at every level now  */
+    dque_myprio_leave( slot, gen );
+
+    if (seq % DQUE_PRIOFREE == 0) {
+        dque_myprio_reclaim( queue, dque_mysync( &prio->pgen ) );
+    }
+
+    return (DQUEERR_NOERR);
+#else
+    *data   = (void *)NULL;
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+unsigned int                                /* # of elements, a snapshot    */
+dque_myprio_size(                           /* count unpopped pnodes        */
+dque_qhead     *queue )                     /* priority queue               */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_prio      *prio    = getprio( queue );
+    dque_pnode     *node;
+    dque_pslot     *slot;
+    size_t          gen     = dque_myprio_enter( prio, &slot );
+    unsigned int    cnt     = 0;
+
+    for (node = punmark( dque_myload( &prio->head.next[0] ) ); node != (dque_pnode *)NULL; node = punmark( dque_myload( &node->next[0] ) )) {
+        if (dque_mypeek( &node->ptak ) == 0) {
+            inc_uns( cnt );
+        }
+    }
+    dque_myprio_leave( slot, gen );
+
+    return (cnt);
+#else
+    return (0);
+#endif
+}
+
+void
+dque_myprio_destroy(                        /* free every pnode             */
+dque_qhead     *queue )                     /* priority queue               */
+{                                           /*------------------------------*/
+    dque_prio      *prio;
+    dque_pnode     *node;
+    dque_pnode     *next;
+    int             i;
+    int             j;
+
+    if (isprio(queue)) {
+        prio    = getprio( queue );
+        for (node = prio->head.next[0]; node != (dque_pnode *)NULL; node = next) {
+            next    = node->next[0];        /* no marks once threads stop   */
+            dque_myfree( queue, node, PNODELEN(node->plvl) );
+        }
+        for (i = 0; i < DQUE_PRIOSLOT; i++) {
+            for (j = 0; j < 3; j++) {
+                for (node = prio->slot[i].pfre[j]; node != (dque_pnode *)NULL; node = next) {
+                    next    = node->pfre;
+                    dque_myfree( queue, node, PNODELEN(node->plvl) );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+
+/**
+ *
+ *  \file	dque_myput.c
+ *  \name	dque_myput
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal return a qnode to the free list.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       LIFO reuse, freed qnodes go to the front of the free list
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *
+ *      dque_myput(
+ *      qhead                  *queue,         queue owning the free list
+ *      qnode                  *node )         qnode to return to the free list
+ *
+ *      Internal function to put a qnode, already removed from its list, back
+ *      onto the front of the free list of the specified queue, so dque_myget
+ *      reuses the most recently freed, still cached, qnode first. The data pointer
+ *      of the qnode is set to NULL to show any iterator to it is now invalid,
+ *      so the caller must save the user's data before calling this function.
+ *      With DQUE_OWNER the owner of the qnode is cleared, see dque_mysearch. A queue created
+ *      with dque_create_pool returns its qnodes to the pool's free list.
+ *
+ *      If DQUEOPT_WATERMARK is set and the free list grows past the trigger count,
+ *      which starts at the high watermark, dque_myreclaim releases completely free
+ *      blocks until the free list is down to the low watermark. The trigger is
+ *      then moved hi - lo qnodes above what is left on the free list, so a free
+ *      list held up by partly used blocks is not rescanned on every free.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_myput(                                 /* put qnode back on free list  */
+dque_qhead     *queue,                      /* queue owning the free list   */
+dque_qnode     *node )                      /* qnode to free                */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_qhead     *pool    = getnodes(queue);  /* qhead with the free list */
+
+    setdata(  node, (void *)NULL );         /* set to null to show invalid  */
+    setowner( node, NULL_QUEUE   );         /* free qnodes have no owner    */
+
+    dque_mylockpool( queue, pool );         /* pool's DQUEOPT_LOCKED mutex  */
+    if ((errcode = dque_myinsert( &getfree( pool ), node, ROTATE, &getfcnt( pool ) )) != DQUEERR_NOERR) {
+        ;
+    } else if (getwmhi(pool) != 0 && getfcnt(pool) > getwtrg(pool)) {  /* above high watermark? */
+        (void) dque_myreclaim( pool, getwmlo(pool) );       /* release is best effort */
+        if (getfcnt(pool) > getwmlo(pool)) {    /* blocks still partly used? */
+            setwtrg( pool, getfcnt(pool) + getwmhi(pool) - getwmlo(pool) );
+        } else {
+            setwtrg( pool, getwmhi(pool) );
+        }
+    }
+
+    dque_myunlockpool( queue, pool );
+
+    return (errcode);
+}
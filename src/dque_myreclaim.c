@@ -0,0 +1,198 @@
+
+/**
+ *
+ *  \file	dque_myreclaim.c
+ *  \name	dque_myreclaim
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal release of completely free allocated blocks.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Scratch arrays and blocks go through the queue's allocator
+ *
+ *      dque_myreclaim(
+ *      qhead                  *queue,         queue to release blocks from
+ *      unsigned int            lo )           stop when free list is down to lo qnodes
+ *
+ *      Blocks from dque_myalloc were only freed by dque_destroy. This function
+ *      finds the blocks whose qnodes are all on the free list, takes those qnodes
+ *      off the free list, and frees the blocks until the free list is down to 'lo'
+ *      qnodes or there are no more completely free blocks.
+ *
+ *      Block occupancy is not kept while the queue is used, since that would need
+ *      a pointer from every qnode to its block and a count update on every push and
+ *      pop. Instead the block headers are sorted by address here and each free qnode
+ *      is counted against its block with a binary search. The data pointer of each
+ *      block header points just past the block's last qnode, see dque_myalloc. The
+ *      cost is O(f log b) for f free qnodes and b blocks, so it is only paid when
+ *      dque_shrink_to_fit is called or a DQUEOPT_WATERMARK is crossed. Qnodes not
+ *      yet carved from the newest block, see dque_mypopulate, also count as free.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stdlib.h>                         /* need for qsort               */
+#include <string.h>                         /* need for memset              */
+#include "mydque.h"
+#include "dque.h"
+
+/**
+ *  \name	dque_myblkcmp
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	qsort comparison of block header addresses.
+ */
+
+static int
+dque_myblkcmp(
+const void     *b1,
+const void     *b2 )
+{
+    const dque_qnode   *p1  = *(dque_qnode * const *)b1;
+    const dque_qnode   *p2  = *(dque_qnode * const *)b2;
+
+    return ((p1 < p2) ? -1 : ((p1 > p2) ? 1 : 0));
+}
+
+/**
+ *  \name	dque_myblock
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Return index of the block holding a qnode, or cnt if none does.
+ */
+
+static unsigned int                         /* returned block index         */
+dque_myblock(                               /* binary search for qnode block*/
+dque_qnode    **blks,                       /* block headers sorted by addr */
+unsigned int    cnt,                        /* number of blocks             */
+dque_qnode     *node )                      /* qnode to look for            */
+{                                           /*------------------------------*/
+    unsigned int    lo      = 0;
+    unsigned int    hi      = cnt;
+    unsigned int    mid;
+
+    while (hi - lo > 1) {                   /* find last header <= node     */
+        mid     = lo + (hi - lo) / 2;
+        if (blks[mid] <= node) {
+            lo  = mid;
+        } else {
+            hi  = mid;
+        }
+    }
+
+    if (blks[lo] < node && node < getbend(blks[lo])) {
+        return (lo);                        /* qnode is inside the block    */
+    }
+
+    return (cnt);                           /* not in any allocated block   */
+}
+
+dque_err                                    /* returned completion status   */
+dque_myreclaim(                             /* release free blocks          */
+dque_qhead     *queue,                      /* queue to release blocks from */
+unsigned int    lo )                        /* free qnodes to keep          */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_qnode    **blks;                   /* block headers sorted by addr */
+    unsigned int   *fcnt;                   /* free qnodes in each block    */
+    dque_qnode     *list    = NULL_NODE;    /* rebuilt free list            */
+    dque_qnode     *currp;
+    dque_qnode     *nextp;
+    dque_qnode     *node;
+    unsigned int    bcnt    = getbcnt(queue);
+    unsigned int    left    = getfcnt(queue);
+    unsigned int    lcnt    = getfcnt(queue) - getccnt(queue);  /* # on free list */
+    unsigned int    cnt     = 0;
+    unsigned int    rcnt    = 0;            /* # of blocks to release       */
+    unsigned int    i, b;
+
+    if (bcnt == 0 || left <= lo) {          /* nothing to release?          */
+        return (DQUEERR_NOERR);
+    } else if ((blks = (dque_qnode **)dque_mymalloc( queue, bcnt * sizeof(dque_qnode *) )) == NULL_NODEP) {
+        return (DQUEERR_NOALLOC);
+    } else if ((fcnt = (unsigned int *)dque_mymalloc( queue, bcnt * sizeof(unsigned int) )) == (unsigned int *)NULL) {
+        dque_myfree( queue, blks, bcnt * sizeof(dque_qnode *) );
+        return (DQUEERR_NOALLOC);
+    }
+    memset( fcnt, 0, bcnt * sizeof(unsigned int) );
+
+    for (i = 0, currp = getblks(queue); i < bcnt; ++i, currp = getnext(currp)) {
+        blks[i] = currp;
+    }
+    qsort( blks, bcnt, sizeof(dque_qnode *), dque_myblkcmp );
+
+    for (i = 0, currp = getfree(queue); i < lcnt; ++i, currp = getnext(currp)) {
+        if ((b = dque_myblock( blks, bcnt, currp )) < bcnt) {
+            ++fcnt[b];                      /* count free qnodes per block  */
+        }
+    }
+
+    if (getccnt(queue) != 0 && (b = dque_myblock( blks, bcnt, getcarv(queue) )) < bcnt) {
+        fcnt[b] += getccnt(queue);          /* qnodes not yet carved are free */
+    }
+
+    for (b = 0; b < bcnt; ++b) {            /* pick completely free blocks  */
+        if (left > lo && fcnt[b] == (unsigned int)(getbend(blks[b]) - blks[b]) - 1) {
+            left   -= fcnt[b];
+            fcnt[b] = 1;                    /* release this block           */
+            ++rcnt;
+        } else {
+            fcnt[b] = 0;                    /* keep this block              */
+        }
+    }
+
+    if (rcnt != 0) {                        /* rebuild free list without them */
+        for (i = 0, currp = getfree(queue); i < lcnt; ++i, currp = nextp) {
+            nextp   = getnext(currp);
+            if ((b = dque_myblock( blks, bcnt, currp )) == bcnt || fcnt[b] == 0) {
+                (void) dque_myinsert( &list, currp, NOROTATE, &cnt );
+            }
+        }
+        if (getccnt(queue) != 0 && (b = dque_myblock( blks, bcnt, getcarv(queue) )) < bcnt && fcnt[b] != 0) {
+            setcarv( queue, NULL_NODE );    /* carve region is released too */
+            setccnt( queue, 0 );
+        }
+        setfree( queue, list );
+        setfcnt( queue, cnt + getccnt(queue) );
+
+        for (b = 0; b < bcnt && errcode == DQUEERR_NOERR; ++b) {
+            if (fcnt[b] == 0) {             /* keeping this block?          */
+                ;
+            } else if (blks[b] == getblks(queue)) {
+                errcode = dque_mydelete( &getblks(queue), &node, NOROTATE, &getbcnt(queue) );
+                dque_myblkfree( queue, node, (size_t)(getbend(node) - node) * sizeof(dque_qnode) );
+            } else {                        /* use header as temporary head */
+                errcode = dque_mydelete( &blks[b], &node, NOROTATE, &getbcnt(queue) );
+                dque_myblkfree( queue, node, (size_t)(getbend(node) - node) * sizeof(dque_qnode) );
+            }
+        }
+    }
+
+    dque_myfree( queue, fcnt, bcnt * sizeof(unsigned int) );
+    dque_myfree( queue, blks, bcnt * sizeof(dque_qnode *) );
+
+    return (errcode);
+}
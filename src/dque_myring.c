@@ -0,0 +1,219 @@
+
+/**
+ *
+ *  \file	dque_myring.c
+ *  \name	dque_myring
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal ring buffer storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Shrink qhead, on-demand lock
+ *
+ *      A queue created with dque_create_ring keeps the user's data pointers in one
+ *      array of rcap slots, rcap a power of two, used as a ring. The first element is
+ *      in slot rhed and element i is in slot (rhed + i) & (rcap - 1), so pushes and
+ *      pops at either end are an index and a store, and there is no per-element
+ *      memory at all. When a dynamically allocated ring is full its capacity is
+ *      doubled and the elements are copied to the front of the new array. A ring in
+ *      the user's static buffer does not grow, a push onto a full one returns
+ *      DQUEERR_ALLOCNA.
+ *
+ *      An iterator into a ring queue is the address of its slot, offset so that
+ *      getdata() of the iterator reads the slot, the same as a chunked queue, so
+ *      dque_get_data and dque_set_data work unchanged. An iterator is invalid after
+ *      the ring grows.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <string.h>                         /* need for memcpy              */
+#include "mydque.h"
+#include "dque.h"
+
+#define ringmask(q)     (getrcap(q) - 1)    /* slot index mask              */
+#define ringslot(q,i)   (&getrbuf(q)[(getrhed(q) + (i)) & ringmask(q)])
+
+dque_err                                    /* returned completion status   */
+dque_myring_grow(                           /* grow ring to at least cnt    */
+dque_qhead     *queue,                      /* ring queue                   */
+unsigned int    cnt )                       /* # of slots wanted            */
+{                                           /*------------------------------*/
+    void          **ring;
+    unsigned int    cap     = DQUE_RINGCNT;
+    unsigned int    i;
+
+    while (cap < cnt && cap <= UINT_MAX / 2) {
+        cap    *= 2;                        /* next power of two            */
+    }
+
+    if (cap <= getrcap(queue)) {            /* already big enough?          */
+        return (DQUEERR_NOERR);
+    } else if (getflag(queue, DQUE_NOALLOC)) {      /* static buffer ring?  */
+        return (DQUEERR_ALLOCNA);
+    } else if (cap < cnt) {                 /* no power of two that large   */
+        return (DQUEERR_NOALLOC);
+    } else if ((ring = (void **)dque_mymalloc( queue, (size_t)cap * sizeof(void *) )) == (void **)NULL) {
+        return (DQUEERR_NOALLOC);
+    }
+
+    for (i = 0; i < gethcnt(queue); ++i) {  /* copy elements to the front   */
+        ring[i] = *ringslot( queue, i );
+    }
+    if (getrbuf(queue) != (void **)NULL) {
+        dque_myfree( queue, getrbuf(queue), (size_t)getrcap(queue) * sizeof(void *) );
+    }
+    setrbuf( queue, ring );
+    setrcap( queue, cap  );
+    setrhed( queue, 0    );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myring_push(                           /* push onto ring queue         */
+dque_qhead     *queue,                      /* ring queue                   */
+void           *data,                       /* user's data                  */
+int             back )                      /* non-zero = back, zero = front*/
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (gethcnt(queue) == getrcap(queue)) { /* ring full? double it         */
+        if (getrcap(queue) > UINT_MAX / 2) {
+            errcode = DQUEERR_NOALLOC;
+        } else {
+            errcode = dque_myring_grow( queue, getrcap(queue) * 2 );
+        }
+    }
+
+    if (errcode != DQUEERR_NOERR) {         /* error? do not push           */
+        ;
+    } else if (back) {
+        *ringslot( queue, gethcnt(queue) ) = data;
+        inc_uns( gethcnt(queue) );
+    } else {
+        setrhed( queue, (getrhed(queue) - 1) & ringmask(queue) );
+        *ringslot( queue, 0 ) = data;
+        inc_uns( gethcnt(queue) );
+    }
+
+    return (errcode);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myring_pop(                            /* pop off ring queue           */
+dque_qhead     *queue,                      /* ring queue                   */
+void          **data,                       /* returned user's data         */
+int             back )                      /* non-zero = back, zero = front*/
+{                                           /*------------------------------*/
+
+    if (gethcnt(queue) == 0) {              /* empty queue?                 */
+        *data   = (void *)NULL;
+    } else if (back) {
+        dec_uns( gethcnt(queue) );
+        *data   = *ringslot( queue, gethcnt(queue) );
+    } else {
+        *data   = *ringslot( queue, 0 );
+        setrhed( queue, (getrhed(queue) + 1) & ringmask(queue) );
+        dec_uns( gethcnt(queue) );
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+void **                                     /* slot of first/last, NULL=none*/
+dque_myring_end(                            /* first or last slot in queue  */
+dque_qhead     *queue,                      /* ring queue                   */
+int             back )                      /* non-zero = last, zero = first*/
+{                                           /*------------------------------*/
+
+    if (gethcnt(queue) == 0) {              /* empty queue?                 */
+        return ((void **)NULL);
+    }
+
+    return (ringslot( queue, back ? gethcnt(queue) - 1 : 0 ));
+}
+
+dque_err                                    /* returned completion status   */
+dque_myring_step(                           /* step an iterator's slot      */
+dque_qhead     *queue,                      /* ring queue                   */
+void         ***slotp,                      /* slot, NULL at the end        */
+int             back )                      /* non-zero = next, zero = prev */
+{                                           /*------------------------------*/
+    void          **slot    = *slotp;
+    unsigned int    pos;
+
+    if (slot < getrbuf(queue) || slot >= getrbuf(queue) + getrcap(queue)) {
+        *slotp  = (void **)NULL;            /* not a slot in this ring      */
+        return (DQUEERR_INVITER);
+    }
+
+    pos     = ((unsigned int)(slot - getrbuf(queue)) - getrhed(queue)) & ringmask(queue);
+    if (pos >= gethcnt(queue)) {            /* slot not in use?             */
+        *slotp  = (void **)NULL;
+        return (DQUEERR_INVITER);
+    } else if (back) {
+        *slotp  = (pos + 1 < gethcnt(queue)) ? ringslot( queue, pos + 1 ) : (void **)NULL;
+    } else {
+        *slotp  = (pos > 0) ? ringslot( queue, pos - 1 ) : (void **)NULL;
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+void **                                     /* found slot, NULL = none      */
+dque_myring_scan(                           /* find key in ordered ring     */
+dque_qhead     *queue,                      /* ring queue                   */
+void           *key,                        /* key to search for            */
+COMPFUNC        comp )                      /* user comparison function     */
+{                                           /*------------------------------*/
+    unsigned int    i;
+    int             val;
+
+    for (i = 0; i < gethcnt(queue); ++i) {
+        if ((val = (*comp)( key, *ringslot( queue, i ) )) == 0) {
+            return (ringslot( queue, i ));  /* found the key                */
+        } else if (val < 0) {               /* past where key is in queue?  */
+            break;
+        }
+    }
+
+    return ((void **)NULL);
+}
+
+void
+dque_myring_destroy(                        /* free a dynamic ring          */
+dque_qhead     *queue )                     /* ring queue                   */
+{                                           /*------------------------------*/
+
+    if (!isring(queue)) {                   /* ring fields are not in use   */
+        return;
+    } else if (getrbuf(queue) != (void **)NULL && !getflag(queue, DQUE_NOALLOC)) {
+        dque_myfree( queue, getrbuf(queue), (size_t)getrcap(queue) * sizeof(void *) );
+    }
+    setrbuf( queue, (void **)NULL );
+    setrcap( queue, 0 );
+    setrhed( queue, 0 );
+    sethcnt( queue, 0 );
+}
@@ -9,15 +9,24 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       O(1) check of qnode owner instead of scanning the queue
+ *  1.2		10/17/2026  	agent       DQUE_COMPACT qnodes have no owner, scan the queue
+ *  1.2		10/17/2026  	agent       Owner check only with DQUE_OWNER, 24 byte qnodes otherwise
  *
  *      dque_mysearch(
- *      qnodep                 *nodep,         queue to search
+ *      qhead                  *queue,         queue to search
  *      qnode                  *node )         qnode to search for
  *
  *      Search the specified queue for the specified node. This function is
  *      different from dque_myfind and dque_myscan in that it does not look at
  *      the user's data but looks only at pointers to qnodes.
  *
+ *      With DQUE_OWNER every qnode is stamped with its queue as owner when dque_myget
+ *      takes it off the free list, and the owner is cleared when dque_myput puts it
+ *      back, so the search is a single O(1) check of the owner instead of a walk of
+ *      the whole queue. A qnode of another queue, or a qnode already erased, is not
+ *      found. Without DQUE_OWNER, or with DQUE_COMPACT, the queue is walked.
+ *
  *      \return zero for success, non-zero for a failure
  *
  * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
@@ -46,20 +55,27 @@
 
 dque_err                                    /* returned status              */
 dque_mysearch(                              /* search queue for qnode       */
-dque_qnodep    *nodep,                      /* queue to search for qnode    */
+dque_qhead     *queue,                      /* queue to search for qnode    */
 dque_qnode     *node )                      /* qnode to search for          */
 {                                           /*------------------------------*/
-    dque_qnode     *headp   = *nodep;       /* first qnode in queue         */
-    dque_qnode     *currp   = headp;        /* current qnode in search      */
+#ifdef DQUE_OWNER
 
+    if (getowner(node) == queue && getdata(node) != (void *)NULL) {
+        return (DQUEERR_NOERR);             /* qnode is in the queue        */
+    }
+#else
+    dque_qnode     *headp   = gethead(queue);   /* first qnode in queue     */
+    dque_qnode     *currp   = headp;        /* current qnode in search      */
 
-    do  {
-        if (currp == node) {                /* specified node first in list?*/
-            return (DQUEERR_NOERR);
-        }
-        currp = getnext(currp);
-    } while (currp != headp);
+    if (headp != NULL_NODE) {
+        do  {
+            if (currp == node) {            /* found specified node?        */
+                return (DQUEERR_NOERR);
+            }
+            currp = getnext(currp);
+        } while (currp != headp);
+    }
+#endif
 
     return (DQUEERR_NOTFOUND);
 }
-
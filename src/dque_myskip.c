@@ -0,0 +1,347 @@
+
+/**
+ *
+ *  \file	dque_myskip.c
+ *  \name	dque_myskip
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal skip list index over an ordered queue.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Index qnodes have no owner
+ *
+ *      dque_myskip(
+ *      qhead                  *queue,         queue with skip list index
+ *      void                   *key,           pointer to comparison key
+ *      COMPFUNC                comp,          user supplied comparison function. Key must be first argument
+ *      int                     upper,         search for first qnode greater than key instead of not less than
+ *      qnode                 **pred,          if not NULL, returned last index entry before key on each level
+ *      qnode                 **node )         if not NULL, returned pointer to the found qnode
+ *
+ *      The skip list is an optional index, turned on with DQUEOPT_SKIPLIST, over a queue that is
+ *      kept in order by dque_key_insert. The queue itself, the circular doubly-linked list, is
+ *      level zero and is not changed in any way, so dque_next and dque_rnext work as before.
+ *      Each higher level is a NULL terminated list of index entries headed by a sentinel. An
+ *      index entry is a qnode taken off the free list, its next pointer is the entry to the
+ *      right, its prev pointer is the entry one level down, and its data pointer is the queue
+ *      qnode it indexes. One queue qnode in four is indexed on level one, one in sixteen on
+ *      level two, and so on, so a search for a key costs O(log n) comparisons instead of O(n).
+ *      The index takes about one qnode per three queued elements from the same free list, so
+ *      DQUEOPT_SKIPLIST is not supported on a queue created without dynamic allocation.
+ *      With DQUE_OWNER the owner dque_myget stamps on sentinels and index entries is cleared,
+ *      so an erased iterator whose qnode was reused by the index fails dque_mysearch's check.
+ *
+ *      This function descends the levels from the top sentinel, then scans the queue itself
+ *      from the last indexed qnode before the key. It returns the first qnode not less than
+ *      the key, or greater than the key if 'upper' is set, or a NULL pointer if there is no
+ *      such qnode. The index is only used for key_* calls made with the comparison function
+ *      given to DQUEOPT_SKIPLIST, any other comparison function scans the queue as before.
+ *
+ *      Because this is an internal function, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success, search path and pointer to the found qnode
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+/**
+ *  \name	dque_mylevel
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Return a random number of index levels for a new qnode.
+ *
+ *      Each level is one quarter as likely as the level below it. A 32-bit xorshift
+ *      generator kept in the qhead is used so the library does not disturb rand().
+ */
+
+static unsigned int                         /* returned # of index levels   */
+dque_mylevel(                               /* pick random tower height     */
+dque_qhead     *queue )                     /* queue with skip list index   */
+{                                           /*------------------------------*/
+    unsigned int    ran     = getsran( queue );
+    unsigned int    lvl     = 0;
+
+    ran    ^= (ran << 13) & 0xFFFFFFFF;     /* xorshift32                   */
+    ran    ^=  ran >> 17;
+    ran    ^= (ran <<  5) & 0xFFFFFFFF;
+    setsran( queue, ran );
+
+    while ((ran & 3) == 0 && lvl < DQUE_SKIPMAX) {
+        ++lvl;                              /* 1 in 4 chance of each level  */
+        ran   >>= 2;
+    }
+
+    if (lvl > getslvl( queue ) + 1) {       /* grow at most one level a time*/
+        lvl     = getslvl( queue ) + 1;
+    }
+
+    return (lvl);
+}
+
+/**
+ *  \name	dque_mysentinel
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Add a new empty top level to the skip list index.
+ */
+
+static dque_err                             /* returned completion status   */
+dque_mysentinel(                            /* add new top level sentinel   */
+dque_qhead     *queue,                      /* queue with skip list index   */
+dque_qnode    **sent )                      /* returned new sentinel        */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if ((errcode = dque_myget( queue, sent )) == DQUEERR_NOERR) {
+        setnext( *sent, NULL_NODE       );  /* new level is empty           */
+        setdown( *sent, getskip(queue)  );  /* old top level is below it    */
+        setring( *sent, NULL_NODE       );  /* sentinels index nothing      */
+        setowner( *sent, NULL_QUEUE     );  /* not a qnode of the queue     */
+        setskip( queue, *sent           );
+        inc_uns( getslvl(queue) );
+    }
+
+    return (errcode);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myskip(                                /* search skip list for key     */
+dque_qhead     *queue,                      /* queue with skip list index   */
+void           *key,                        /* key to search queue for      */
+COMPFUNC        comp,                       /* user comparison function     */
+int             upper,                      /* 0 = first >= key, 1 = first > key */
+dque_qnode    **pred,                       /* search path, may be NULL     */
+dque_qnode    **node )                      /* found qnode, may be NULL     */
+{                                           /*------------------------------*/
+    dque_qnode     *headp   = gethead(queue);/* ptr to first qnode in queue */
+    dque_qnode     *entry   = getskip(queue);/* current index entry         */
+    dque_qnode     *currp;                  /* current queue qnode          */
+    dque_qnode     *nextp;
+    unsigned int    lvl;
+    int             val;
+
+    for (lvl = getslvl( queue ); lvl > 0; --lvl) {
+        while ((nextp = getnext(entry)) != NULL_NODE) {     /* move right on level */
+            val = (*comp)( key, getdata(getring(nextp)) );
+            if (val < 0 || (val == 0 && !upper)) {
+                break;                      /* next entry is past the key   */
+            }
+            entry = nextp;
+        }
+        if (pred != NULL_NODEP) {           /* caller wants search path?    */
+            pred[lvl-1] = entry;
+        }
+        if (lvl > 1) {                      /* go down one level            */
+            entry = getdown(entry);
+        }
+    }
+
+    if (node == NULL_NODEP) {               /* only the search path wanted? */
+        return (DQUEERR_NOERR);
+    }
+
+    if ((currp = headp) == NULL_NODE) {     /* empty queue?                 */
+        ;
+    } else if (entry != NULL_NODE && getring(entry) != NULL_NODE) {
+        if ((currp = getnext(getring(entry))) == headp) {
+            currp = NULL_NODE;              /* indexed qnode is the last one*/
+        }
+    }
+
+    while (currp != NULL_NODE) {            /* scan queue from index entry  */
+        val = (*comp)( key, getdata(currp) );
+        if (val < 0 || (val == 0 && !upper)) {
+            break;                          /* found the qnode              */
+        } else if ((currp = getnext(currp)) == headp) {
+            currp = NULL_NODE;              /* past the end of the queue    */
+        }
+    }
+
+    *node   = currp;
+
+    return (DQUEERR_NOERR);
+}
+
+/**
+ *  \name	dque_myindex
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Add index entries for a qnode just inserted into the queue.
+ *
+ *      The search path 'pred' must come from dque_myskip with 'upper' set for the
+ *      key of the new qnode, so each new entry goes just after pred on its level.
+ *      Index entries are optional, so if a qnode cannot be taken off the free list
+ *      (a queue without dynamic allocation, for instance) the new qnode simply gets
+ *      a shorter tower and no error is returned.
+ */
+
+dque_err                                    /* returned completion status   */
+dque_myindex(                               /* index new queue qnode        */
+dque_qhead     *queue,                      /* queue with skip list index   */
+dque_qnode     *node,                       /* queue qnode to index         */
+dque_qnode    **pred )                      /* search path from dque_myskip */
+{                                           /*------------------------------*/
+    dque_qnode     *entry;                  /* new index entry              */
+    dque_qnode     *down    = NULL_NODE;    /* entry one level down         */
+    unsigned int    lvl     = dque_mylevel( queue );
+    unsigned int    i;
+
+    for (i = 0; i < lvl; ++i) {
+        if (i == getslvl(queue) && dque_mysentinel( queue, &pred[i] ) != DQUEERR_NOERR) {
+            break;                          /* could not add a new level    */
+        } else if (dque_myget( queue, &entry ) != DQUEERR_NOERR) {
+            break;                          /* no qnode for the entry       */
+        }
+        setring( entry, node );
+        setdown( entry, down );
+        setowner( entry, NULL_QUEUE );      /* not a qnode of the queue     */
+        setnext( entry, getnext(pred[i]) ); /* link entry in after pred     */
+        setnext( pred[i], entry );
+        down    = entry;
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+/**
+ *  \name	dque_myunindex
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Remove the index entries of a qnode about to leave the queue.
+ *
+ *      The first qnode of the queue can only be the first entry on each level, so
+ *      it is checked without calling the comparison function. Any other qnode is
+ *      found by searching the index for its own data, so the comparison function
+ *      given to DQUEOPT_SKIPLIST must accept the user's data as a key, just as
+ *      dque_key_insert does when called with a NULL key. Empty top levels are
+ *      returned to the free list.
+ */
+
+dque_err                                    /* returned completion status   */
+dque_myunindex(                             /* remove index entries of qnode*/
+dque_qhead     *queue,                      /* queue with skip list index   */
+dque_qnode     *node )                      /* queue qnode leaving the queue*/
+{                                           /*------------------------------*/
+    dque_qnode     *pred[DQUE_SKIPMAX];     /* search path for the qnode    */
+    dque_qnode     *prevp;
+    dque_qnode     *entry;
+    unsigned int    lvl;
+
+    if (getslvl(queue) == 0) {              /* nothing indexed?             */
+        return (DQUEERR_NOERR);
+    } else if (node == gethead(queue)) {    /* first qnode, path is sentinels */
+        for (lvl = getslvl(queue), entry = getskip(queue); lvl > 0; --lvl, entry = getdown(entry)) {
+            pred[lvl-1] = entry;
+        }
+    } else {
+        (void) dque_myskip( queue, getdata(node), getscmp(queue), 0, pred, NULL_NODEP );
+    }
+
+    for (lvl = 0; lvl < getslvl(queue); ++lvl) {   /* look in run of equal keys */
+        for (prevp = pred[lvl]; (entry = getnext(prevp)) != NULL_NODE; prevp = entry) {
+            if (getring(entry) == node) {   /* found the qnode's entry      */
+                setnext( prevp, getnext(entry) );
+                (void) dque_myput( queue, entry );
+                break;
+            } else if ((*getscmp(queue))( getdata(node), getdata(getring(entry)) ) != 0) {
+                break;                      /* past the run, not indexed    */
+            }
+        }
+    }
+
+    while (getslvl(queue) > 0 && getnext(getskip(queue)) == NULL_NODE) {
+        entry   = getskip(queue);           /* remove empty top level       */
+        setskip( queue, getdown(entry) );
+        dec_uns( getslvl(queue) );
+        (void) dque_myput( queue, entry );
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+/**
+ *  \name	dque_myskipset
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Turn the skip list index on or off.
+ *
+ *      Any existing index is returned to the free list. A NULL comparison function
+ *      turns the index off, otherwise the index is rebuilt over the queue, which is
+ *      assumed to be in order by the comparison function, in one O(n) pass.
+ */
+
+dque_err                                    /* returned completion status   */
+dque_myskipset(                             /* build or drop skip list index*/
+dque_qhead     *queue,                      /* queue to index               */
+COMPFUNC        comp )                      /* comparison function or NULL  */
+{                                           /*------------------------------*/
+    dque_qnode     *tail[DQUE_SKIPMAX];     /* last entry on each level     */
+    dque_qnode     *headp;
+    dque_qnode     *currp;
+    dque_qnode     *entry;
+    dque_qnode     *down;
+    unsigned int    lvl, i;
+
+    while ((entry = getskip(queue)) != NULL_NODE) { /* drop the old index  */
+        while ((currp = getnext(entry)) != NULL_NODE) {
+            setnext( entry, getnext(currp) );
+            (void) dque_myput( queue, currp );
+        }
+        setskip( queue, getdown(entry) );
+        (void) dque_myput( queue, entry );
+    }
+    setslvl( queue, 0    );
+    setscmp( queue, comp );
+
+    if (comp == (COMPFUNC)NULL) {           /* turning the index off?       */
+        resetflag( queue, DQUE_SKIPLIST );
+        return (DQUEERR_NOERR);
+    }
+    setflag( queue, DQUE_SKIPLIST );
+
+    if ((currp = headp = gethead(queue)) == NULL_NODE) {
+        return (DQUEERR_NOERR);             /* nothing to index yet         */
+    }
+
+    do  {                                   /* append towers level by level */
+        for (i = 0, lvl = dque_mylevel( queue ), down = NULL_NODE; i < lvl; ++i) {
+            if (i == getslvl(queue) && dque_mysentinel( queue, &tail[i] ) != DQUEERR_NOERR) {
+                break;
+            } else if (dque_myget( queue, &entry ) != DQUEERR_NOERR) {
+                break;
+            }
+            setring( entry, currp     );
+            setdown( entry, down      );
+            setowner( entry, NULL_QUEUE );  /* not a qnode of the queue     */
+            setnext( entry, NULL_NODE );
+            setnext( tail[i], entry   );
+            tail[i] = entry;
+            down    = entry;
+        }
+        currp = getnext(currp);
+    } while (currp != headp);
+
+    return (DQUEERR_NOERR);
+}
@@ -0,0 +1,84 @@
+
+/**
+ *
+ *  \file	dque_myslot.c
+ *  \name	dque_myslot
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal iteration over queues that keep data in slots.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Added XOR queues
+ *
+ *      Chunked, ring, FIFO, and XOR queues have no qnodes, an iterator into one of them
+ *      is the address of the slot holding the element's data pointer, see slot2iter.
+ *      These functions pick the backend of the queue for the public iterator, front,
+ *      and back functions.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+void **                                     /* slot of first/last, NULL=none*/
+dque_myslot_end(                            /* first or last slot in queue  */
+dque_qhead     *queue,                      /* queue without qnodes         */
+int             back )                      /* non-zero = last, zero = first*/
+{                                           /*------------------------------*/
+
+    if (ischunked(queue)) {
+        return (dque_mychunk_end( queue, back ));
+    } else if (isring(queue)) {
+        return (dque_myring_end( queue, back ));
+    } else if (isxor(queue)) {
+        return (dque_myxor_end( queue, back ));
+    }
+
+    return (dque_myfifo_end( queue, back ));
+}
+
+dque_err                                    /* returned completion status   */
+dque_myslot_step(                           /* step an iterator's slot      */
+dque_qhead     *queue,                      /* queue without qnodes         */
+void         ***slotp,                      /* slot, NULL at the end        */
+int             back )                      /* non-zero = next, zero = prev */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (ischunked(queue)) {
+        errcode = dque_mychunk_step( queue, slotp, back );
+    } else if (isring(queue)) {
+        errcode = dque_myring_step( queue, slotp, back );
+    } else if (isxor(queue)) {
+        errcode = dque_myxor_step( queue, slotp, back );
+    } else if (back) {                      /* FIFO only has forward links  */
+        *slotp  = dque_myfifo_step( *slotp );
+    } else {
+        *slotp  = (void **)NULL;
+        errcode = DQUEERR_NOTSUP;
+    }
+
+    return (errcode);
+}
@@ -0,0 +1,182 @@
+/**
+ *
+ *  \file	dque_myspsc.c
+ *  \name	dque_myspsc
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal wait-free single-producer, single-consumer storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      A queue created with dque_create_spsc keeps the user's data pointers in a
+ *      ring of lcap slots, lcap a power of two, that one producer thread pushes onto
+ *      while one consumer thread pops from it. Only the producer writes tail and only
+ *      the consumer writes head, so neither needs a compare and swap, and every push
+ *      and pop finishes in a fixed number of steps whatever the other thread is
+ *      doing. The producer stores the data, then publishes it with a release store of
+ *      tail. The consumer reads tail with an acquire load before taking the data, and
+ *      frees the slots with a release store of head.
+ *
+ *      Reading the other thread's index pulls its cache line across, so each side
+ *      keeps a copy of the other's index, hcpy and tcpy, on its own line. The copy is
+ *      only refreshed when it says the ring is full or empty, which with a ring of
+ *      any size is rare, so a push or pop normally touches only its own line and the
+ *      slots. dque_myspsc_push and dque_myspsc_pop move up to cnt pointers with one
+ *      index store, for dque_push_back_n and dque_pop_front_n.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stddef.h>                         /* need for offsetof            */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_myspsc_init(                           /* lay out an SPSC block in buf */
+dque_qhead     *queue,                      /* SPSC queue                   */
+char           *buf,                        /* memory for indexes, slots    */
+size_t          siz )                       /* # of bytes in buf            */
+{                                           /*------------------------------*/
+    dque_spsc      *spsc;
+    size_t          pad;                    /* bytes to the next cache line */
+    size_t          cnt;                    /* # of slots that fit          */
+    size_t          cap     = 1;
+    size_t          i;
+
+    pad     = (DQUE_CACHELINE - (size_t)buf % DQUE_CACHELINE) % DQUE_CACHELINE;
+    if (siz < pad + offsetof(dque_spsc, slot) + DQUE_MINCNT * sizeof(void *)) {
+        return (DQUEERR_MINCNT);            /* no room for a ring?          */
+    }
+
+    cnt     = (siz - pad - offsetof(dque_spsc, slot)) / sizeof(void *);
+    while (cap <= cnt / 2 && cap <= UINT_MAX / 4) {
+        cap    *= 2;                        /* largest power of two <= cnt  */
+    }
+
+    spsc    = (dque_spsc *)(buf + pad);
+    spsc->tail  = 0;
+    spsc->hcpy  = 0;
+    spsc->head  = 0;
+    spsc->tcpy  = 0;
+    for (i = 0; i < cap; ++i) {
+        spsc->slot[i]   = (void *)NULL;
+    }
+    setlbuf( queue, spsc );
+    setlcap( queue, cap  );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myspsc_push(                           /* producer pushes up to cnt    */
+dque_qhead     *queue,                      /* SPSC queue                   */
+void          **data,                       /* user's data pointers         */
+unsigned int    cnt,                        /* # of data pointers           */
+unsigned int   *done )                      /* returned # pushed            */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_spsc      *spsc    = getspsc( queue );
+    size_t          mask    = getlcap( queue ) - 1;
+    size_t          tail    = dque_mypeek( &spsc->tail );   /* ours         */
+    size_t          room    = getlcap( queue ) - (tail - spsc->hcpy);
+    size_t          i;
+
+    if (room < cnt) {                       /* copy of head says full?      */
+        spsc->hcpy  = dque_myload( &spsc->head );
+        room    = getlcap( queue ) - (tail - spsc->hcpy);
+    }
+    if (room > cnt) {
+        room    = cnt;
+    }
+
+    for (i = 0; i < room; ++i) {
+        spsc->slot[(tail + i) & mask]   = data[i];
+    }
+    if (room != 0) {                        /* publish the slots            */
+        dque_mystore( &spsc->tail, tail + room );
+    }
+    *done   = (unsigned int)room;
+
+    return ((room < cnt) ? DQUEERR_FULL : DQUEERR_NOERR);
+#else
+    *done   = 0;
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+dque_err                                    /* returned completion status   */
+dque_myspsc_pop(                            /* consumer pops up to cnt      */
+dque_qhead     *queue,                      /* SPSC queue                   */
+void          **data,                       /* returned user's data         */
+unsigned int    cnt,                        /* # of data pointers wanted    */
+unsigned int   *done )                      /* returned # popped            */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_spsc      *spsc    = getspsc( queue );
+    size_t          mask    = getlcap( queue ) - 1;
+    size_t          head    = dque_mypeek( &spsc->head );   /* ours         */
+    size_t          have    = spsc->tcpy - head;
+    size_t          i;
+
+    if (have < cnt) {                       /* copy of tail says empty?     */
+        spsc->tcpy  = dque_myload( &spsc->tail );
+        have    = spsc->tcpy - head;
+    }
+    if (have > cnt) {
+        have    = cnt;
+    }
+
+    for (i = 0; i < have; ++i) {
+        data[i] = spsc->slot[(head + i) & mask];
+    }
+    if (have != 0) {                        /* free the slots               */
+        dque_mystore( &spsc->head, head + have );
+    }
+    *done   = (unsigned int)have;
+
+    if (have == 0 && cnt != 0) {            /* nothing to pop?              */
+        data[0] = (void *)NULL;
+        return (DQUEERR_EMPTY);
+    }
+    return (DQUEERR_NOERR);
+#else
+    *done   = 0;
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+unsigned int                                /* # of elements, a snapshot    */
+dque_myspsc_size(                           /* count SPSC queue elements    */
+dque_qhead     *queue )                     /* SPSC queue                   */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_spsc      *spsc    = getspsc( queue );
+    size_t          head    = dque_myload( &spsc->head );
+    size_t          cnt     = dque_myload( &spsc->tail ) - head;   /* tail >= head */
+
+    return ((unsigned int)((cnt > getlcap(queue)) ? getlcap(queue) : cnt));
+#else
+    return (0);
+#endif
+}
@@ -0,0 +1,262 @@
+/**
+ *
+ *  \file	dque_mysteal.c
+ *  \name	dque_mysteal
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal Chase-Lev work-stealing deque storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      A queue created with dque_create_steal keeps the user's data pointers in a
+ *      circular array indexed by two positions, bottom and top. One thread, the
+ *      owner, pushes and pops at bottom, the front of the queue, like a stack, so it
+ *      runs the work it made most recently while that is still in its cache. Any
+ *      other thread, a thief, takes from top, the back of the queue, the oldest work.
+ *      This is the deque of Chase and Lev, "Dynamic Circular Work-Stealing Deque",
+ *      with the memory orders of Le, Pop, Cohen and Zappa Nardelli, "Correct and
+ *      Efficient Work-Stealing for Weak Memory Models".
+ *
+ *      The owner's push is a store of the slot and a release store of bottom, no
+ *      compare and swap. Its pop lowers bottom first, then reads top, and only when
+ *      they meet at the last element does it race the thieves for it, with a compare
+ *      and swap of top. A thief reads top, then bottom, then the slot, and claims it
+ *      with a compare and swap of top. A thief that loses tries again, since another
+ *      thread got an element, so the steals are lock-free.
+ *
+ *      When the array is full the owner copies it into one twice the size and
+ *      publishes that with a release store of arr. A thief may still be reading the
+ *      old array, which holds the same pointers at the same positions, so it is not
+ *      freed until dque_mysteal_destroy, the arrays sum to less than twice the last.
+ *      In a static buffer the array can not grow and a full push returns DQUEERR_FULL.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stddef.h>                         /* need for ptrdiff_t, offsetof */
+#include "mydque.h"
+#include "dque.h"
+
+#ifdef DQUE_ATOMIC
+#define stealslot(a,i)  (&(a)->slot[(i) & ((a)->cap - 1)])
+#define dque_mypoke(p,v)    __atomic_store_n( (p), (v), __ATOMIC_RELAXED )
+#define dque_myfence()      __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#define dque_mycastop(p,e)  __atomic_compare_exchange_n( (p), (e), *(e) + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED )
+#endif
+
+dque_err                                    /* returned completion status   */
+dque_mysteal_init(                          /* lay out a deque in buf       */
+dque_qhead     *queue,                      /* work-stealing queue          */
+char           *buf,                        /* memory for positions, slots  */
+size_t          siz )                       /* # of bytes in buf            */
+{                                           /*------------------------------*/
+    dque_steal     *steal;
+    size_t          pad;                    /* bytes to the next cache line */
+    size_t          cnt;                    /* # of slots that fit          */
+    size_t          cap     = 1;
+
+    pad     = (DQUE_CACHELINE - (size_t)buf % DQUE_CACHELINE) % DQUE_CACHELINE;
+    if (siz < pad + offsetof(dque_steal, first.slot) + DQUE_MINCNT * sizeof(void *)) {
+        return (DQUEERR_MINCNT);            /* no room for an array?        */
+    }
+
+    cnt     = (siz - pad - offsetof(dque_steal, first.slot)) / sizeof(void *);
+    while (cap <= cnt / 2 && cap <= UINT_MAX / 4) {
+        cap    *= 2;                        /* largest power of two <= cnt  */
+    }
+
+    steal   = (dque_steal *)(buf + pad);
+    steal->top          = 0;
+    steal->bottom       = 0;
+    steal->arr          = &steal->first;
+    steal->first.cap    = cap;
+    steal->first.prev   = (dque_sarr *)NULL;
+    setlbuf( queue, steal );
+    setlcap( queue, cap   );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_mysteal_grow(                          /* owner grows array to >= cnt  */
+dque_qhead     *queue,                      /* work-stealing queue          */
+size_t          cnt )                       /* # of slots wanted            */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_steal     *steal   = getsteal( queue );
+    dque_sarr      *old     = steal->arr;   /* only the owner changes arr   */
+    dque_sarr      *arr;
+    size_t          cap     = old->cap;
+    size_t          bottom  = dque_mypeek( &steal->bottom );
+    size_t          i;
+
+    while (cap < cnt && cap <= UINT_MAX / 2) {
+        cap    *= 2;                        /* next power of two            */
+    }
+
+    if (cap <= old->cap) {                  /* already big enough?          */
+        return (DQUEERR_NOERR);
+    } else if (getflag(queue, DQUE_NOALLOC)) {      /* static buffer deque? */
+        return (DQUEERR_ALLOCNA);
+    } else if (cap < cnt) {                 /* no power of two that large   */
+        return (DQUEERR_NOALLOC);
+    } else if ((arr = (dque_sarr *)dque_mymalloc( queue, offsetof(dque_sarr, slot) + cap * sizeof(void *) )) == (dque_sarr *)NULL) {
+        return (DQUEERR_NOALLOC);
+    }
+
+    arr->cap    = cap;
+    arr->prev   = old;                      /* thieves may still read it    */
+    for (i = dque_myload( &steal->top ); i != bottom; ++i) {
+        dque_mypoke( stealslot(arr, i), dque_mypeek( stealslot(old, i) ) );
+    }
+    dque_mystore( &steal->arr, arr );       /* publish the copied slots     */
+    setlcap( queue, cap );
+
+    return (DQUEERR_NOERR);
+#else
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+dque_err                                    /* returned completion status   */
+dque_mysteal_push(                          /* owner pushes onto bottom     */
+dque_qhead     *queue,                      /* work-stealing queue          */
+void           *data )                      /* user's data                  */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_steal     *steal   = getsteal( queue );
+    dque_err        errcode;
+    size_t          bottom  = dque_mypeek( &steal->bottom );
+    size_t          top     = dque_myload( &steal->top );
+
+    if (bottom - top >= steal->arr->cap) {  /* full, double the array       */
+        if ((errcode = dque_mysteal_grow( queue, steal->arr->cap * 2 )) != DQUEERR_NOERR) {
+            return ((errcode == DQUEERR_ALLOCNA) ? DQUEERR_FULL : errcode);
+        }
+    }
+
+    dque_mypoke( stealslot(steal->arr, bottom), data );
+    dque_mystore( &steal->bottom, bottom + 1 );     /* publish the slot     */
+
+    return (DQUEERR_NOERR);
+#else
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+dque_err                                    /* returned completion status   */
+dque_mysteal_pop(                           /* owner pops off bottom        */
+dque_qhead     *queue,                      /* work-stealing queue          */
+void          **data )                      /* returned user's data         */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_steal     *steal   = getsteal( queue );
+    size_t          bottom  = dque_mypeek( &steal->bottom ) - 1;
+    size_t          top;
+
+    dque_mypoke( &steal->bottom, bottom );  /* keep thieves off the last one*/
+    dque_myfence();                         /* before reading top           */
+    top     = dque_mypeek( &steal->top );
+
+    if ((ptrdiff_t)(bottom - top) < 0) {    /* was empty                    */
+        dque_mypoke( &steal->bottom, bottom + 1 );
+        *data   = (void *)NULL;
+        return (DQUEERR_EMPTY);
+    }
+
+    *data   = dque_mypeek( stealslot(steal->arr, bottom) );
+    if (bottom == top) {                    /* last one, race the thieves   */
+        if (!dque_mycastop( &steal->top, &top )) {
+            *data   = (void *)NULL;         /* a thief took it              */
+        }
+        dque_mypoke( &steal->bottom, bottom + 1 );
+    }
+
+    return ((*data == (void *)NULL) ? DQUEERR_EMPTY : DQUEERR_NOERR);
+#else
+    *data   = (void *)NULL;
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+dque_err                                    /* returned completion status   */
+dque_mysteal_take(                          /* thief steals off top         */
+dque_qhead     *queue,                      /* work-stealing queue          */
+void          **data )                      /* returned user's data         */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_steal     *steal   = getsteal( queue );
+    size_t          top;
+    size_t          bottom;
+
+    for (;;) {
+        top     = dque_myload( &steal->top );
+        dque_myfence();                     /* before reading bottom        */
+        bottom  = dque_myload( &steal->bottom );
+        if ((ptrdiff_t)(bottom - top) <= 0) {
+            *data   = (void *)NULL;
+            return (DQUEERR_EMPTY);
+        }
+        *data   = dque_mypeek( stealslot(dque_myload( &steal->arr ), top) );
+        if (dque_mycastop( &steal->top, &top )) {
+            return (DQUEERR_NOERR);
+        }                                   /* lost to the owner or a thief */
+    }
+#else
+    *data   = (void *)NULL;
+    return (DQUEERR_NOTSUP);
+#endif
+}
+
+unsigned int                                /* # of elements, a snapshot    */
+dque_mysteal_size(                          /* count deque elements         */
+dque_qhead     *queue )                     /* work-stealing queue          */
+{                                           /*------------------------------*/
+#ifdef DQUE_ATOMIC
+    dque_steal     *steal   = getsteal( queue );
+    size_t          top     = dque_myload( &steal->top );
+    size_t          bottom  = dque_myload( &steal->bottom );
+
+    /* bottom is one below top while the owner pops an empty deque          */
+    return ((unsigned int)(((ptrdiff_t)(bottom - top) < 0) ? 0 : bottom - top));
+#else
+    return (0);
+#endif
+}
+
+void
+dque_mysteal_destroy(                       /* free the grown arrays        */
+dque_qhead     *queue )                     /* work-stealing queue          */
+{                                           /*------------------------------*/
+    dque_steal     *steal;
+    dque_sarr      *arr;
+
+    if (issteal(queue)) {
+        steal   = getsteal( queue );
+        while ((arr = steal->arr) != &steal->first) {
+            steal->arr  = arr->prev;
+            dque_myfree( queue, arr, offsetof(dque_sarr, slot) + arr->cap * sizeof(void *) );
+        }
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ *
+ *  \file	dque_mywait.c
+ *  \name	dque_mywait
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal blocking waits for dque_pop_front_wait and dque_push_back_wait.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Shrink qhead, on-demand lock
+ *
+ *      dque_mywaitset(
+ *      qhead                  *queue,         queue to wait on
+ *      int                     on )           !0 = create the condvars, 0 = destroy them
+ *
+ *      dque_mywake(
+ *      qhead                  *queue,         queue that was pushed onto, or popped off
+ *      int                     side,          DQUE_WAITPOP after pushes, DQUE_WAITPUSH after pops
+ *      unsigned int            cnt )          # of elements pushed, or popped
+ *
+ *      dque_mywait(
+ *      qhead                  *queue,         queue to wait on
+ *      int                     side,          DQUE_WAITPOP or DQUE_WAITPUSH
+ *      long                    timeout,       milliseconds, <0 = forever, 0 = try once
+ *      dque_err              (*tryfn)( qhead *, void * ),   the push or pop to retry
+ *      void                   *arg )          passed to tryfn
+ *
+ *      A LOCKED, MPMC or SPSC queue has a condition variable for each side, threads
+ *      waiting for data and threads waiting for room, created by dque_mywaitset when
+ *      the queue is made thread safe. If they cannot be created the queue still
+ *      works, only a wait on it returns DQUEERR_NOTSUP. dque_mywait retries the push
+ *      or pop DQUE_SPINCNT times, since a busy queue is rarely empty or full for long,
+ *      and only then parks.
+ *
+ *      A waiter never holds wmtx while it calls into the queue, that would order
+ *      wmtx against the queue's own mutex. Instead it counts itself in wcnt, notes
+ *      wgen, tries again, and sleeps only while wgen is unchanged. A push or pop
+ *      that finds a waiter counted bumps wgen under wmtx, so a change made after
+ *      the waiter's last try is never missed, and signals one waiter per element,
+ *      so one push does not wake every consumer to race for one element. When
+ *      nobody waits, dque_mywake is a fence and a load of wcnt.
+ *
+ *      Timeouts are measured on CLOCK_MONOTONIC, where pthreads lets a condvar use
+ *      it, so setting the clock does not stretch or cut short a wait.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE                     /* need clock_gettime           */
+#endif
+#include <stdio.h>                          /* need NULL definition         */
+#include <errno.h>                          /* need ETIMEDOUT               */
+#include "mydque.h"
+#include "dque.h"
+
+#if defined(__APPLE__)                      /* no pthread_condattr_setclock */
+#define DQUE_WAITCLOCK  CLOCK_REALTIME
+#else
+#define DQUE_WAITCLOCK  CLOCK_MONOTONIC
+#endif
+
+dque_err                                    /* returned completion status   */
+dque_mywaitset(                             /* create or destroy condvars   */
+dque_qhead     *queue,                      /* queue to wait on             */
+int             on )                        /* !0 = on, 0 = off             */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+#ifdef DQUE_WAIT
+    pthread_condattr_t  attr;
+    int             side;
+    int             made    = 0;            /* # of condvars initialized    */
+
+    if (on && !iswaitable(queue)) {
+        if ((errcode = dque_mylockmem( queue, 1 )) != DQUEERR_NOERR) {
+            return (errcode);
+        } else if (pthread_mutex_init( &getwait(queue).wmtx, NULL ) != 0) {
+            (void) dque_mylockmem( queue, 0 );
+            return (DQUEERR_NOALLOC);
+        }
+        if (pthread_condattr_init( &attr ) == 0) {
+#if !defined(__APPLE__)
+            (void) pthread_condattr_setclock( &attr, DQUE_WAITCLOCK );
+#endif
+            while (made < 2 && pthread_cond_init( &getwait(queue).cond[made], &attr ) == 0) {
+                ++made;
+            }
+            (void) pthread_condattr_destroy( &attr );
+        }
+        if (made < 2) {                     /* no resources for a condvar   */
+            while (made > 0) {
+                (void) pthread_cond_destroy( &getwait(queue).cond[--made] );
+            }
+            (void) pthread_mutex_destroy( &getwait(queue).wmtx );
+            (void) dque_mylockmem( queue, 0 );
+            errcode = DQUEERR_NOALLOC;
+        } else {
+            for (side = DQUE_WAITPOP; side <= DQUE_WAITPUSH; ++side) {
+                getwait(queue).wcnt[side]   = 0;
+                getwait(queue).wgen[side]   = 0;
+            }
+            setflag( queue, DQUE_CONDVAR );
+        }
+    } else if (!on && iswaitable(queue)) {
+        resetflag( queue, DQUE_CONDVAR );
+        for (side = DQUE_WAITPOP; side <= DQUE_WAITPUSH; ++side) {
+            (void) pthread_cond_destroy( &getwait(queue).cond[side] );
+        }
+        (void) pthread_mutex_destroy( &getwait(queue).wmtx );
+        (void) dque_mylockmem( queue, 0 );  /* unless still LOCKED          */
+    }
+#endif
+
+    return (errcode);
+}
+
+void
+dque_mywake(                                /* wake waiters after n changes */
+dque_qhead     *queue,                      /* queue pushed onto, popped off*/
+int             side,                       /* waiters to wake              */
+unsigned int    cnt )                       /* # of elements pushed, popped */
+{                                           /*------------------------------*/
+#ifdef DQUE_WAIT
+    unsigned int    n;
+
+    /* pairs with the fence in dque_mywait: either it sees our change, or   */
+    /* we see it counted in wcnt                                            */
+    __atomic_thread_fence( __ATOMIC_SEQ_CST );
+    if (cnt == 0 || dque_mypeek( &getwait(queue).wcnt[side] ) == 0) {
+        return;                             /* nobody waiting               */
+    }
+
+    (void) pthread_mutex_lock( &getwait(queue).wmtx );
+    __atomic_add_fetch( &getwait(queue).wgen[side], 1, __ATOMIC_RELEASE );
+    n   = dque_mypeek( &getwait(queue).wcnt[side] );
+    for (n = (cnt < n) ? cnt : n; n > 0; --n) {
+        (void) pthread_cond_signal( &getwait(queue).cond[side] );
+    }
+    (void) pthread_mutex_unlock( &getwait(queue).wmtx );
+#else
+    (void) queue;
+    (void) side;
+    (void) cnt;
+#endif
+}
+
+dque_err                                    /* returned completion status   */
+dque_mywait(                                /* retry a push or pop, park    */
+dque_qhead     *queue,                      /* queue to wait on             */
+int             side,                       /* DQUE_WAITPOP, DQUE_WAITPUSH  */
+long            timeout,                    /* ms, <0 = forever, 0 = once   */
+dque_err      (*tryfn)( dque_qhead *, void * ),   /* the push or pop          */
+void           *arg )                       /* passed to tryfn              */
+{                                           /*------------------------------*/
+    dque_err        errcode;                /* non-zero indicates failure   */
+    dque_err        busy    = (side == DQUE_WAITPOP) ? DQUEERR_EMPTY : DQUEERR_FULL;
+    unsigned int    i;
+#ifdef DQUE_WAIT
+    struct timespec until;                  /* deadline on DQUE_WAITCLOCK   */
+    unsigned int    gen;                    /* wgen before the last try     */
+    int             late    = 0;            /* deadline passed              */
+#endif
+
+    errcode = (*tryfn)( queue, arg );
+    for (i = 0; i < DQUE_SPINCNT && errcode == busy && timeout != 0; ++i) {
+        errcode = (*tryfn)( queue, arg );   /* spin briefly                 */
+    }
+
+#ifdef DQUE_WAIT
+    if (errcode == busy && timeout != 0) {
+        if (timeout > 0) {
+            (void) clock_gettime( DQUE_WAITCLOCK, &until );
+            until.tv_sec   += timeout / 1000;
+            until.tv_nsec  += (timeout % 1000) * 1000000L;
+            if (until.tv_nsec >= 1000000000L) {
+                until.tv_nsec  -= 1000000000L;
+                ++until.tv_sec;
+            }
+        }
+
+        __atomic_add_fetch( &getwait(queue).wcnt[side], 1, __ATOMIC_SEQ_CST );
+        for (;;) {
+            gen     = dque_myload( &getwait(queue).wgen[side] );
+            __atomic_thread_fence( __ATOMIC_SEQ_CST );
+            if ((errcode = (*tryfn)( queue, arg )) != busy || late) {
+                break;                      /* done, failed, or timed out   */
+            }
+            (void) pthread_mutex_lock( &getwait(queue).wmtx );
+            while (!late && gen == dque_mypeek( &getwait(queue).wgen[side] )) {
+                if (timeout < 0) {
+                    (void) pthread_cond_wait( &getwait(queue).cond[side], &getwait(queue).wmtx );
+                } else if (pthread_cond_timedwait( &getwait(queue).cond[side], &getwait(queue).wmtx, &until ) == ETIMEDOUT) {
+                    late    = 1;            /* one last try, then give up   */
+                }
+            }
+            (void) pthread_mutex_unlock( &getwait(queue).wmtx );
+        }
+        __atomic_sub_fetch( &getwait(queue).wcnt[side], 1, __ATOMIC_SEQ_CST );
+    }
+#endif
+
+    return (errcode);
+}
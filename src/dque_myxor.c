@@ -0,0 +1,211 @@
+
+/**
+ *
+ *  \file	dque_myxor.c
+ *  \name	dque_myxor
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Internal XOR-linked storage backend.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      A queue created with dque_create_xor links its data with the same 16 byte
+ *      snodes as a FIFO queue, but the one link of an snode is the XOR of the
+ *      addresses of its previous and next snodes, NULL at either end. Knowing one
+ *      neighbour of an snode gives the other, so the queue can still be walked in
+ *      both directions from shed or stal and pushed and popped at both ends in O(1),
+ *      for half the memory of a qnode.
+ *
+ *      A dque_qiter is one pointer, so it can not carry the neighbour's address. The
+ *      qhead carries it instead: xcur is the snode an iterator last moved to and
+ *      xprv is the snode before it. Stepping forward or backward from xcur is O(1),
+ *      which covers the usual begin/next and rbegin/rnext loops. Stepping from any
+ *      other snode first finds its neighbour by walking from shed, O(n). Popping the
+ *      cached snode or its neighbour clears the cache.
+ *
+ *      Because these are internal functions, there is no error checking of the function's arguments.
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include <stdint.h>                         /* need for uintptr_t           */
+#include "mydque.h"
+#include "dque.h"
+
+/* XOR of two snode addresses, either may be NULL                           */
+#define xlink(a,b)      ((dque_snode *)((uintptr_t)(a) ^ (uintptr_t)(b)))
+#define slot2snode(s)   ((dque_snode *)((char *)(s) - offsetof(dque_snode, data)))
+
+dque_err                                    /* returned completion status   */
+dque_myxor_push(                            /* push onto XOR queue          */
+dque_qhead     *queue,                      /* XOR queue                    */
+void           *data,                       /* user's data                  */
+int             back )                      /* non-zero = back, zero = front*/
+{                                           /*------------------------------*/
+    dque_snode     *node;
+    dque_snode     *end     = back ? getstal(queue) : getshed(queue);
+
+    if ((node = dque_myfifo_get( queue )) == NULL_SNODE) {
+        return (DQUEERR_NOALLOC);
+    }
+
+    node->data  = data;
+    node->next  = end;                      /* end's address XOR NULL       */
+    if (end == NULL_SNODE) {                /* first snode is head and tail */
+        setshed( queue, node );
+        setstal( queue, node );
+    } else if (back) {
+        end->next   = xlink( end->next, node );
+        setstal( queue, node );
+    } else {
+        end->next   = xlink( end->next, node );
+        setshed( queue, node );
+    }
+    if (!back && getxcur(queue) == end) {   /* cached snode's prev changed  */
+        setxprv( queue, node );
+    }
+    inc_uns( gethcnt(queue) );
+
+    return (DQUEERR_NOERR);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myxor_pop(                             /* pop off XOR queue            */
+dque_qhead     *queue,                      /* XOR queue                    */
+void          **data,                       /* returned user's data         */
+int             back )                      /* non-zero = back, zero = front*/
+{                                           /*------------------------------*/
+    dque_snode     *node    = back ? getstal(queue) : getshed(queue);
+    dque_snode     *next;
+
+    if (node == NULL_SNODE) {               /* empty queue?                 */
+        *data   = (void *)NULL;
+        return (DQUEERR_NOERR);
+    }
+
+    *data   = node->data;
+    next    = node->next;                   /* only neighbour, XOR NULL     */
+    if (next != NULL_SNODE) {
+        next->next  = xlink( next->next, node );
+    }
+    if (back) {
+        setstal( queue, next );
+    } else {
+        setshed( queue, next );
+    }
+    if (next == NULL_SNODE) {               /* popped the last snode?       */
+        setshed( queue, NULL_SNODE );
+        setstal( queue, NULL_SNODE );
+    }
+    if (getxcur(queue) == node || getxprv(queue) == node) {
+        setxcur( queue, NULL_SNODE );       /* cached neighbour is gone     */
+        setxprv( queue, NULL_SNODE );
+    }
+    dec_uns( gethcnt(queue) );
+    dque_myfifo_put( queue, node );
+
+    return (DQUEERR_NOERR);
+}
+
+void **                                     /* slot of first/last, NULL=none*/
+dque_myxor_end(                             /* first or last data in queue  */
+dque_qhead     *queue,                      /* XOR queue                    */
+int             back )                      /* non-zero = last, zero = first*/
+{                                           /*------------------------------*/
+    dque_snode     *node    = back ? getstal(queue) : getshed(queue);
+
+    if (node == NULL_SNODE) {               /* empty queue?                 */
+        return ((void **)NULL);
+    }
+    setxcur( queue, node );                 /* cache the iterator's prev    */
+    setxprv( queue, back ? node->next : NULL_SNODE );
+
+    return (&node->data);
+}
+
+dque_err                                    /* returned completion status   */
+dque_myxor_step(                            /* step an iterator's slot      */
+dque_qhead     *queue,                      /* XOR queue                    */
+void         ***slotp,                      /* slot, NULL at the end        */
+int             back )                      /* non-zero = next, zero = prev */
+{                                           /*------------------------------*/
+    dque_snode     *node    = slot2snode( *slotp );
+    dque_snode     *prev    = NULL_SNODE;
+    dque_snode     *curr;
+    dque_snode     *next;
+
+    if (node == getxcur(queue)) {           /* neighbour is cached          */
+        prev    = getxprv(queue);
+    } else {                                /* walk from the head to find it*/
+        for (curr = getshed(queue); curr != node && curr != NULL_SNODE; curr = next) {
+            next    = xlink( curr->next, prev );
+            prev    = curr;
+        }
+        if (curr == NULL_SNODE) {           /* not an snode in this queue   */
+            *slotp  = (void **)NULL;
+            return (DQUEERR_INVITER);
+        }
+    }
+
+    if (back) {                             /* forward: next = link ^ prev  */
+        next    = xlink( node->next, prev );
+        setxcur( queue, next );
+        setxprv( queue, (next == NULL_SNODE) ? NULL_SNODE : node );
+        *slotp  = (next == NULL_SNODE) ? (void **)NULL : &next->data;
+    } else if (prev == NULL_SNODE) {        /* backward from the head       */
+        setxcur( queue, NULL_SNODE );
+        setxprv( queue, NULL_SNODE );
+        *slotp  = (void **)NULL;
+    } else {                                /* prev's prev = link ^ node    */
+        setxcur( queue, prev );
+        setxprv( queue, xlink( prev->next, node ) );
+        *slotp  = &prev->data;
+    }
+
+    return (DQUEERR_NOERR);
+}
+
+void **                                     /* found slot, NULL = none      */
+dque_myxor_scan(                            /* find key in ordered XOR queue*/
+dque_qhead     *queue,                      /* XOR queue                    */
+void           *key,                        /* key to search for            */
+COMPFUNC        comp )                      /* user comparison function     */
+{                                           /*------------------------------*/
+    dque_snode     *prev    = NULL_SNODE;
+    dque_snode     *curr;
+    dque_snode     *next;
+    int             val;
+
+    for (curr = getshed(queue); curr != NULL_SNODE; curr = next) {
+        if ((val = (*comp)( key, curr->data )) == 0) {
+            setxcur( queue, curr );         /* found iterator steps in O(1) */
+            setxprv( queue, prev );
+            return (&curr->data);
+        } else if (val < 0) {               /* past where key is in queue?  */
+            break;
+        }
+        next    = xlink( curr->next, prev );
+        prev    = curr;
+    }
+
+    return ((void **)NULL);
+}
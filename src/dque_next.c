@@ -9,6 +9,10 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Use dque_myslot for chunked, ring, and FIFO queues
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
  *
  *      dque_next(
  *              qhead          *queue,      queue with element data
@@ -54,7 +58,9 @@ dque_qiter    **iterp )                     /* ptr to ptr to iterator       */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qiter     *iter;                   /* iterator ptr to node in queue*/
+    void          **slot;                   /* slot in chunked queue        */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (iterp == NULL_QITERP) {      /* invalid iterator pointer?    */
@@ -65,12 +71,18 @@ dque_qiter    **iterp )                     /* ptr to ptr to iterator       */
         if (getdata(iter) == (void *)NULL) {/* invalid iterator?            */
             errcode = DQUEERR_INVITER;
             iter    = NULL_QITER;
+        } else if (isslots(queue)) {        /* step to next slot            */
+            slot    = iter2slot( iter );
+            errcode = dque_myslot_step( queue, &slot, 1 );
+            iter    = (slot == (void **)NULL) ? NULL_QITER : slot2iter( slot );
 	} else if ((iter = getnext(iter)) == gethead( queue )) { /* queue end? */
             iter    = NULL_QITER;           /* pointer to stop iteration    */
         }
         *iterp  = iter;                     /* save new iterator            */
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
@@ -9,6 +9,20 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Added DQUEOPT_SKIPLIST
+ *  1.2		10/17/2026  	agent       Added DQUEOPT_GROWFIX, DQUEOPT_GROWGEO
+ *  1.2		10/17/2026  	agent       Added DQUEOPT_WATERMARK
+ *  1.2		10/17/2026  	agent       Allocation options of a pooled queue set its pool
+ *  1.2		10/17/2026  	agent       Added DQUEOPT_ARENA
+ *  1.2		10/17/2026  	agent       Added DQUEOPT_INTRUSIVE
+ *  1.2		10/17/2026  	agent       DQUEOPT_SKIPLIST and DQUEOPT_INTRUSIVE not supported on chunked or ring queues
+ *  1.2		10/17/2026  	agent       DQUEOPT_INTRUSIVE drops the uncarved inline qnodes
+ *  1.2		10/17/2026  	agent       DQUEOPT_ARENA not supported on chunked, ring, or FIFO queues
+ *  1.2		10/17/2026  	agent       Added DQUEOPT_LOCKED
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       DQUEOPT_GROWFIX restores the DQUEOPT_NODECNT node count
+ *  1.2		10/17/2026  	agent       DQUEOPT_SKIPLIST not supported without dynamic allocation
  *
  *      dque_options( 
  *      dque_qhead             *queue;         queue to control
@@ -35,6 +49,25 @@
  *                            non-zero means no scan on insert and remove, zero means use scan on insert and remove
  *      DQUEOPT_NOORDER     - dque_options( queue, DQUEOPT_NOORDER, unsigned int siz )
  *                            non-zero means find does not assume ordered queue, zero means find assumes ordered queue
+ *      DQUEOPT_SKIPLIST    - dque_options( queue, DQUEOPT_SKIPLIST, COMPFUNC comp )
+ *                            builds a skip list index used by key functions called with comp, NULL drops the index
+ *                            index entries are qnodes from the free list, about one per three queued elements,
+ *                            so a queue without dynamic allocation returns DQUEERR_NOTSUP rather than lose capacity
+ *      DQUEOPT_GROWFIX     - dque_options( queue, DQUEOPT_GROWFIX )
+ *                            every memory allocation is the DQUEOPT_NODECNT number of nodes, the default
+ *      DQUEOPT_GROWGEO     - dque_options( queue, DQUEOPT_GROWGEO, unsigned int cap )
+ *                            double the number of nodes with each memory allocation up to cap nodes
+ *      DQUEOPT_WATERMARK   - dque_options( queue, DQUEOPT_WATERMARK, unsigned int hi, unsigned int lo )
+ *                            when the free list grows past hi nodes, release free blocks until it is down to lo nodes
+ *      DQUEOPT_ARENA       - dque_options( queue, DQUEOPT_ARENA, unsigned int cnt, unsigned int flags )
+ *                            carve at least cnt nodes from one mmap'd arena, see dque_myarena for the DQUEARENA_* flags
+ *      DQUEOPT_INTRUSIVE   - dque_options( queue, DQUEOPT_INTRUSIVE, unsigned int off )
+ *                            the user's data has a zeroed dque_link at offset off that is linked instead of a qnode,
+ *                            only on an empty queue, see dque_mylink
+ *      DQUEOPT_LOCKED      - dque_options( queue, DQUEOPT_LOCKED, unsigned int on )
+ *                            !0 = every call holds the queue's mutex while it changes the queue, 0 = no lock,
+ *                            set on a pool too when its queues are used from several threads, see dque_mylockset,
+ *                            the mutex is allocated when turned on, or taken from a static buffer's unused qnodes
  *
  *      \return non-zero for failure, zero for success, and if query, returned pointers to data
  *
@@ -66,8 +99,9 @@ int             opt,                        /* get/set option               */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     int             *major, *minor;
-    unsigned int    siz, *val;
+    unsigned int    siz, lo, *val;
     char           *buf;
+    COMPFUNC        comp;
     va_list         args;
 
     if (queue == NULL_QUEUE && !(opt == DQUEOPT_HEADSIZ || opt == DQUEOPT_NODESIZ) ) {
@@ -88,7 +122,8 @@ int             opt,                        /* get/set option               */
                 if (siz < (unsigned int)DQUE_MINCNT) {
                     errcode = DQUEERR_MINCNT;   /* siz not => minimum size? */
                 } else {
-                    setacnt( queue, siz );  /* valid node count size, set it*/
+                    setacnt( getnodes(queue), siz );  /* valid node count size, set it*/
+                    setncnt( getnodes(queue), siz );
                 }
                 break;
             case DQUEOPT_HEADSIZ:           /* returns size of queue head   */
@@ -118,6 +153,77 @@ int             opt,                        /* get/set option               */
                 siz     = va_arg( args, unsigned int ); /* siz == a boolean  */
                 setflag( queue, ((siz != 0) ? DQUE_NOSCAN : 0) );
                 break;
+            case DQUEOPT_SKIPLIST:      /* comp = skip list index on, NULL = off */
+                comp    = va_arg( args, COMPFUNC );
+                if ((isslots(queue) || islockfree(queue)) && comp != (COMPFUNC)NULL) {
+                    errcode = DQUEERR_NOTSUP;   /* no qnodes to index       */
+                } else if (getflag( getnodes(queue), DQUE_NOALLOC ) != 0 && comp != (COMPFUNC)NULL) {
+                    errcode = DQUEERR_NOTSUP;   /* index would use user's qnodes */
+                } else {
+                    errcode = dque_myskipset( queue, comp );
+                }
+                break;
+            case DQUEOPT_GROWFIX:       /* fixed size node allocations  */
+                setgcap( getnodes(queue), 0 );
+                setacnt( getnodes(queue), getncnt( getnodes(queue) ) );  /* undo doubling */
+                break;
+            case DQUEOPT_GROWGEO:       /* double node allocations up to cap */
+		siz = va_arg( args, unsigned int );
+                if (siz < (unsigned int)DQUE_MINCNT) {
+                    errcode = DQUEERR_MINCNT;   /* siz not => minimum size? */
+                } else {
+                    setgcap( getnodes(queue), siz );
+                    if (getacnt( getnodes(queue) ) > siz) {
+                        setacnt( getnodes(queue), siz );  /* start no larger than cap */
+                    }
+                }
+                break;
+            case DQUEOPT_WATERMARK:     /* hi = 0 turns off watermarks  */
+		siz = va_arg( args, unsigned int );
+                lo  = va_arg( args, unsigned int );
+                if (siz != 0 && lo >= siz) {
+                    errcode = DQUEERR_INVARG;   /* low not below high?      */
+                } else {
+                    setwmhi( getnodes(queue), siz );
+                    setwmlo( getnodes(queue), lo  );
+                    setwtrg( getnodes(queue), siz );
+                }
+                break;
+            case DQUEOPT_ARENA:         /* mmap'd node arena            */
+		siz = va_arg( args, unsigned int );
+                lo  = va_arg( args, unsigned int );   /* lo == DQUEARENA_* flags */
+                if (isslots(queue) || islockfree(queue)) {
+                    errcode = DQUEERR_NOTSUP;   /* no qnodes to carve       */
+                } else {
+                    errcode = dque_myarena( getnodes(queue), siz, lo );
+                }
+                break;
+            case DQUEOPT_INTRUSIVE:     /* off = offsetof dque_link in data */
+		siz = va_arg( args, unsigned int );
+#ifdef DQUE_COMPACT
+                errcode = DQUEERR_NOTSUP;   /* user's objects are not in the window */
+#else
+                if (isslots(queue) || islockfree(queue)) {
+                    errcode = DQUEERR_NOTSUP;   /* data is kept in slots    */
+                } else if (gethead(queue) != NULL_NODE || getflag( queue, DQUE_POOL ) != 0) {
+                    errcode = DQUEERR_INVARG;   /* only on an empty queue   */
+                } else {
+                    setioff( queue, siz );
+                    setflag( queue, DQUE_INTRUSIVE );
+                    setfcnt( queue, getfcnt(queue) - getccnt(queue) );
+                    setcarv( queue, NULL_NODE );    /* inline qnodes unused */
+                    setccnt( queue, 0 );
+                }
+#endif
+                break;
+            case DQUEOPT_LOCKED:        /* !0 = queue has a mutex, 0 = none */
+                siz     = va_arg( args, unsigned int ); /* siz == a boolean  */
+                if (islockfree(queue) && siz != 0) {
+                    errcode = DQUEERR_NOTSUP;   /* lock-free already        */
+                } else {
+                    errcode = dque_mylockset( queue, siz != 0 );
+                }
+                break;
             default:
                 errcode = DQUEERR_UNKOPT;
                 break;
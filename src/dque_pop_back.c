@@ -9,6 +9,15 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use dque_myget/dque_myput for free list qnodes, keep skip list index
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Not supported on FIFO queues
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
  *
  *      dque_pop_back(
  *      dque_qhead             *queue,         queue with element data
@@ -54,19 +63,34 @@ void          **data )                      /* returned data pointer        */
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *node;                   /* pointer to deleted node      */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (void **)NULL) {     /* invalid data pointer?        */
         errcode = DQUEERR_NODATAP;
+    } else if (islockfree(queue)) {         /* only push_back and pop_front */
+        errcode = DQUEERR_NOTSUP;
+    } else if (ischunked(queue)) {          /* take data from a chunk slot  */
+        errcode = dque_mychunk_pop( queue, data, 1 );
+    } else if (isring(queue)) {             /* take data from a ring slot   */
+        errcode = dque_myring_pop( queue, data, 1 );
+    } else if (isfifo(queue)) {             /* no backward links            */
+        errcode = DQUEERR_NOTSUP;
+    } else if (isxor(queue)) {              /* unlink the last XOR snode    */
+        errcode = dque_myxor_pop( queue, data, 1 );
     } else if (gethead(queue) == NULL_NODE){/* empty queue?                 */
         *data    = (void *)NULL;            /* technically OK, but no data  */
+    } else if (getflag(queue,DQUE_SKIPLIST) && (errcode = dque_myunindex( queue, getprev(gethead(queue)) )) != DQUEERR_NOERR) {
+        ;                                   /* remove from skip list index  */
     } else if ((errcode = dque_mydelete( &gethead( queue ), &node, ROTATE, &gethcnt( queue ) )) != DQUEERR_NOERR) {
         ;                                   /* ROTATE to delete from back   */
-    } else if ((errcode = dque_myinsert( &getfree( queue ), node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        *data   = getdata( node );
-	setdata( node, (void *)NULL );      /* set to null for safety       */
+    } else {
+        *data   = getdata( node );          /* get data before freeing node */
+        errcode = dque_myunlink( queue, node );
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
@@ -9,6 +9,18 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use dque_myget/dque_myput for free list qnodes, keep skip list index
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Added FIFO queue support
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       Added lock-free MPMC queues
+ *  1.2		10/17/2026  	agent       Added wait-free SPSC queues
+ *  1.2		10/17/2026  	agent       Wake a thread waiting in dque_push_back_wait
+ *  1.2		10/17/2026  	agent       Added work-stealing deques
+ *  1.2		10/17/2026  	agent       Added lock-free priority queues
  *
  *      dque_pop_front(
  *      dque_qhead             *queue,         queue with element data
@@ -19,6 +31,8 @@
  *	puts it onto the free list, and then returns the pointer to the data from 
  *	the removed qnode. This function also sets the data pointer of the removed
  *	node to (void *)NULL to indicate the node is now invalid to any iterators.
+ *	A lock-free MPMC queue also returns DQUEERR_EMPTY when it is empty. On a
+ *	work-stealing deque only its owner thread may pop, see dque_create_steal.
  *
  *      \return non-zero for failure, zero for success and pointer to user's data
  *
@@ -53,18 +67,44 @@ void          **data )                      /* returned pointer to data     */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *node;                   /* pointer to deleted node      */
+    unsigned int    cnt;                    /* # popped off an SPSC queue   */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (void **)NULL) {     /* invalid data pointer?        */
         errcode = DQUEERR_NODATAP;
+    } else if (ismpmc(queue)) {             /* lock-free pop off a cell     */
+        errcode = dque_mympmc_pop( queue, data );
+    } else if (isspsc(queue)) {             /* wait-free pop off a slot     */
+        errcode = dque_myspsc_pop( queue, data, 1, &cnt );
+    } else if (issteal(queue)) {            /* owner pops off the bottom    */
+        errcode = dque_mysteal_pop( queue, data );
+    } else if (isprio(queue)) {             /* lock-free pop of the smallest*/
+        errcode = dque_myprio_pop( queue, data );
+    } else if (ischunked(queue)) {          /* take data from a chunk slot  */
+        errcode = dque_mychunk_pop( queue, data, 0 );
+    } else if (isring(queue)) {             /* take data from a ring slot   */
+        errcode = dque_myring_pop( queue, data, 0 );
+    } else if (isfifo(queue)) {             /* unlink the first snode       */
+        errcode = dque_myfifo_pop( queue, data );
+    } else if (isxor(queue)) {              /* unlink the first XOR snode   */
+        errcode = dque_myxor_pop( queue, data, 0 );
     } else if (gethead(queue) == NULL_NODE){/* empty queue?                 */
         *data    = (void *)NULL;            /* technically OK, but no data  */
+    } else if (getflag(queue,DQUE_SKIPLIST) && (errcode = dque_myunindex( queue, gethead(queue) )) != DQUEERR_NOERR) {
+        ;                                   /* remove from skip list index  */
     } else if ((errcode = dque_mydelete( &gethead( queue ), &node, NOROTATE, &gethcnt( queue ) )) != DQUEERR_NOERR) {
         ;                                   /* NOROTATE to delete from front*/
-    } else if ((errcode = dque_myinsert( &getfree( queue ), node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        *data   = getdata( node );
-	setdata( node, (void *)NULL );      /* set to null for safety       */
+    } else {
+        *data   = getdata( node );          /* get data before freeing node */
+        errcode = dque_myunlink( queue, node );
+    }
+
+    dque_myunlock( queue );
+
+    if (errcode == DQUEERR_NOERR && *data != (void *)NULL) {
+        dque_mynotify( queue, DQUE_WAITPUSH, 1 );   /* wake one waiting push*/
     }
 
     return (errcode);
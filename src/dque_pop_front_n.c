@@ -0,0 +1,87 @@
+/**
+ *
+ *  \file	dque_pop_front_n.c
+ *  \name	dque_pop_front_n
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Remove up to n elements from the front of the queue into an array.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Wake a thread waiting in dque_push_back_wait
+ *  1.2		10/17/2026  	agent       A NULL done returns DQUEERR_INVARG
+ *
+ *      dque_pop_front_n(
+ *      dque_qhead             *queue,         queue to pop from
+ *      void                  **data,          array to hold up to cnt returned data pointers
+ *      unsigned                cnt,           # of data pointers wanted
+ *      unsigned               *done )         returned # of data pointers popped
+ *
+ *	Pop up to cnt elements off the front of the queue into data[0] through
+ *	data[done-1], in order, as calls to dque_pop_front would, stopping early when
+ *	the queue is empty. On a queue from dque_create_spsc every element available
+ *	is taken with one index store. If none could be popped DQUEERR_EMPTY is
+ *	returned and data[0] is set to NULL, otherwise popping fewer than cnt is not
+ *	an error. A NULL done returns DQUEERR_INVARG.
+ *
+ *      \return non-zero for failure, zero for success and the # of data pointers popped
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_pop_front_n(                           /* pop front of queue into array*/
+dque_qhead     *queue,                      /* queue to have data removed   */
+void          **data,                       /* returned data pointers       */
+unsigned int    cnt,                        /* # of data pointers wanted    */
+unsigned int   *done )                      /* returned # removed           */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    unsigned int    i;
+
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (data == (void **)NULL) {     /* invalid data array pointer?  */
+        errcode = DQUEERR_NODATAP;
+    } else if (done == (unsigned *)NULL) {  /* invalid count pointer?       */
+        errcode = DQUEERR_INVARG;
+    } else if (isspsc(queue)) {             /* take slots, one head store   */
+        errcode = dque_myspsc_pop( queue, data, cnt, done );
+        dque_mynotify( queue, DQUE_WAITPUSH, *done );   /* one per free slot*/
+    } else {                                /* one at a time                */
+        for (i = 0; i < cnt; ++i) {
+            if ((errcode = dque_pop_front( queue, &data[i] )) != DQUEERR_NOERR || data[i] == (void *)NULL) {
+                break;                      /* error or queue empty         */
+            }
+        }
+        *done   = i;
+        if (errcode == DQUEERR_EMPTY && i != 0) {
+            errcode = DQUEERR_NOERR;        /* popped some before empty     */
+        } else if (errcode == DQUEERR_NOERR && i == 0 && cnt != 0) {
+            errcode = DQUEERR_EMPTY;        /* nothing to pop               */
+        }
+    }
+
+    return (errcode);
+}
@@ -0,0 +1,97 @@
+/**
+ *
+ *  \file	dque_pop_front_wait.c
+ *  \name	dque_pop_front_wait
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Remove the first qnode from a queue, waiting for one if it is empty.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_pop_front_wait(
+ *      dque_qhead             *queue,         queue to pop from
+ *      void                  **data,          returned pointer to the user's data
+ *      long                    timeout )      milliseconds to wait, DQUE_FOREVER = no limit
+ *
+ *	Pop the front of the queue as dque_pop_front does, but if the queue is empty
+ *	wait up to timeout milliseconds for another thread to push something. The pop
+ *	is retried a few times before the thread sleeps, and each push wakes only one
+ *	sleeping thread, so one element does not wake every consumer. If the queue is
+ *	still empty when the timeout expires DQUEERR_EMPTY is returned and data is NULL.
+ *	A timeout of 0 pops once without waiting, on any queue.
+ *
+ *	Only a queue other threads can push onto may be waited on: one with the
+ *	DQUEOPT_LOCKED option, or from dque_create_mpmc or dque_create_spsc. On any
+ *	other queue, and in a build without pthreads or the __atomic builtins, a
+ *	non-zero timeout returns DQUEERR_NOTSUP.
+ *
+ *      \return non-zero for failure, zero for success and pointer to the user's data
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+/**
+ *  \name 	dque_pop_front_try
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	One pop, with an empty queue always reported as DQUEERR_EMPTY.
+ */
+
+dque_err static                             /* returned completion status   */
+dque_pop_front_try(                         /* internal helper function     */
+dque_qhead     *queue,                      /* queue to have node removed   */
+void           *data )                      /* returned pointer to data     */
+{
+    dque_err        errcode;                /* non-zero indicates failure   */
+
+    errcode = dque_pop_front( queue, (void **)data );
+    if (errcode == DQUEERR_NOERR && *(void **)data == (void *)NULL) {
+        errcode = DQUEERR_EMPTY;            /* a qnode queue was empty      */
+    }
+
+    return (errcode);
+}
+
+dque_err                                    /* returned completion status   */
+dque_pop_front_wait(                        /* remove first qnode, or wait  */
+dque_qhead     *queue,                      /* queue to have node removed   */
+void          **data,                       /* returned pointer to data     */
+long            timeout )                   /* ms to wait, <0 = forever     */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (data == (void **)NULL) {     /* invalid data pointer?        */
+        errcode = DQUEERR_NODATAP;
+    } else if (timeout != 0 && !iswaitable(queue)) {
+        *data   = (void *)NULL;             /* nothing can push meanwhile   */
+        errcode = DQUEERR_NOTSUP;
+    } else {
+        errcode = dque_mywait( queue, DQUE_WAITPOP, timeout, dque_pop_front_try, (void *)data );
+    }
+
+    return (errcode);
+}
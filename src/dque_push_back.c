@@ -9,6 +9,18 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use dque_myget/dque_myput for free list qnodes, keep skip list index
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Added FIFO queue support
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       Added lock-free MPMC queues
+ *  1.2		10/17/2026  	agent       Added wait-free SPSC queues
+ *  1.2		10/17/2026  	agent       Wake a thread waiting in dque_pop_front_wait
+ *  1.2		10/17/2026  	agent       Added work-stealing deques
+ *  1.2		10/17/2026  	agent       Added lock-free priority queues
  *
  *      dque_push_back(
  *      dque_qhead             *queue,         queue with element data
@@ -17,6 +29,7 @@
  * 	This function checks the free list, and if empty, calls as dque_myalloc() to allocate
  * 	more qnodes. The function then removes a qnode from the free list, sets the data
  * 	pointer to the user's data, and then inserts the qnode at the end (back) of the queue.
+ *	A push onto a full lock-free MPMC queue returns DQUEERR_FULL.
  *
  *      \return non-zero for failure, zero for success
  *
@@ -51,21 +64,40 @@ void           *data )                      /* data to insert into queue    */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *node;                   /* pointer to inserted node     */
+    unsigned int    cnt;                    /* # pushed onto an SPSC queue  */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    dque_myrefill( queue );                 /* malloc outside of the lock   */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (void *)NULL) {      /* invalid data pointer?        */
         errcode = DQUEERR_NODATA;
-    } else if (getfree( queue ) == NULL_NODE && ((errcode = dque_myalloc( queue )) != DQUEERR_NOERR)) {
-        ;                   /* no free nodes? try to create more free nodes */
-    } else if ((errcode = dque_mydelete( &getfree( queue ), &node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        setdata( node, data );              /* got node, set the data       */
-    }
-
-    if (errcode == DQUEERR_NOERR) {         /* no error? insert node        */
+    } else if (ismpmc(queue)) {             /* lock-free push onto a cell   */
+        errcode = dque_mympmc_push( queue, data );
+    } else if (isspsc(queue)) {             /* wait-free push onto a slot   */
+        errcode = dque_myspsc_push( queue, &data, 1, &cnt );
+    } else if (issteal(queue)) {            /* owner pushes the front only  */
+        errcode = DQUEERR_NOTSUP;
+    } else if (isprio(queue)) {             /* lock-free push in comp order */
+        errcode = dque_myprio_push( queue, data );
+    } else if (ischunked(queue)) {          /* store data in a chunk slot   */
+        errcode = dque_mychunk_push( queue, data, 1 );
+    } else if (isring(queue)) {             /* store data in a ring slot    */
+        errcode = dque_myring_push( queue, data, 1 );
+    } else if (isfifo(queue)) {             /* link data with an snode      */
+        errcode = dque_myfifo_push( queue, data, 1 );
+    } else if (isxor(queue)) {              /* link data with an XOR snode  */
+        errcode = dque_myxor_push( queue, data, 1 );
+    } else if ((errcode = dque_mylink( queue, data, &node )) == DQUEERR_NOERR) {
         errcode = dque_myinsert( &gethead( queue ), node, NOROTATE, &gethcnt( queue ) );
     }                                       /* NOROTATE to insert at back   */
 
+    dque_myunlock( queue );
+
+    if (errcode == DQUEERR_NOERR) {
+        dque_mynotify( queue, DQUE_WAITPOP, 1 );    /* wake one waiting pop */
+    }
+
     return (errcode);
 }
 
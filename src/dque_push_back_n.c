@@ -0,0 +1,89 @@
+/**
+ *
+ *  \file	dque_push_back_n.c
+ *  \name	dque_push_back_n
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Insert an array of the user's data onto the back of the queue.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Wake a thread waiting in dque_pop_front_wait
+ *  1.2		10/17/2026  	agent       A NULL done returns DQUEERR_INVARG
+ *
+ *      dque_push_back_n(
+ *      dque_qhead             *queue,         queue to push onto
+ *      void                  **data,          array of cnt data pointers to push, in order
+ *      unsigned                cnt,           # of data pointers in the array
+ *      unsigned               *done )         returned # of data pointers pushed
+ *
+ *	Push data[0] through data[cnt-1] onto the back of the queue, as cnt calls to
+ *	dque_push_back would. No pointer may be NULL, otherwise nothing is pushed. On
+ *	a queue from dque_create_spsc the slots are filled and published to the
+ *	consumer with one store, and if the ring has room for fewer than cnt, as many
+ *	as fit are pushed and DQUEERR_FULL is returned. On any other queue the pushes
+ *	stop at the first one that fails and its error is returned. Either way done
+ *	is the number pushed, and the caller may push the rest from data[done] later.
+ *	A NULL done returns DQUEERR_INVARG, since DQUEERR_NODATA means a NULL element.
+ *
+ *      \return non-zero for failure, zero for success and the # of data pointers pushed
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_push_back_n(                           /* push array onto back of queue*/
+dque_qhead     *queue,                      /* queue to have data inserted  */
+void          **data,                       /* data to insert into queue    */
+unsigned int    cnt,                        /* # of data pointers           */
+unsigned int   *done )                      /* returned # inserted          */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    unsigned int    i;
+
+    for (i = 0; data != (void **)NULL && i < cnt && data[i] != (void *)NULL; ++i) {
+        ;                                   /* find any NULL data pointer   */
+    }
+
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (data == (void **)NULL) {     /* invalid data array pointer?  */
+        errcode = DQUEERR_NODATAP;
+    } else if (done == (unsigned *)NULL) {  /* invalid count pointer?       */
+        errcode = DQUEERR_INVARG;
+    } else if (i < cnt) {                   /* NULL data pointer in array?  */
+        *done   = 0;
+        errcode = DQUEERR_NODATA;
+    } else if (isspsc(queue)) {             /* fill slots, one tail store   */
+        errcode = dque_myspsc_push( queue, data, cnt, done );
+        dque_mynotify( queue, DQUE_WAITPOP, *done );    /* one per element  */
+    } else {                                /* one at a time                */
+        for (i = 0; i < cnt && (errcode = dque_push_back( queue, data[i] )) == DQUEERR_NOERR; ++i) {
+            ;
+        }
+        *done   = i;
+    }
+
+    return (errcode);
+}
@@ -0,0 +1,89 @@
+/**
+ *
+ *  \file	dque_push_back_wait.c
+ *  \name	dque_push_back_wait
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Insert the user's data onto the back of a bounded queue, waiting for room if it is full.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_push_back_wait(
+ *      dque_qhead             *queue,         queue to push onto
+ *      void                   *data,          pointer to the user's data
+ *      long                    timeout )      milliseconds to wait, DQUE_FOREVER = no limit
+ *
+ *	Push data onto the back of the queue as dque_push_back does, but if a queue
+ *	from dque_create_mpmc or dque_create_spsc is full wait up to timeout
+ *	milliseconds for another thread to pop something. The push is retried a few
+ *	times before the thread sleeps, and each pop wakes only one sleeping thread.
+ *	If the queue is still full when the timeout expires DQUEERR_FULL is returned.
+ *	Any other error from the push is returned at once, so on a queue that grows
+ *	this is dque_push_back. A timeout of 0 pushes once without waiting, on any queue.
+ *
+ *	A non-zero timeout returns DQUEERR_NOTSUP on a queue without the
+ *	DQUEOPT_LOCKED option that is not from dque_create_mpmc or dque_create_spsc,
+ *	and in a build without pthreads or the __atomic builtins.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+/**
+ *  \name 	dque_push_back_try
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	One push, for dque_mywait.
+ */
+
+dque_err static                             /* returned completion status   */
+dque_push_back_try(                         /* internal helper function     */
+dque_qhead     *queue,                      /* queue to have node inserted  */
+void           *data )                      /* data to insert into queue    */
+{
+    return (dque_push_back( queue, data ));
+}
+
+dque_err                                    /* returned completion status   */
+dque_push_back_wait(                        /* insert at back, or wait      */
+dque_qhead     *queue,                      /* queue to have node inserted  */
+void           *data,                       /* data to insert into queue    */
+long            timeout )                   /* ms to wait, <0 = forever     */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (data == (void *)NULL) {      /* invalid data pointer?        */
+        errcode = DQUEERR_NODATA;
+    } else if (timeout != 0 && !iswaitable(queue)) {
+        errcode = DQUEERR_NOTSUP;           /* nothing can pop meanwhile    */
+    } else {
+        errcode = dque_mywait( queue, DQUE_WAITPUSH, timeout, dque_push_back_try, data );
+    }
+
+    return (errcode);
+}
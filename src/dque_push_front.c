@@ -9,6 +9,17 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Use dque_myget/dque_myput for free list qnodes, keep skip list index
+ *  1.2		10/17/2026  	agent       Use dque_mylink/dque_myunlink, qnode is the user's dque_link in intrusive mode
+ *  1.2		10/17/2026  	agent       Added chunked queue support
+ *  1.2		10/17/2026  	agent       Added ring buffer queue support
+ *  1.2		10/17/2026  	agent       Added FIFO queue support
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       SPSC queues return DQUEERR_NOTSUP
+ *  1.2		10/17/2026  	agent       Wake a thread waiting in dque_pop_front_wait
+ *  1.2		10/17/2026  	agent       Added work-stealing deques
  *
  *      dque_push_back(
  *      dque_qhead             *queue,         queue with element data
@@ -17,6 +28,7 @@
  * 	This function checks the free list, and if empty, calls as dque_myalloc() to allocate
  * 	more qnodes. The function then removes a qnode from the free list, sets the data
  * 	pointer to the user's data, and then inserts the qnode at the front of the queue.
+ *	On a work-stealing deque only its owner thread may push, see dque_create_steal.
  *
  *      \return non-zero for failure, zero for success
  *
@@ -52,20 +64,34 @@ void           *data )                      /* data to insert into queue    */
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
     dque_qnode     *node;                   /* pointer to inserted node     */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    dque_myrefill( queue );                 /* malloc outside of the lock   */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (void *)NULL) {      /* invalid data pointer?        */
         errcode = DQUEERR_NODATA;
-    } else if (getfree( queue ) == NULL_NODE && ((errcode = dque_myalloc( queue )) != DQUEERR_NOERR)) {
-        ;                   /* no free nodes? try to create more free nodes */
-    } else if ((errcode = dque_mydelete( &getfree( queue ), &node, NOROTATE, &getfcnt( queue ) )) == DQUEERR_NOERR) {
-        setdata( node, data );              /* got node, set the data       */
-    }
-
-    if (errcode == DQUEERR_NOERR) {         /* no error? insert node        */
+    } else if (issteal(queue)) {            /* owner pushes onto the bottom */
+        errcode = dque_mysteal_push( queue, data );
+    } else if (islockfree(queue)) {         /* only push_back and pop_front */
+        errcode = DQUEERR_NOTSUP;
+    } else if (ischunked(queue)) {          /* store data in a chunk slot   */
+        errcode = dque_mychunk_push( queue, data, 0 );
+    } else if (isring(queue)) {             /* store data in a ring slot    */
+        errcode = dque_myring_push( queue, data, 0 );
+    } else if (isfifo(queue)) {             /* link data with an snode      */
+        errcode = dque_myfifo_push( queue, data, 0 );
+    } else if (isxor(queue)) {              /* link data with an XOR snode  */
+        errcode = dque_myxor_push( queue, data, 0 );
+    } else if ((errcode = dque_mylink( queue, data, &node )) == DQUEERR_NOERR) {
         errcode = dque_myinsert( &gethead( queue ), node, ROTATE, &gethcnt( queue ) );
     }                                       /* ROTATE to insert at front    */
 
+    dque_myunlock( queue );
+
+    if (errcode == DQUEERR_NOERR) {
+        dque_mynotify( queue, DQUE_WAITPOP, 1 );    /* wake one waiting pop */
+    }
+
     return (errcode);
 }
 
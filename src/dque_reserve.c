@@ -0,0 +1,97 @@
+
+/**
+ *
+ *  \file	dque_reserve.c
+ *  \name	dque_reserve
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Grow the free list to at least the specified number of qnodes.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Grow the ring of a ring buffer queue
+ *  1.2		10/17/2026  	agent       Reserve snodes of a FIFO queue
+ *  1.2		10/17/2026  	agent       Added XOR queue support
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       MPMC queues can not grow
+ *  1.2		10/17/2026  	agent       SPSC queues can not grow
+ *  1.2		10/17/2026  	agent       Grow a work-stealing deque's array
+ *  1.2		10/17/2026  	agent       Reserve spare chunks, NOTSUP on intrusive queues
+ *
+ *      dque_reserve(
+ *      dque_qhead             *queue,         queue to reserve qnodes for
+ *      unsigned int            cnt )          # of free qnodes wanted
+ *
+ *      Make sure at least cnt qnodes are on the free list, so the next cnt pushes
+ *      or inserts will not call malloc. If there are fewer, the difference is
+ *      allocated as one block, which is carved lazily and so is not touched here.
+ *      dque_max_size includes the reserved qnodes. A queue created with
+ *      dque_create_pool reserves qnodes in its pool. Qnodes used by a skip list
+ *      index come from the same free list, and a DQUEOPT_WATERMARK below cnt
+ *      may release reserved qnodes again. A chunked queue keeps spare chunks
+ *      instead, enough for the pushes that take it to cnt elements, without
+ *      counting the free slots of its end chunks. An intrusive queue links the
+ *      user's dque_links and has nothing to reserve, so it returns DQUEERR_NOTSUP.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_reserve(                               /* reserve free qnodes          */
+dque_qhead     *queue,                      /* queue to reserve qnodes for  */
+unsigned int    cnt )                       /* # of free qnodes wanted      */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+    dque_qhead     *pool;                   /* qhead with the free list     */
+
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (issteal(queue)) {            /* owner grows the array        */
+        errcode = dque_mysteal_grow( queue, cnt );
+    } else if (islockfree(queue)) {         /* bounded, can not grow        */
+        errcode = (cnt > getlcap(queue)) ? DQUEERR_ALLOCNA : DQUEERR_NOERR;
+    } else if (isring(queue)) {             /* grow the ring instead        */
+        errcode = dque_myring_grow( queue, cnt );
+    } else if (ischunked(queue)) {          /* spare chunks instead         */
+        errcode = dque_mychunk_reserve( queue, cnt );
+    } else if (getflag(queue, DQUE_INTRUSIVE)) {    /* user owns the links  */
+        errcode = DQUEERR_NOTSUP;
+    } else if (getfcnt( pool = getnodes(queue) ) >= cnt) {
+        ;                                   /* already have enough qnodes   */
+    } else if (cnt - getfcnt( pool ) == UINT_MAX) {
+        errcode = DQUEERR_NOALLOC;          /* no room for block header     */
+    } else if (isfifo(queue) || isxor(queue)) {     /* one block of snodes  */
+        errcode = dque_myfifo_alloc( pool, cnt - getfcnt( pool ) + 1 );
+    } else {                                /* one block, plus its header   */
+        dque_mylockpool( queue, pool );
+        errcode = dque_myalloc( pool, cnt - getfcnt( pool ) + 1 );
+        dque_myunlockpool( queue, pool );
+    }
+    dque_myunlock( queue );
+
+    return (errcode);
+}
@@ -0,0 +1,71 @@
+
+/**
+ *
+ *  \file	dque_shrink_to_fit.c
+ *  \name	dque_shrink_to_fit
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Release allocated blocks whose qnodes are all free.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       Release spare chunks of a chunked queue
+ *
+ *      dque_shrink_to_fit(
+ *      dque_qhead             *queue )        queue to shrink
+ *
+ *      Return every dynamically allocated block whose qnodes are all on the free
+ *      list to the system. Qnodes in use keep their blocks, so a block is only
+ *      released once every qnode in it has been popped or erased. Queues created
+ *      without dynamic allocation have nothing to release. See DQUEOPT_WATERMARK
+ *      to have blocks released automatically as the free list grows. For a queue
+ *      created with dque_create_pool, the blocks of the pool are released. A
+ *      chunked queue releases its spare chunks, including those kept by dque_reserve.
+ *
+ *      \return non-zero for failure, zero for success
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_shrink_to_fit(                         /* release free blocks          */
+dque_qhead     *queue )                     /* queue to shrink              */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (ischunked(queue)) {          /* release the spare chunks     */
+        dque_mylock( queue );
+        dque_mychunk_shrink( queue );
+        dque_myunlock( queue );
+    } else {                                /* release all free blocks      */
+        dque_mylock( getnodes(queue) );     /* DQUEOPT_LOCKED mutex, if any */
+        errcode = dque_myreclaim( getnodes(queue), 0 );
+        dque_myunlock( getnodes(queue) );
+    }
+
+    return (errcode);
+}
@@ -9,6 +9,11 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       Hold the DQUEOPT_LOCKED mutex
+ *  1.2		10/17/2026  	agent       Snapshot of a lock-free MPMC queue
+ *  1.2		10/17/2026  	agent       Added SPSC queue support
+ *  1.2		10/17/2026  	agent       Added work-stealing deques
+ *  1.2		10/17/2026  	agent       Added lock-free priority queues
  *
  *      dque_size(
  *      dque_qhead             *queue,         queue to count nodes
@@ -51,14 +56,25 @@ unsigned int   *data )                      /* ptr to returned data         */
 {                                           /*------------------------------*/
     dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
 
+    dque_mylock( queue );                   /* DQUEOPT_LOCKED mutex, if any */
     if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
         errcode = DQUEERR_NOQUEUE;
     } else if (data == (unsigned *)NULL) {  /* invalid data pointer?        */
         errcode = DQUEERR_NODATA;
+    } else if (ismpmc(queue)) {             /* count when it was looked at  */
+        *data   = dque_mympmc_size( queue );
+    } else if (isspsc(queue)) {
+        *data   = dque_myspsc_size( queue );
+    } else if (issteal(queue)) {
+        *data   = dque_mysteal_size( queue );
+    } else if (isprio(queue)) {
+        *data   = dque_myprio_size( queue );
     } else {                                /* return head queue counts     */
         *data   = gethcnt( queue );
     }
 
+    dque_myunlock( queue );
+
     return (errcode);
 }
 
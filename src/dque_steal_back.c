@@ -0,0 +1,69 @@
+/**
+ *
+ *  \file	dque_steal_back.c
+ *  \name	dque_steal_back
+ *  \author	agent
+ *  \date	10/17/2026
+ *  \brief	Steal the oldest element off the back of a work-stealing deque.
+ *  \version
+ *  Version	Date        	Author      Comment
+ *  1.2		10/17/2026  	agent       original
+ *
+ *      dque_steal_back(
+ *      dque_qhead             *queue,         queue from dque_create_steal
+ *      void                  **data )         returned pointer to the user's data
+ *
+ *	Take the element at the back of a deque from dque_create_steal, the oldest
+ *	one its owner pushed. Any number of threads other than the owner may steal
+ *	at the same time as each other and as the owner's dque_push_front and
+ *	dque_pop_front, without a lock. When two want the same element one gets it
+ *	and the other tries the next, so a steal only fails if the deque is empty,
+ *	then DQUEERR_EMPTY is returned and data is NULL. Any other queue returns
+ *	DQUEERR_NOTSUP, use dque_pop_back there.
+ *
+ *      \return non-zero for failure, zero for success and pointer to the user's data
+ *
+ * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the 'Software'), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>                          /* need NULL definition         */
+#include "mydque.h"
+#include "dque.h"
+
+dque_err                                    /* returned completion status   */
+dque_steal_back(                            /* steal oldest element of deque*/
+dque_qhead     *queue,                      /* queue to steal from          */
+void          **data )                      /* returned pointer to data     */
+{                                           /*------------------------------*/
+    dque_err        errcode = DQUEERR_NOERR;/* non-zero indicates failure   */
+
+    if (queue == NULL_QUEUE) {              /* invalid queue pointer?       */
+        errcode = DQUEERR_NOQUEUE;
+    } else if (data == (void **)NULL) {     /* invalid data pointer?        */
+        errcode = DQUEERR_NODATAP;
+    } else if (!issteal(queue)) {           /* not a work-stealing deque    */
+        *data   = (void *)NULL;
+        errcode = DQUEERR_NOTSUP;
+    } else {
+        errcode = dque_mysteal_take( queue, data );
+    }
+
+    return (errcode);
+}
@@ -8,6 +8,9 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.1		07/30/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       added array-backed binary/d-ary heap priority queue
+ *  1.2		10/17/2026  	agent       added dque_pri_create_alloc for the user's allocator
+ *  1.2		10/17/2026  	agent       define errcode here, thread-local
  *
  *      These routines form wrappers around some of the dque functions.
  *
@@ -33,9 +36,13 @@
 
 #include <stdio.h>                          /* need NULL definition         */
 #include <stdlib.h>                         /* need for malloc              */
+#include <string.h>                         /* need for memcpy              */
+#include <limits.h>                         /* need for UINT_MAX            */
 #include "dque.h"
 #include "dque_util.h"
 
+DQUE_THREAD dque_err errcode = DQUEERR_NOERR;   /* status of last wrapper call */
+
 dque_qiter *
 dque_my_begin( dque_qhead *queue ) {
     dque_qiter     *iter    = NULL_QITER;
@@ -219,23 +226,140 @@ dque_que_size( dque_qhead *queue ) {
     return (val);
 }
 
+/* returns non-zero if heap node a must be popped before heap node b       */
+#define heapless(p,a,b) dque_pri_less( getcomp(p), (a), (b) )
+
+static int
+dque_pri_less( COMPFUNC comp, dque_pri_hnode *a, dque_pri_hnode *b ) {
+    int        val;
+
+    if ((val = (*comp)( a->data, b->data )) == 0) {    /* equal keys pop in FIFO order */
+        val     = (a->pseq < b->pseq) ? -1 : 1;
+    }
+
+    return (val < 0);
+}
+
+/* move the hole at slot i towards the root until node fits, O(log n)      */
+static void
+dque_pri_siftup( dque_pri_qhead *pri, unsigned int i, dque_pri_hnode *node ) {
+    dque_pri_hnode    *heap = getheap(pri);
+    unsigned int       p;
+
+    while (i > 0) {
+        p = (i - 1) / getdary(pri);                     /* parent of slot i             */
+        if (!heapless( pri, node, &heap[p] )) {
+            break;
+        }
+        heap[i] = heap[p];                              /* pull parent down into hole   */
+        i       = p;
+    }
+    heap[i] = *node;
+}
+
+/* move the hole at slot i towards the leaves until node fits, O(d log n)  */
+static void
+dque_pri_siftdown( dque_pri_qhead *pri, unsigned int i, dque_pri_hnode *node ) {
+    dque_pri_hnode    *heap = getheap(pri);
+    unsigned int       c, m, e;
+
+    while ((c = getdary(pri) * i + 1) < getpcnt(pri) && c > i) {
+        e = (getpcnt(pri) - c < getdary(pri)) ? getpcnt(pri) : c + getdary(pri);
+        for (m = c++; c < e; ++c) {                     /* find the smallest child      */
+            if (heapless( pri, &heap[c], &heap[m] )) {
+                m = c;
+            }
+        }
+        if (!heapless( pri, &heap[m], node )) {
+            break;
+        }
+        heap[i] = heap[m];                              /* pull child up into hole      */
+        i       = m;
+    }
+    heap[i] = *node;
+}
+
+static void *
+dque_pri_malloc( DQUEMALLOC amal, void *ctx, size_t siz ) {
+
+    return ((amal == (DQUEMALLOC)NULL) ? malloc( siz ) : amal( ctx, siz ));
+}
+
+static void
+dque_pri_free( DQUEFREE afre, void *ctx, void *ptr, size_t siz ) {
+
+    if (ptr == (void *)NULL) {
+        ;                                               /* nothing to release           */
+    } else if (afre == (DQUEFREE)NULL) {
+        free( ptr );
+    } else {
+        afre( ctx, ptr, siz );
+    }
+}
+
+static dque_pri_hnode *
+dque_pri_grow( dque_pri_qhead *pri ) {                  /* double the heap array        */
+    dque_pri_hnode    *heap;
+    size_t             siz     = (size_t)getpsiz(pri) * sizeof(dque_pri_hnode);
+
+    if (getpmal(pri) == (DQUEMALLOC)NULL) {             /* no user allocator, realloc   */
+        heap = (dque_pri_hnode *)realloc( getheap(pri), 2 * siz );
+    } else if ((heap = (dque_pri_hnode *)getpmal(pri)( getpctx(pri), 2 * siz )) != (dque_pri_hnode *)NULL) {
+        memcpy( heap, getheap(pri), siz );              /* user allocator has no realloc*/
+        getpfre(pri)( getpctx(pri), getheap(pri), siz );
+    }
+
+    return (heap);
+}
+
 dque_err
 dque_pri_create( dque_pri_qheadp *pri_qheadp, COMPFUNC comp ) {
+
+    return (dque_pri_create_heap( pri_qheadp, comp, 0 ));  /* sorted queue           */
+}
+
+dque_err
+dque_pri_create_heap( dque_pri_qheadp *pri_qheadp, COMPFUNC comp, unsigned int dary ) {
+
+    return (dque_pri_create_alloc( pri_qheadp, comp, dary, (DQUEMALLOC)NULL, (DQUEFREE)NULL, (void *)NULL ));
+}
+
+dque_err
+dque_pri_create_alloc( dque_pri_qheadp *pri_qheadp, COMPFUNC comp, unsigned int dary,
+                       DQUEMALLOC amal, DQUEFREE afre, void *ctx ) {
     dque_pri_qhead    *pri;
-    dque_qhead        *queue;
+    dque_qhead        *queue   = NULL_QUEUE;
+    dque_pri_hnode    *heap    = (dque_pri_hnode *)NULL;
 
     if (pri_qheadp == (dque_pri_qheadp *)NULL) {
         errcode = DQUEERR_NOQUEUEP;                     /* no new error codes for now   */
     } else if (comp == (COMPFUNC)NULL) {
         errcode = DQUEERR_NOCOMP;
-    } else if ((errcode = dque_create( &queue, 0, (char *)NULL )) != DQUEERR_NOERR) { /* no static memory allocations */
-        ;
-    } else if ((pri = (dque_pri_qhead *)malloc( sizeof(dque_pri_qhead) )) == (dque_pri_qhead *)NULL) {
-        (void) dque_destroy( &queue );                  /* attempt to clean up the mess */
+    } else if (dary == 1) {                             /* a 1-ary heap is a list       */
+        errcode = DQUEERR_INVARG;
+    } else if ((amal == (DQUEMALLOC)NULL) != (afre == (DQUEFREE)NULL)) {
+        errcode = DQUEERR_INVARG;                       /* need both callbacks or none  */
+    } else if (dary == 0 && (errcode = dque_create_alloc( &queue, amal, afre, ctx )) != DQUEERR_NOERR) {
+        ;                                               /* no static memory allocations */
+    } else if (dary != 0 && (heap = (dque_pri_hnode *)dque_pri_malloc( amal, ctx, DQUE_PRI_HEAPCNT * sizeof(dque_pri_hnode) )) == (dque_pri_hnode *)NULL) {
+        errcode = DQUEERR_NOALLOC;
+    } else if ((pri = (dque_pri_qhead *)dque_pri_malloc( amal, ctx, sizeof(dque_pri_qhead) )) == (dque_pri_qhead *)NULL) {
+        if (queue != NULL_QUEUE) {
+            (void) dque_destroy( &queue );              /* attempt to clean up the mess */
+        }
+        dque_pri_free( afre, ctx, heap, DQUE_PRI_HEAPCNT * sizeof(dque_pri_hnode) );
         errcode = DQUEERR_NOALLOC;
     } else {
         setqueue( pri, queue );
         setcomp(  pri, comp  );
+        setdary(  pri, dary  );
+        setpcnt(  pri, 0     );
+        setpsiz(  pri, (dary != 0) ? DQUE_PRI_HEAPCNT : 0 );
+        setpseq(  pri, 0     );
+        setheap(  pri, heap  );
+        setpmal(  pri, amal  );
+        setpfre(  pri, afre  );
+        setpctx(  pri, ctx   );
        *pri_qheadp = pri;
         errcode    = DQUEERR_NOERR;
     }
@@ -251,20 +375,65 @@ dque_pri_destroy( dque_pri_qheadp *pri_qheadp ) {
         errcode = DQUEERR_NOQUEUEP;                     /* no new error codes for now   */
     } else {
         pri = *pri_qheadp;
-	errcode = dque_destroy( &(getqueue(pri)) );
-        free( pri );                                    /* succeed or fail, we do the same */
+        if (getdary(pri) == 0) {                        /* sorted queue?                */
+	    errcode = dque_destroy( &(getqueue(pri)) );
+        } else {                                        /* no, heap priority queue      */
+            dque_pri_free( getpfre(pri), getpctx(pri), getheap(pri), (size_t)getpsiz(pri) * sizeof(dque_pri_hnode) );
+            errcode = DQUEERR_NOERR;
+        }
+        dque_pri_free( getpfre(pri), getpctx(pri), pri, sizeof(dque_pri_qhead) ); /* succeed or fail, we do the same */
         *pri_qheadp = (dque_pri_qhead *)NULL;
     }
 
     return (errcode);
 }
 
+dque_err
+dque_pri_push( dque_pri_qhead *pri, void *data ) {
+    dque_pri_hnode    *heap;
+    dque_pri_hnode     node;
+
+    if (pri == (dque_pri_qhead *)NULL) {
+        errcode = DQUEERR_NOQUEUE;
+    } else if (getdary(pri) == 0) {                     /* sorted queue, O(n) insert    */
+        errcode = dque_key_insert( getqueue(pri), (void *)NULL, getcomp(pri), data );
+    } else if (data == (void *)NULL) {
+        errcode = DQUEERR_NODATA;
+    } else if (getpcnt(pri) == getpsiz(pri) && getpsiz(pri) > UINT_MAX/2) {
+        errcode = DQUEERR_NOALLOC;                      /* cannot double the heap again */
+    } else if (getpcnt(pri) == getpsiz(pri) && (heap = dque_pri_grow( pri )) == (dque_pri_hnode *)NULL) {
+        errcode = DQUEERR_NOALLOC;                      /* heap full and cannot grow    */
+    } else {
+        if (getpcnt(pri) == getpsiz(pri)) {             /* heap grew, save new array    */
+            setheap( pri, heap );
+            setpsiz( pri, 2 * getpsiz(pri) );
+        }
+        node.data = data;
+        node.pseq = getpseq(pri)++;
+        dque_pri_siftup( pri, getpcnt(pri)++, &node );
+        errcode = DQUEERR_NOERR;
+    }
+
+    return (errcode);
+}
+
 void *
 dque_pri_pop( dque_pri_qhead *pri ) {
     void      *data;
 
-    if ((errcode = dque_pop_front( getqueue(pri), &data )) != DQUEERR_NOERR) {
+    if (getdary(pri) == 0) {                            /* sorted queue?                */
+        if ((errcode = dque_pop_front( getqueue(pri), &data )) != DQUEERR_NOERR) {
+            data    = (void *)NULL;
+        }
+    } else if (getpcnt(pri) == 0) {                     /* empty heap, no data          */
         data    = (void *)NULL;
+        errcode = DQUEERR_NOERR;
+    } else {                                            /* take root, refill from last  */
+        data    = getheap(pri)[0].data;
+        if (--getpcnt(pri) != 0) {
+            dque_pri_siftdown( pri, 0, &getheap(pri)[getpcnt(pri)] );
+        }
+        errcode = DQUEERR_NOERR;
     }
 
     return (data);
@@ -274,8 +443,13 @@ void *
 dque_pri_top( dque_pri_qhead *pri ) {
     void      *data;
 
-    if ((errcode = dque_front( getqueue(pri), &data )) != DQUEERR_NOERR) {
-        data    = (void *)NULL;
+    if (getdary(pri) == 0) {                            /* sorted queue?                */
+        if ((errcode = dque_front( getqueue(pri), &data )) != DQUEERR_NOERR) {
+            data    = (void *)NULL;
+        }
+    } else {                                            /* heap root is the top         */
+        data    = (getpcnt(pri) == 0) ? (void *)NULL : getheap(pri)[0].data;
+        errcode = DQUEERR_NOERR;
     }
 
     return (data);
@@ -285,7 +459,10 @@ int
 dque_pri_empty( dque_pri_qhead *pri ) {
     unsigned int val;
 
-    if ((errcode = dque_empty( getqueue(pri), &val )) != DQUEERR_NOERR) {
+    if (getdary(pri) != 0) {                            /* heap priority queue?         */
+        val     = (getpcnt(pri) == 0) ? 1 : 0;
+        errcode = DQUEERR_NOERR;
+    } else if ((errcode = dque_empty( getqueue(pri), &val )) != DQUEERR_NOERR) {
         val     = -1;
     }
 
@@ -296,11 +473,12 @@ int
 dque_pri_size( dque_pri_qhead *pri ) {
     unsigned int val;
 
-    if ((errcode = dque_size( getqueue(pri), &val )) != DQUEERR_NOERR) {
+    if (getdary(pri) != 0) {                            /* heap priority queue?         */
+        val     = getpcnt(pri);
+        errcode = DQUEERR_NOERR;
+    } else if ((errcode = dque_size( getqueue(pri), &val )) != DQUEERR_NOERR) {
         val     = -1;
     }
 
     return (val);
 }
-
-
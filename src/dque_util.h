@@ -8,9 +8,26 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.1		07/30/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       added array-backed binary/d-ary heap priority queue
+ *  1.2		10/17/2026  	agent       added dque_pri_create_alloc for the user's allocator
+ *  1.2		10/17/2026  	agent       errcode is defined in dque_util.c, one per thread
  *
  *      These routines form wrappers around some of the dque functions.
  *
+ *      The priority queue (pri_*) normally keeps its elements in a sorted dque, which
+ *      makes each push O(n). A priority queue created by dque_pri_create_heap with an
+ *      arity of two or more keeps its elements in an implicit d-ary heap instead, so
+ *      push and pop are O(log n). Elements with equal keys are still popped in the
+ *      order they were pushed. Duplicate detection (DQUEOPT_NODUPE) is only available
+ *      on the sorted queue, and getqueue() of a heap priority queue is a NULL queue.
+ *      dque_pri_create_alloc takes the user's allocator callbacks as well, see
+ *      dque_create_alloc, and uses them for the qhead, the heap array, and the queue.
+ *
+ *      Each wrapper leaves the completion status of the dque call it made in errcode.
+ *      errcode is thread-local where the compiler supports it, DQUE_THREAD, so
+ *      threads using the wrappers on their own queues neither see each other's status
+ *      nor share its cache line. Without thread-local storage it is one global.
+ *
  * Copyright (c) 2019 Dale Anderson <daleanderson488@gmail.com>
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
@@ -36,10 +53,26 @@
 
 #include "dque.h"
 
+#define DQUE_PRI_HEAPCNT    64              /* initial # of heap slots      */
+
+typedef struct dque_pri_hnode
+    {
+    void               *data;               /* pointer to user's data       */
+    unsigned long       pseq;               /* push order for equal keys    */
+    } dque_pri_hnode;
+
 typedef struct dque_pri_qhead
     {
     dque_qhead         *queue;              /* pointer to real queue        */
     COMPFUNC            comp;               /* user's comparison function   */
+    unsigned int        dary;               /* heap arity, 0 = sorted queue */
+    unsigned int        pcnt;               /* # of elements in the heap    */
+    unsigned int        psiz;               /* # of slots allocated in heap */
+    unsigned long       pseq;               /* next push sequence number    */
+    dque_pri_hnode     *heap;               /* implicit d-ary heap array    */
+    DQUEMALLOC          amal;               /* user's malloc, NULL = malloc */
+    DQUEFREE            afre;               /* user's free, NULL = free     */
+    void               *actx;               /* context for amal and afre    */
     } dque_pri_qhead, *dque_pri_qheadp, **dque_pri_qheadpp;
 
 #define getqueue(h)     (h)->queue
@@ -48,7 +81,41 @@ typedef struct dque_pri_qhead
 #define getcomp(h)      (h)->comp
 #define setcomp(h,c)    getcomp(h)=(c)
 
-extern dque_err errcode;
+#define getdary(h)      (h)->dary
+#define setdary(h,d)    getdary(h)=(d)
+
+#define getpcnt(h)      (h)->pcnt
+#define setpcnt(h,c)    getpcnt(h)=(c)
+
+#define getpsiz(h)      (h)->psiz
+#define setpsiz(h,c)    getpsiz(h)=(c)
+
+#define getpseq(h)      (h)->pseq
+#define setpseq(h,c)    getpseq(h)=(c)
+
+#define getheap(h)      (h)->heap
+#define setheap(h,p)    getheap(h)=(p)
+
+#define getpmal(h)      (h)->amal
+#define setpmal(h,p)    getpmal(h)=(p)
+
+#define getpfre(h)      (h)->afre
+#define setpfre(h,p)    getpfre(h)=(p)
+
+#define getpctx(h)      (h)->actx
+#define setpctx(h,p)    getpctx(h)=(p)
+
+/* completion status of the last wrapper call on this thread               */
+#if defined(__GNUC__)
+#define DQUE_THREAD     __thread
+#elif defined(_MSC_VER)
+#define DQUE_THREAD     __declspec(thread)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define DQUE_THREAD     _Thread_local
+#else
+#define DQUE_THREAD                         /* one global errcode           */
+#endif
+extern DQUE_THREAD dque_err errcode;
 
 extern dque_qiter *dque_my_begin(  dque_qhead *queue                     );
 extern dque_qiter *dque_my_end(    dque_qhead *queue                     );
@@ -70,6 +137,9 @@ extern int         dque_que_empty( dque_qhead *queue                     );
 extern int         dque_que_size(  dque_qhead *queue                     );
 
 extern dque_err    dque_pri_create( dque_pri_qheadp *pri, COMPFUNC comp  );
+extern dque_err    dque_pri_create_heap( dque_pri_qheadp *pri, COMPFUNC comp, unsigned int dary );
+extern dque_err    dque_pri_create_alloc( dque_pri_qheadp *pri, COMPFUNC comp, unsigned int dary,
+                                          DQUEMALLOC amal, DQUEFREE afre, void *ctx );
 extern dque_err    dque_pri_destroy(dque_pri_qheadp *pri                 );
 extern dque_err    dque_pri_push(   dque_pri_qhead  *pri, void *data     );
 extern void       *dque_pri_pop(    dque_pri_qhead  *pri                 );
@@ -138,12 +208,18 @@ extern int         dque_pri_size(   dque_pri_qhead  *pri                 );
     #define pri_create(X,b)     _Generic ((X),                            \
 				        dque_pri_qheadpp: dque_pri_create \
 				        ) (X,b)
+    #define pri_create_heap(X,b,c) _Generic ((X),                         \
+				        dque_pri_qheadpp: dque_pri_create_heap \
+				        ) (X,b,c)
+    #define pri_create_alloc(X,b,c,d,e,f) _Generic ((X),                  \
+				        dque_pri_qheadpp: dque_pri_create_alloc \
+				        ) (X,b,c,d,e,f)
     #define pri_destroy(X)      _Generic ((X),                            \
 				        dque_pri_qheadpp: dque_pri_destroy\
 				        ) (X)
     #define pri_push(X,b)       _Generic ((X),                            \
-				        dque_pri_qheadp: dque_key_insert  \
-				        ) (getqueue(X),(void*)NULL,getcomp(X),b)
+				        dque_pri_qheadp: dque_pri_push    \
+				        ) (X,b)
     #define pri_pop(X)          _Generic ((X),                            \
 				        dque_pri_qheadp: dque_pri_pop     \
 				        ) (X)
@@ -190,8 +266,10 @@ extern int         dque_pri_size(   dque_pri_qhead  *pri                 );
       #define que_size(a)       dque_que_size(a)
 
       #define pri_create(a,b)   dque_pri_create(a,b)
+      #define pri_create_heap(a,b,c) dque_pri_create_heap(a,b,c)
+      #define pri_create_alloc(a,b,c,d,e,f) dque_pri_create_alloc(a,b,c,d,e,f)
       #define pri_destroy(a)    dque_pri_destroy(a)
-      #define pri_push(a,b)     dque_key_insert(getqueue(a),(void*)NULL,getcomp(a),b)
+      #define pri_push(a,b)     dque_pri_push(a,b)
       #define pri_pop(a)        dque_pri_pop(a)
       #define pri_top(a)        dque_pri_top(a)
       #define pri_empty(a)      dque_pri_empty(a)
@@ -7,6 +7,22 @@
  *  \version
  *  Version	Date        	Author      Comment
  *  1.0		07/11/2019  	D.Anderson  original
+ *  1.2		10/17/2026  	agent       added skip list index, dque_myget and dque_myput,
+ *                                          added allocator callbacks, dque_mymalloc and dque_myfree,
+ *                                          added mmap node arenas, dque_myarena and dque_myunarena,
+ *                                          added DQUE_COMPACT 16 byte qnodes with 32-bit links,
+ *                                          added intrusive queues, dque_mylink and dque_myunlink,
+ *                                          added chunked queues, dque_mychunk_*,
+ *                                          added ring buffer queues, dque_myring_*,
+ *                                          added inline qnodes in the qhead,
+ *                                          added singly-linked FIFO queues, dque_myfifo_* and dque_myslot_*,
+ *                                          added XOR-linked queues, dque_myxor_*,
+ *                                          added DQUEOPT_LOCKED, dque_mylockset and dque_myrefill,
+ *                                          added lock-free bounded MPMC queues, dque_mympmc_*,
+ *                                          added wait-free SPSC queues, dque_myspsc_*,
+ *                                          added blocking waits, dque_mywaitset, dque_mywake and dque_mywait,
+ *                                          added Chase-Lev work-stealing deques, dque_mysteal_*,
+ *                                          added lock-free priority queues, dque_myprio_*
  *
  *  	This header file is for internal use only and should not be used by the user.
  *  	The user should only use the dque.h file which is all they need to use the
@@ -41,21 +57,238 @@
 #define MYDQUE_H
 
 #include <limits.h>                         /* need for UINT_MAX            */
+#include <stddef.h>                         /* need for size_t              */
 
 /* global defines, some may be changed through dque_options()               */
-#define DQUE_VERSION   0x00010001           /* version 1.1                  */
+#define DQUE_VERSION   0x00010002           /* version 1.2                  */
 #define DQUE_NODECNT   25                   /* default allocation node count*/
 #define DQUE_MINCNT    2                    /* minimum node allocation count*/
+#define DQUE_INLINECNT 4                    /* # of qnodes inline in qhead  */
+#define DQUE_SKIPMAX   16                   /* maximum # of skip list levels*/
+#define DQUE_SKIPSEED  0x2545F491           /* skip list random level seed  */
+#define DQUE_HUGEPAGE  (2UL<<20)            /* arena rounding for hugepages */
+#define DQUE_CACHELINE 64                   /* bytes apart to avoid false sharing */
+#define DQUE_PRIOSLOT  16                   /* stripes of a priority queue's epoch counts */
+
+/* mmap is used for node arenas and DQUE_COMPACT blocks where available     */
+#if defined(__unix__) || defined(__APPLE__)
+#define DQUE_MMAP
+#endif
+
+/* DQUEOPT_LOCKED puts a pthread mutex in the qhead. Compile the library   */
+/* with -DDQUE_NOLOCK where there are no pthreads, the option then returns  */
+/* DQUEERR_NOTSUP.                                                          */
+#ifndef DQUE_NOLOCK
+#include <pthread.h>                        /* need for pthread_mutex_t     */
+#define DQUE_LOCK
+#endif
+
+/* lock-free queues use the GCC/Clang __atomic builtins, which work in any  */
+/* -std mode, without them dque_create_mpmc and dque_create_spsc return     */
+/* DQUEERR_NOTSUP.                                                          */
+#if defined(__GNUC__) && !defined(DQUE_NOATOMIC)
+#define DQUE_ATOMIC
+#define dque_myload(p)      __atomic_load_n(  (p), __ATOMIC_ACQUIRE )
+#define dque_mypeek(p)      __atomic_load_n(  (p), __ATOMIC_RELAXED )
+#define dque_mystore(p,v)   __atomic_store_n( (p), (v), __ATOMIC_RELEASE )
+#define dque_mycas(p,e,v)   __atomic_compare_exchange_n( (p), (e), (v), 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED )
+#endif
+
+/* dque_pop_front_wait and dque_push_back_wait park on condition variables  */
+/* in the qhead, which needs both pthreads and the __atomic builtins for    */
+/* the waiter counts that pushes and pops peek at without the mutex.        */
+#if defined(DQUE_LOCK) && defined(DQUE_ATOMIC)
+#define DQUE_WAIT
+#include <time.h>                           /* need struct timespec         */
+#endif
+#define DQUE_SPINCNT   64                   /* tries before a wait parks    */
+#define DQUE_WAITPOP   0                    /* pop waiters, need data       */
+#define DQUE_WAITPUSH  1                    /* push waiters, need room      */
+
+/* Compile the library with -DDQUE_COMPACT for 16 byte qnodes. The next and */
+/* prev links are 32-bit offsets, counted in qnodes, from the qnode holding */
+/* them, so all the qnode memory of a queue (or its pool) must fit within   */
+/* a window of DQUE_SPAN qnodes, 32GB, see dque_mywindow. There is no room  */
+/* for the owner, so DQUE_OWNER is ignored. The qhead is padded to a whole */
+/* number of qnodes so the qnodes after it in a static buffer are aligned.  */
+#ifdef DQUE_COMPACT
+#include <stdint.h>                         /* need for int32_t, intptr_t   */
+#define DQUE_NULLOFF   INT32_MIN            /* offset of a NULL link        */
+#define DQUE_SPAN      INT32_MAX            /* max qnodes between two qnodes*/
+#undef  DQUE_OWNER
+#endif
+
+/* Compile the library with -DDQUE_OWNER for 32 byte qnodes that point to   */
+/* the queue holding them, so dque_mysearch checks an iterator given to     */
+/* dque_insert or dque_erase in O(1) instead of scanning the queue, O(n).   */
+/* Without it qnodes are 24 bytes.                                          */
+
+/* this definition is same as dque.h, define allows for future changes      */
+typedef int (* COMPFUNC)( void *, void * );
+#define COMFUNC_DEF                         /* cause dque.h to use this definition */
+
+/* these definitions are same as dque.h, user's allocator callbacks         */
+typedef void *(* DQUEMALLOC)( void *, size_t );
+typedef void  (* DQUEFREE)(   void *, void *, size_t );
+#define DQUEALLOC_DEF                       /* cause dque.h to use these definitions */
 
 /* this is THE real DQUE structions, try to contain yourself                */
+#ifdef DQUE_COMPACT
+typedef struct dque_qnode
+    {
+    int32_t             next;               /* # of qnodes to next qnode    */
+    int32_t             prev;               /* # of qnodes to prev qnode    */
+    void               *data;
+    } dque_qnode, *dque_qnodep;
+#else
 typedef struct dque_qnode
     {
     struct dque_qnode  *next;
     struct dque_qnode  *prev;
     void               *data;
+#ifdef DQUE_OWNER
+    struct dque_qhead  *owner;              /* queue holding node, NULL=free*/
+#endif
     } dque_qnode, *dque_qnodep;
+#endif
 #define DQUE_QNODE_DEF                      /* cause dque.h to use this qnode */
 
+#define dque_link   dque_qnode              /* user's embedded qnode        */
+#define DQUE_LINK_DEF                       /* cause dque.h to use this link*/
+
+/* a chunked queue keeps data pointers in slot[lo] up to slot[hi-1], the  */
+/* chunk is allocated with kslt slots                                       */
+typedef struct dque_chunk
+    {
+    struct dque_chunk  *next;               /* next chunk toward the back   */
+    struct dque_chunk  *prev;               /* prev chunk toward the front  */
+    unsigned int        lo;                 /* first used slot              */
+    unsigned int        hi;                 /* past last used slot          */
+    void               *slot[1];            /* kslt data pointers           */
+    } dque_chunk;
+
+/* an MPMC queue keeps its data in a ring of cells, each with a sequence   */
+/* number saying whose turn the cell is, see dque_mympmc.c. The push and pop */
+/* positions are written by every thread, so each has a cache line of its   */
+/* own, and the cells follow them.                                          */
+typedef struct dque_cell
+    {
+    size_t              seq;                /* position cell is ready for   */
+    void               *data;
+    } dque_cell;
+
+typedef struct dque_mpmc
+    {
+    size_t              enq;                /* next position to push        */
+    char                epad[DQUE_CACHELINE - sizeof(size_t)];
+    size_t              deq;                /* next position to pop         */
+    char                dpad[DQUE_CACHELINE - sizeof(size_t)];
+    dque_cell           cell[1];            /* lcap cells                   */
+    } dque_mpmc;
+
+/* an SPSC queue keeps its data in a ring of slots. The producer owns tail */
+/* and the consumer owns head, and each keeps a copy of the other's index   */
+/* on its own cache line, so it only reads the other's line when the copy   */
+/* says the ring is full or empty, see dque_myspsc.c.                        */
+typedef struct dque_spsc
+    {
+    size_t              tail;               /* next position to push        */
+    size_t              hcpy;               /* producer's copy of head      */
+    char                tpad[DQUE_CACHELINE - 2 * sizeof(size_t)];
+    size_t              head;               /* next position to pop         */
+    size_t              tcpy;               /* consumer's copy of tail      */
+    char                hpad[DQUE_CACHELINE - 2 * sizeof(size_t)];
+    void               *slot[1];            /* lcap slots                   */
+    } dque_spsc;
+
+/* a work-stealing deque's circular array, replaced by one twice the size  */
+/* when full. Thieves may still be reading a replaced array, so it is kept  */
+/* on the prev list until the queue is destroyed.                           */
+typedef struct dque_sarr
+    {
+    size_t              cap;                /* # of slots, power of 2       */
+    struct dque_sarr   *prev;               /* array this one replaced      */
+    void               *slot[1];            /* cap slots                    */
+    } dque_sarr;
+
+/* a Chase-Lev work-stealing deque: the owner pushes and pops at bottom,    */
+/* thieves steal at top, top <= bottom. Thieves write only top, so it has   */
+/* a cache line of its own.                                                 */
+typedef struct dque_steal
+    {
+    size_t              top;                /* next position to steal       */
+    char                tpad[DQUE_CACHELINE - sizeof(size_t)];
+    size_t              bottom;             /* next position to push        */
+    dque_sarr          *arr;                /* current circular array       */
+    char                bpad[DQUE_CACHELINE - sizeof(size_t) - sizeof(dque_sarr *)];
+    dque_sarr           first;              /* array in the qhead's block   */
+    } dque_steal;
+
+/* a lock-free priority queue keeps its data in a skip list of pnodes, in  */
+/* comp order, ties in push order. The low bit of a next link marks the     */
+/* pnode as being unlinked at that level, see dque_myprio.c. A pnode is     */
+/* allocated with only plvl links.                                          */
+typedef struct dque_pnode
+    {
+    void               *data;
+    size_t              pseq;               /* push order, breaks ties      */
+    size_t              pgen;               /* epoch it was retired in      */
+    struct dque_pnode  *pfre;               /* next retired pnode           */
+    unsigned int        ptak;               /* non-zero once popped         */
+    unsigned int        plvl;               /* # of links in next           */
+    struct dque_pnode  *next[DQUE_SKIPMAX]; /* next pnode at each level     */
+    } dque_pnode;
+
+/* a thread counts itself in one stripe of the epoch counts while it is in */
+/* the skip list, and retires the pnodes it pops onto that stripe's lists.  */
+/* Each stripe has a cache line of its own.                                 */
+typedef struct dque_pslot
+    {
+    size_t              actv[3];            /* # of threads in epoch % 3    */
+    dque_pnode         *pfre[3];            /* pnodes retired in epoch % 3  */
+    char                spad[DQUE_CACHELINE - 3 * sizeof(size_t) - 3 * sizeof(dque_pnode *)];
+    } dque_pslot;
+
+typedef struct dque_prio
+    {
+    size_t              pgen;               /* current epoch                */
+    COMPFUNC            comp;               /* user's comparison function   */
+    char                gpad[DQUE_CACHELINE - sizeof(size_t) - sizeof(COMPFUNC)];
+    size_t              pseq;               /* next push order              */
+    char                qpad[DQUE_CACHELINE - sizeof(size_t)];
+    dque_pslot          slot[DQUE_PRIOSLOT];
+    dque_pnode          head;               /* sentinel, DQUE_SKIPMAX links */
+    } dque_prio;
+
+/* DQUEOPT_LOCKED mutex, and the waiters of a LOCKED or lock-free queue.    */
+/* A waiter never holds wmtx while it calls into the queue, it notes wgen,  */
+/* tries, then sleeps only if no push or pop has bumped wgen since.         */
+#ifdef DQUE_LOCK
+typedef struct dque_lock
+    {
+    pthread_mutex_t     mutx;               /* DQUEOPT_LOCKED queue mutex   */
+#ifdef DQUE_WAIT
+    pthread_mutex_t     wmtx;               /* guards the condition variables */
+    pthread_cond_t      cond[2];            /* DQUE_WAITPOP, DQUE_WAITPUSH  */
+    unsigned int        wcnt[2];            /* # of threads waiting on each */
+    unsigned int        wgen[2];            /* bumped on each push, or pop  */
+#endif
+    } dque_lock;
+#define DQUE_LOCKPAD   ((sizeof(dque_lock) + sizeof(dque_qnode) - 1) / sizeof(dque_qnode))
+#endif
+#ifdef DQUE_WAIT
+#define DQUE_LOCKLEN   sizeof(dque_lock)    /* lock-free queues always wait */
+#else
+#define DQUE_LOCKLEN   0
+#endif
+
+/* a FIFO queue links its data with snodes, forward links only            */
+typedef struct dque_snode
+    {
+    struct dque_snode  *next;               /* next snode toward the back   */
+    void               *data;
+    } dque_snode;
+
 #define dque_qiter  dque_qnode
 #define dque_qiterp dque_qnodep
 #define DQUE_QITER_DEF                      /* cause dque.h to use this qiter */
@@ -71,18 +304,70 @@ typedef struct dque_qhead
     unsigned int        fcnt;               /* # of nodes in free list      */ 
     unsigned int        bcnt;               /* # of nodes in blks list      */ 
     unsigned int        acnt;               /* # of nodes to allocate       */
+    unsigned int        ncnt;               /* DQUEOPT_NODECNT node count   */
+    unsigned int        gcap;               /* geometric growth cap, 0=fixed*/
+    unsigned int        wmhi;               /* free node high watermark, 0=off */
+    unsigned int        wmlo;               /* free node low watermark      */
+    unsigned int        wtrg;               /* free count to trigger reclaim*/
+    unsigned int        qcnt;               /* # of queues using this pool  */
+    unsigned int        ccnt;               /* # of qnodes not yet carved   */
+    unsigned int        ioff;               /* offset of dque_link in data  */
+    struct dque_qhead  *pool;               /* shared node pool, NULL = own */
+    dque_qnode         *carv;               /* next qnode not yet carved    */
+    dque_qnode         *skip;               /* ptr to top skip list sentinel*/
+    COMPFUNC            scmp;               /* skip list comparison function*/
+    unsigned int        slvl;               /* # of skip list index levels  */
+    unsigned int        sran;               /* skip list random level state */
+    DQUEMALLOC          amal;               /* user's malloc, NULL = malloc */
+    DQUEFREE            afre;               /* user's free, NULL = free     */
+    void               *actx;               /* context for amal and afre    */
+    void               *aren;               /* mmap'd node arena, NULL = none */
+    size_t              alen;               /* # of bytes mapped for arena  */
+    union {                                 /* only the backend's own state */
+    struct {                                /* DQUE_CHUNKED                 */
+    dque_chunk         *khead;              /* first chunk, NULL = none     */
+    dque_chunk         *ktail;              /* last chunk                   */
+    dque_chunk         *kspr;               /* spare empty chunks           */
+    dque_chunk         *kcur;               /* chunk last iterated through  */
+    unsigned int        kslt;               /* # of slots in each chunk     */
+    unsigned int        kcnt;               /* # of chunks allocated        */
+    } k;
+    struct {                                /* DQUE_RING                    */
+    void              **rbuf;               /* ring buffer, NULL = none     */
+    unsigned int        rcap;               /* # of ring slots, power of 2  */
+    unsigned int        rhed;               /* ring slot of first element   */
+    } r;
+    struct {                                /* DQUE_FIFO and DQUE_XOR       */
+    dque_snode         *shed;               /* first snode of FIFO queue    */
+    dque_snode         *stal;               /* last snode of FIFO queue     */
+    dque_snode         *sfre;               /* free snodes                  */
+    dque_snode         *sblk;               /* snode blocks, first is header*/
+    dque_snode         *xcur;               /* XOR snode last iterated to   */
+    dque_snode         *xprv;               /* snode before xcur            */
+    } s;
+    struct {                                /* DQUE_MPMC, SPSC, STEAL, PRIO */
+    void               *lbuf;               /* lock-free positions and cells*/
+    size_t              lcap;               /* # of lock-free cells, power of 2 */
+    } l;
+    } u;
+#ifdef DQUE_LOCK
+    dque_lock          *lock;               /* mutex and waiters, NULL=none */
+#endif
+#ifdef DQUE_COMPACT
+    dque_qnode         *nlo;                /* lowest qnode address in use  */
+    dque_qnode         *nhi;                /* past highest qnode address   */
+    void               *npad;               /* qhead is a whole # of qnodes */
+#endif
     } dque_qhead, *dque_qheadp;
 #define DQUE_QHEAD_DEF                      /* cause dque.h to use this qhead */
 
-/* this definition is same as dque.h, define allows for future changes      */
-typedef int (* COMPFUNC)( void *, void * );
-#define COMFUNC_DEF                         /* cause dque.h to use this definition */
-
 #define NULL_NODE       (dque_qnode  *)NULL /* NULL qnode pointer           */
 #define NULL_NODEP      (dque_qnodep *)NULL /* NULL qnode pointer pointer   */
 #define NULL_QUEUE      (dque_qhead  *)NULL /* NULL queue pointer           */
 #define NULL_QUEUEP     (dque_qheadp *)NULL /* NULL queue pointer pointer   */
 #define NULL_QITER      (dque_qiter  *)NULL /* NULL iterator pointer        */
+#define NULL_CHUNK      (dque_chunk  *)NULL /* NULL chunk pointer           */
+#define NULL_SNODE      (dque_snode  *)NULL /* NULL snode pointer           */
 #define NULL_QITERP     (dque_qiterp *)NULL /* NULL iterator pointer pointer*/
 
 /* flags */
@@ -93,6 +378,27 @@ typedef int (* COMPFUNC)( void *, void * );
 #define DQUE_NOALLOC    0x00000001          /* no dynamic allocation        */
 #define DQUE_NODUPE     0x00000002          /* no duplication in priority queue */
 #define DQUE_NOSCAN     0x00000004          /* no scan on insert, remove    */
+#define DQUE_SKIPLIST   0x00000008          /* skip list index over queue   */
+#define DQUE_POOL       0x00000010          /* qhead is a shared node pool  */
+#define DQUE_INTRUSIVE  0x00000020          /* qnodes are user's dque_links */
+#define DQUE_CHUNKED    0x00000040          /* data kept in chunks, no qnodes */
+#define DQUE_RING       0x00000080          /* data kept in a ring, no qnodes */
+#define DQUE_FIFO       0x00000100          /* data linked forward by snodes*/
+#define DQUE_XOR        0x00000200          /* data linked by XOR of snodes */
+#define DQUE_LOCKED     0x00000400          /* calls hold the qhead's mutex */
+#define DQUE_MPMC       0x00000800          /* lock-free bounded MPMC ring  */
+#define DQUE_SPSC       0x00001000          /* wait-free bounded SPSC ring  */
+#define DQUE_CONDVAR    0x00002000          /* qhead has waiters' condvars  */
+#define DQUE_STEAL      0x00004000          /* Chase-Lev work-stealing deque*/
+#define DQUE_PRIO       0x00008000          /* lock-free skip list priority */
+#define DQUE_INLINE     0x00010000          /* qhead followed by inline qnodes */
+
+#define DQUE_CHUNKCNT   256                 /* default # of slots per chunk */
+#define DQUE_RINGCNT    16                  /* default # of slots in a ring */
+#define DQUE_MPMCCNT    1024                /* default # of MPMC cells      */
+#define DQUE_SPSCCNT    1024                /* default # of SPSC slots      */
+#define DQUE_STEALCNT   256                 /* initial # of stealing slots  */
+#define DQUE_PRIOFREE   32                  /* pops between epoch advances  */
 
 /* use these macros to increment/decrement counters to prevent wrap around  */
 #define dec_uns(i)      ((i)-=((i)>0?1:0))
@@ -104,6 +410,30 @@ typedef int (* COMPFUNC)( void *, void * );
                                             /*  or before deletion          */
 
 /* macros to access structures because rule #1 is never access them directly*/
+#ifdef DQUE_COMPACT
+#define dque_myoff(n,p) (((p) == NULL_NODE) ? DQUE_NULLOFF : \
+                        (int32_t)(((intptr_t)(p) - (intptr_t)(n)) / (intptr_t)sizeof(dque_qnode)))
+#define dque_myptr(n,o) (((o) == DQUE_NULLOFF) ? NULL_NODE : \
+                        (dque_qnode *)((intptr_t)(n) + (intptr_t)(o) * (intptr_t)sizeof(dque_qnode)))
+
+#define getnext(n)      dque_myptr(n,(n)->next)
+#define setnext(n,p)    ((n)->next=dque_myoff(n,p))
+
+#define getprev(n)      dque_myptr(n,(n)->prev)
+#define setprev(n,p)    ((n)->prev=dque_myoff(n,p))
+
+#define getdata(n)      (n)->data
+#define setdata(n,x)    getdata(n)=(x)
+
+#define getowner(n)     NULL_QUEUE          /* no owner in a compact qnode  */
+#define setowner(n,q)   ((void)0)
+
+#define getnlo(a)       ((a)->nlo)
+#define setnlo(a,p)     getnlo(a)=(p)
+
+#define getnhi(a)       ((a)->nhi)
+#define setnhi(a,p)     getnhi(a)=(p)
+#else
 #define getnext(n)      (n)->next
 #define setnext(n,p)    getnext(n)=(p)
 
@@ -113,6 +443,18 @@ typedef int (* COMPFUNC)( void *, void * );
 #define getdata(n)      (n)->data
 #define setdata(n,x)    getdata(n)=(x)
 
+#ifdef DQUE_OWNER
+#define getowner(n)     (n)->owner
+#define setowner(n,q)   getowner(n)=(q)
+#else
+#define getowner(n)     NULL_QUEUE          /* no owner without DQUE_OWNER  */
+#define setowner(n,q)   ((void)0)
+#endif
+
+/* without DQUE_COMPACT any qnode memory can be linked with any other       */
+#define dque_mywindow(q,a,c)    DQUEERR_NOERR
+#endif
+
 #define getvers(a)      ((a)->vers)
 #define setvers(a,p)    getvers(a)=(p)
 
@@ -130,6 +472,40 @@ typedef int (* COMPFUNC)( void *, void * );
 
 #define getacnt(a)      ((a)->acnt)
 #define setacnt(a,p)    getacnt(a)=(p)
+#define getncnt(a)      ((a)->ncnt)
+#define setncnt(a,p)    getncnt(a)=(p)
+
+#define getgcap(a)      ((a)->gcap)
+#define setgcap(a,p)    getgcap(a)=(p)
+
+#define getwmhi(a)      ((a)->wmhi)
+#define setwmhi(a,p)    getwmhi(a)=(p)
+
+#define getwmlo(a)      ((a)->wmlo)
+#define setwmlo(a,p)    getwmlo(a)=(p)
+
+#define getwtrg(a)      ((a)->wtrg)
+#define setwtrg(a,p)    getwtrg(a)=(p)
+
+#define getpool(a)      ((a)->pool)
+#define setpool(a,p)    getpool(a)=(p)
+
+#define getqcnt(a)      ((a)->qcnt)
+#define setqcnt(a,p)    getqcnt(a)=(p)
+
+#define getcarv(a)      ((a)->carv)
+#define setcarv(a,p)    getcarv(a)=(p)
+
+#define getccnt(a)      ((a)->ccnt)
+#define setccnt(a,p)    getccnt(a)=(p)
+
+/* qhead holding the free and blks lists used by a queue, its pool if any   */
+#define getnodes(a)     ((getpool(a) != NULL_QUEUE) ? getpool(a) : (a))
+
+/* the first qnode of each allocated block is its header on the blks list,  */
+/* its data pointer points just past the last qnode in the block            */
+#define getbend(b)      ((dque_qnode *)getdata(b))
+#define setbend(b,p)    setdata(b,(void *)(p))
 
 #define gethead(a)      ((a)->head)
 #define sethead(a,p)    gethead(a)=(p)
@@ -140,6 +516,159 @@ typedef int (* COMPFUNC)( void *, void * );
 #define getblks(a)      ((a)->blks)
 #define setblks(a,p)    getblks(a)=(p)
 
+#define getskip(a)      ((a)->skip)
+#define setskip(a,p)    getskip(a)=(p)
+
+#define getscmp(a)      ((a)->scmp)
+#define setscmp(a,p)    getscmp(a)=(p)
+
+#define getslvl(a)      ((a)->slvl)
+#define setslvl(a,p)    getslvl(a)=(p)
+
+#define getsran(a)      ((a)->sran)
+#define setsran(a,p)    getsran(a)=(p)
+
+#define getamal(a)      ((a)->amal)
+#define setamal(a,p)    getamal(a)=(p)
+
+#define getafre(a)      ((a)->afre)
+#define setafre(a,p)    getafre(a)=(p)
+
+#define getactx(a)      ((a)->actx)
+#define setactx(a,p)    getactx(a)=(p)
+
+#define getaren(a)      ((a)->aren)
+#define setaren(a,p)    getaren(a)=(p)
+
+#define getalen(a)      ((a)->alen)
+#define setalen(a,p)    getalen(a)=(p)
+
+#define getioff(a)      ((a)->ioff)
+#define setioff(a,p)    getioff(a)=(p)
+
+#define getkhead(a)     ((a)->u.k.khead)
+#define setkhead(a,p)   getkhead(a)=(p)
+
+#define getktail(a)     ((a)->u.k.ktail)
+#define setktail(a,p)   getktail(a)=(p)
+
+#define getkspr(a)      ((a)->u.k.kspr)
+#define setkspr(a,p)    getkspr(a)=(p)
+
+#define getkcur(a)      ((a)->u.k.kcur)
+#define setkcur(a,p)    getkcur(a)=(p)
+
+#define getkslt(a)      ((a)->u.k.kslt)
+#define setkslt(a,p)    getkslt(a)=(p)
+
+#define getkcnt(a)      ((a)->u.k.kcnt)
+#define setkcnt(a,p)    getkcnt(a)=(p)
+
+/* an iterator into a chunked, ring, FIFO, or XOR queue is its slot, so   */
+/* getdata reads it                                                         */
+#define slot2iter(s)    ((dque_qiter *)((char *)(s) - offsetof(dque_qnode, data)))
+#define iter2slot(i)    (&getdata(i))
+#define ischunked(q)    getflag(q,DQUE_CHUNKED)
+
+#define getrbuf(a)      ((a)->u.r.rbuf)
+#define setrbuf(a,p)    getrbuf(a)=(p)
+
+#define getrcap(a)      ((a)->u.r.rcap)
+#define setrcap(a,p)    getrcap(a)=(p)
+
+#define getrhed(a)      ((a)->u.r.rhed)
+#define setrhed(a,p)    getrhed(a)=(p)
+
+#define isring(q)       getflag(q,DQUE_RING)
+
+/* a dynamic list queue's inline qnodes follow its qhead, DQUE_INLINE     */
+#define getinln(a)      ((dque_qnode *)((a) + 1))
+#define DQUE_HEADLEN(q) (sizeof(dque_qhead) + (getflag(q,DQUE_INLINE) ? DQUE_INLINECNT * sizeof(dque_qnode) : 0))
+
+#define getshed(a)      ((a)->u.s.shed)
+#define setshed(a,p)    getshed(a)=(p)
+
+#define getstal(a)      ((a)->u.s.stal)
+#define setstal(a,p)    getstal(a)=(p)
+
+#define getsfre(a)      ((a)->u.s.sfre)
+#define setsfre(a,p)    getsfre(a)=(p)
+
+#define getsblk(a)      ((a)->u.s.sblk)
+#define setsblk(a,p)    getsblk(a)=(p)
+
+#define getxcur(a)      ((a)->u.s.xcur)
+#define setxcur(a,p)    getxcur(a)=(p)
+
+#define getxprv(a)      ((a)->u.s.xprv)
+#define setxprv(a,p)    getxprv(a)=(p)
+
+#define isfifo(q)       getflag(q,DQUE_FIFO)
+#define isxor(q)        getflag(q,DQUE_XOR)
+#define isslots(q)      getflag(q,DQUE_CHUNKED|DQUE_RING|DQUE_FIFO|DQUE_XOR)
+
+#define getlbuf(a)      ((a)->u.l.lbuf)
+#define setlbuf(a,p)    getlbuf(a)=(void *)(p)
+
+#define getlcap(a)      ((a)->u.l.lcap)
+#define setlcap(a,p)    getlcap(a)=(p)
+
+#define getmpmc(a)      ((dque_mpmc *)getlbuf(a))
+#define getspsc(a)      ((dque_spsc *)getlbuf(a))
+#define getsteal(a)     ((dque_steal *)getlbuf(a))
+#define getprio(a)      ((dque_prio *)getlbuf(a))
+
+#define ismpmc(q)       getflag(q,DQUE_MPMC)
+#define isspsc(q)       getflag(q,DQUE_SPSC)
+#define issteal(q)      getflag(q,DQUE_STEAL)
+#define isprio(q)       getflag(q,DQUE_PRIO)
+#define islockfree(q)   getflag(q,DQUE_MPMC|DQUE_SPSC|DQUE_STEAL|DQUE_PRIO)
+
+/* bytes for a qhead, its lock and c MPMC cells, with room to align them   */
+#define DQUE_MPMCLEN(c) (sizeof(dque_qhead) + DQUE_LOCKLEN + DQUE_CACHELINE - 1 + offsetof(dque_mpmc, cell) + (size_t)(c) * sizeof(dque_cell))
+#define DQUE_SPSCLEN(c) (sizeof(dque_qhead) + DQUE_LOCKLEN + DQUE_CACHELINE - 1 + offsetof(dque_spsc, slot) + (size_t)(c) * sizeof(void *))
+#define DQUE_STEALLEN(c) (sizeof(dque_qhead) + DQUE_LOCKLEN + DQUE_CACHELINE - 1 + offsetof(dque_steal, first.slot) + (size_t)(c) * sizeof(void *))
+#define DQUE_PRIOLEN    (sizeof(dque_qhead) + DQUE_LOCKLEN + DQUE_CACHELINE - 1 + sizeof(dque_prio))
+
+/* DQUEOPT_LOCKED: a public call holds the queue's mutex while it changes   */
+/* the queue, and a queue using a pool also holds the pool's mutex while it */
+/* changes the pool's free list. The queue's lock is always taken first.    */
+#define islocked(q)     ((q) != NULL_QUEUE && getflag(q,DQUE_LOCKED))
+#ifdef DQUE_LOCK
+#define getlckp(a)      ((a)->lock)
+#define setlckp(a,p)    getlckp(a)=(p)
+#define getlock(a)      (getlckp(a)->mutx)
+#define dque_mylock(q)      (islocked(q) ? (void)pthread_mutex_lock(   &getlock(q) ) : (void)0)
+#define dque_myunlock(q)    (islocked(q) ? (void)pthread_mutex_unlock( &getlock(q) ) : (void)0)
+#else
+#define dque_mylock(q)      ((void)0)
+#define dque_myunlock(q)    ((void)0)
+#endif
+#ifdef DQUE_WAIT
+#define getwait(a)      (*getlckp(a))
+#define iswaitable(q)   getflag(q,DQUE_CONDVAR)
+/* wake up to n threads waiting on side s, after n pushes or n pops        */
+#define dque_mynotify(q,s,n)    (iswaitable(q) ? dque_mywake( (q), (s), (n) ) : (void)0)
+#else
+#define iswaitable(q)   0
+#define dque_mynotify(q,s,n)    ((void)0)
+#endif
+/* lock the pool too, when the free list is not the queue's own             */
+#define dque_mylockpool(q,p)    ((p) != (q) ? dque_mylock(p)   : (void)0)
+#define dque_myunlockpool(q,p)  ((p) != (q) ? dque_myunlock(p) : (void)0)
+
+/* skip list index entries are qnodes off the free list: next is the entry  */
+/* to the right on the same level, prev is the entry one level down, and    */
+/* data is the queue qnode being indexed. Level sentinels have NULL data.   */
+#define getdown(n)      getprev(n)
+#define setdown(n,p)    setprev(n,p)
+
+#define getring(n)      ((dque_qnode *)getdata(n))
+#define setring(n,p)    setdata(n,(void *)(p))
+
+/* use the skip list index for a key_* call made with comparison function c */
+#define useskip(q,c)    (getflag(q,DQUE_SKIPLIST) && getscmp(q) == (c))
+
 /* list error codes for those function that return error codes              */
 typedef enum dque_err {
         DQUEERR_NOERR       =  0,   /* no error                             */
@@ -162,17 +691,102 @@ typedef enum dque_err {
         DQUEERR_NODUPE      = 17,   /* no duplicates in priority queue      */
         DQUEERR_INVITER     = 18,   /* invalid iterator to deleted node     */
         DQUEERR_NOBUF       = 19,   /* no pointer to buffer                 */
-        DQUEERR_INVHDR      = 20    /* invalid header                       */
+        DQUEERR_INVHDR      = 20,   /* invalid header                       */
+        DQUEERR_INVARG      = 21,   /* invalid options argument             */
+        DQUEERR_INUSE       = 22,   /* node pool still used by queues       */
+        DQUEERR_NOTSUP      = 23,   /* not supported on this platform       */
+        DQUEERR_RANGE       = 24,   /* qnode memory outside compact window  */
+        DQUEERR_LINKED      = 25,   /* dque_link already on a queue         */
+        DQUEERR_FULL        = 26    /* bounded queue is full                */
 	} dque_err;                 /* other error codes go here            */
 #define DQUE_ERR_DEF                /* cause dque.h to use this enum        */
 
 /* internal function definitions                                            */
-extern dque_err dque_myalloc(    dque_qhead  *                                     );
+extern dque_err dque_myalloc(    dque_qhead  *, unsigned int                       );
+extern dque_err dque_myaddblk(   dque_qhead  *, dque_qnode *,  unsigned int        );
+extern void     dque_myrefill(   dque_qhead  *                                     );
+extern dque_err dque_mylockset(  dque_qhead  *, int                                );
+extern dque_err dque_mywaitset(  dque_qhead  *, int                                );
+extern dque_err dque_mylockmem(  dque_qhead  *, int                                );
+extern void     dque_mywake(     dque_qhead  *, int,           unsigned int        );
+extern dque_err dque_mywait(     dque_qhead  *, int,           long, dque_err (*)( dque_qhead *, void * ), void * );
 extern dque_err dque_myinsert(   dque_qnodep *, dque_qnode *,  int, unsigned int * );
 extern dque_err dque_mydelete(   dque_qnodep *, dque_qnode **, int, unsigned int * );
 extern dque_err dque_mypopulate( dque_qhead  *, unsigned int,  dque_qnode *        );
 extern dque_err dque_myfind(     dque_qnodep *, void *, COMPFUNC, dque_qnode **    );
 extern dque_err dque_myscan(     dque_qnodep *, void *, COMPFUNC, dque_qnode **    );
-extern dque_err dque_mysearch(   dque_qnodep *, dque_qiter *                       );
+extern dque_err dque_mysearch(   dque_qhead  *, dque_qiter *                       );
+extern dque_err dque_myget(      dque_qhead  *, dque_qnode **                      );
+extern dque_err dque_myput(      dque_qhead  *, dque_qnode *                       );
+extern dque_err dque_myskip(     dque_qhead  *, void *, COMPFUNC, int, dque_qnode **, dque_qnode ** );
+extern dque_err dque_myindex(    dque_qhead  *, dque_qnode *,  dque_qnode **       );
+extern dque_err dque_myunindex(  dque_qhead  *, dque_qnode *                       );
+extern dque_err dque_myskipset(  dque_qhead  *, COMPFUNC                           );
+extern dque_err dque_myreclaim(  dque_qhead  *, unsigned int                       );
+extern void    *dque_mymalloc(   dque_qhead  *, size_t                             );
+extern void     dque_myfree(     dque_qhead  *, void *,        size_t              );
+extern dque_err dque_myarena(    dque_qhead  *, unsigned int,  unsigned int        );
+extern void     dque_myunarena(  dque_qhead  *                                     );
+extern dque_err dque_mylink(     dque_qhead  *, void *,        dque_qnode **       );
+extern dque_err dque_myunlink(   dque_qhead  *, dque_qnode *                       );
+extern dque_err dque_mychunk_push(   dque_qhead *, void *,   int                );
+extern dque_err dque_mychunk_pop(    dque_qhead *, void **,  int                );
+extern void   **dque_mychunk_end(    dque_qhead *, int                          );
+extern dque_chunk *dque_mychunk_find( dque_qhead *, void **                     );
+extern dque_err dque_mychunk_step(   dque_qhead *, void ***, int                );
+extern dque_err dque_mychunk_insert( dque_qhead *, void *,   void **            );
+extern dque_err dque_mychunk_erase(  dque_qhead *, void **,  void **            );
+extern void   **dque_mychunk_scan(   dque_qhead *, void *,   COMPFUNC, int      );
+extern dque_err dque_mychunk_reserve( dque_qhead *, unsigned int                 );
+extern void     dque_mychunk_shrink( dque_qhead *                               );
+extern void     dque_mychunk_destroy( dque_qhead *                              );
+extern dque_err dque_myring_grow(    dque_qhead *, unsigned int                 );
+extern dque_err dque_myring_push(    dque_qhead *, void *,   int                );
+extern dque_err dque_myring_pop(     dque_qhead *, void **,  int                );
+extern void   **dque_myring_end(     dque_qhead *, int                          );
+extern dque_err dque_myring_step(    dque_qhead *, void ***, int                );
+extern void   **dque_myring_scan(    dque_qhead *, void *,   COMPFUNC           );
+extern void     dque_myring_destroy( dque_qhead *                               );
+extern dque_err dque_myfifo_alloc(   dque_qhead *, unsigned int                 );
+extern dque_snode *dque_myfifo_get( dque_qhead *                               );
+extern void     dque_myfifo_put(     dque_qhead *, dque_snode *                 );
+extern dque_err dque_myfifo_push(    dque_qhead *, void *,   int                );
+extern dque_err dque_myfifo_pop(     dque_qhead *, void **                      );
+extern void   **dque_myfifo_end(     dque_qhead *, int                          );
+extern void   **dque_myfifo_step(    void **                                    );
+extern void   **dque_myfifo_scan(    dque_qhead *, void *,   COMPFUNC           );
+extern void     dque_myfifo_destroy( dque_qhead *                               );
+extern dque_err dque_myxor_push(     dque_qhead *, void *,   int                );
+extern dque_err dque_myxor_pop(      dque_qhead *, void **,  int                );
+extern void   **dque_myxor_end(      dque_qhead *, int                          );
+extern dque_err dque_myxor_step(     dque_qhead *, void ***, int                );
+extern void   **dque_myxor_scan(     dque_qhead *, void *,   COMPFUNC           );
+extern dque_err dque_mympmc_init(    dque_qhead *, char *,   size_t             );
+extern dque_err dque_mympmc_push(    dque_qhead *, void *                       );
+extern dque_err dque_mympmc_pop(     dque_qhead *, void **                      );
+extern unsigned int dque_mympmc_size( dque_qhead *                              );
+extern dque_err dque_myspsc_init(    dque_qhead *, char *,   size_t             );
+extern dque_err dque_myspsc_push(    dque_qhead *, void **,  unsigned int, unsigned int * );
+extern dque_err dque_myspsc_pop(     dque_qhead *, void **,  unsigned int, unsigned int * );
+extern unsigned int dque_myspsc_size( dque_qhead *                              );
+extern dque_err dque_mysteal_init(   dque_qhead *, char *,   size_t             );
+extern dque_err dque_mysteal_grow(   dque_qhead *, size_t                       );
+extern dque_err dque_mysteal_push(   dque_qhead *, void *                       );
+extern dque_err dque_mysteal_pop(    dque_qhead *, void **                      );
+extern dque_err dque_mysteal_take(   dque_qhead *, void **                      );
+extern unsigned int dque_mysteal_size( dque_qhead *                             );
+extern void     dque_mysteal_destroy( dque_qhead *                              );
+extern dque_err dque_myprio_init(    dque_qhead *, char *,   size_t             );
+extern dque_err dque_myprio_push(    dque_qhead *, void *                       );
+extern dque_err dque_myprio_pop(     dque_qhead *, void **                      );
+extern unsigned int dque_myprio_size( dque_qhead *                              );
+extern void     dque_myprio_destroy( dque_qhead *                               );
+extern void   **dque_myslot_end(     dque_qhead *, int                          );
+extern dque_err dque_myslot_step(    dque_qhead *, void ***, int                );
+extern void    *dque_myblkalloc( dque_qhead  *, size_t                             );
+extern void     dque_myblkfree(  dque_qhead  *, void *,        size_t              );
+#ifdef DQUE_COMPACT
+extern dque_err dque_mywindow(   dque_qhead  *, dque_qnode *,  unsigned int        );
+#endif
 
 #endif /* MYLIST_H */
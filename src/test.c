@@ -32,21 +32,38 @@
 #include <stdlib.h>                         /* need for malloc and free     */
 #include <string.h>                         /* need for strcmp              */
 #include <time.h>
+#ifndef DQUE_NOLOCK
+#include <pthread.h>                        /* need for DQUEOPT_LOCKED test */
+#endif
 #include "dque.h"
 #include "dque_util.h"
 
-dque_err errcode = DQUEERR_NOERR;
 unsigned status;
 
 void     myprintf( dque_qhead *queue, int typ       );
 void     myrprintf(dque_qhead *queue, int typ       );
+dque_err myorder(  dque_qhead *queue, unsigned int cnt );
 dque_err prtest(   char *name,   dque_err expcode, dque_err errcode );
 int      intcomp(  void *i1,     void *i2      );
 int      intrcomp( void *i1,     void *i2      );
+void    *cntmalloc( void *ctx,   size_t siz    );
+void     cntfree(  void *ctx,    void *ptr, size_t siz );
+void    *lockworker( void *queue       );
+void    *mpmcworker( void *queue       );
+void    *spscworker( void *queue       );
+void    *waitworker( void *queue       );
+void    *stealworker( void *queue      );
+void    *prioworker( void *queue       );
+void    *errworker(  void *arg        );
+
+struct cntalloc { size_t bytes; unsigned int calls; } cntctx;   /* counting allocator */
+struct job { int val; dque_link link; } jobs[10];                 /* intrusive queue objects */
 
-char    buf[128], bfr[128], bfr2[128], buff[128];
+char    buf[1024], bfr[1024], bfr2[1024], buff[256];
+char    bigbuf[1<<20];
 int    array[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
 int   array3[] = { 6, 2, 4, 1, 9, 3, 0, 8, 4, 0 };
+int   array5[1000];
 char *array2[] = { "zero", "one", "two", "three", "four" };
 char *name = "Sara West";
 
@@ -110,10 +127,12 @@ char  **argv )
 {
     dque_qhead *queue;
     dque_qhead *queue2 = NULL_QUEUE;
+    dque_qhead *queue3;
+    dque_pool  *pool;
     dque_pri_qhead *pri;
     int   *val,  val2;
     int   major, minor;
-    unsigned int headsize, nodesize, uns;
+    unsigned int headsize, nodesize, uns, uns2, inl;
     dque_qiter *iter   = NULL_QITER;
     dque_qiter *iter2  = NULL_QITER;
     void  *data, *data2;
@@ -137,7 +156,7 @@ char  **argv )
     (void) printf( "\n------------------------------\ntesting invalid create() and destroy() function calls\n" );
     prtest( "dque_create (invalid ptr to ptr to queue)",DQUEERR_NOQUEUEP, create(  NULL_QUEUEP,            0, (char *)NULL ) );
     prtest( "dque_create (invalid buffer size)",        DQUEERR_BUFSIZE,  create(  &queue,        headsize-1, (char *)NULL ) );
-    prtest( "dque_create (invalid pointer to buffer)",  DQUEERR_NOBUF,    create(  &queue,               128, (char *)NULL ) );
+    prtest( "dque_create (invalid pointer to buffer)",  DQUEERR_NOBUF,    create(  &queue,          headsize, (char *)NULL ) );
     prtest( "dque_create (invalid node count)",         DQUEERR_MINCNT,   create(  &queue, headsize+nodesize, buf          ) );
     prtest( "dque_destroy(invalid ptr to ptr to queue)",DQUEERR_NOQUEUEP, destroy( NULL_QUEUEP                             ) );
     prtest( "dque_destroy(invalid pointer to queue)",   DQUEERR_NOQUEUE,  destroy( &queue2                                 ) );
@@ -148,6 +167,7 @@ char  **argv )
     prtest( "dque_push_back",                        DQUEERR_NOERR,   push_back( queue, &array[1]                       ) );
     prtest( "dque_push_back (no allocation allowed)",DQUEERR_ALLOCNA, push_back( queue, &array[2]                       ) );
     prtest( "dque_options (DQUEOPT_NOALLOC)",        DQUEERR_NOERR,   options(   queue, DQUEOPT_NOALLOC, 128, bfr2      ) );
+    prtest( "dque_options (SKIPLIST, static memory)", DQUEERR_NOTSUP, options(   queue, DQUEOPT_SKIPLIST, intcomp       ) );
     prtest( "dque_push_back",                        DQUEERR_NOERR,   push_back( queue, &array[2]                       ) );
     prtest( "dque_destroy (using static memory)",    DQUEERR_NOERR,   destroy(  &queue                                  ) );
 
@@ -304,6 +324,10 @@ char  **argv )
     prtest( "dque_rbegin",                              DQUEERR_NOERR,     rbegin(  queue,              &iter ) );
     prtest( "dque_delete",                              DQUEERR_NOERR,     delete(  queue,   &data,      iter ) );
     prtest( "dque_delete data == ninth node",           DQUEERR_NOERR, (*(int *)data == array[9]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    (void) printf( "\nerased iterator is no longer in the queue\n" );
+    prtest( "dque_delete (erased iterator)",            DQUEERR_NOERR,     delete(  queue,   &data,      iter ) );
+    prtest( "dque_delete data == NULL",                 DQUEERR_NOERR, (data == (void *)NULL) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_insert (erased iterator)",            DQUEERR_NOTFOUND,   insert( queue,   &array[9],  iter ) );
     myprintf(  queue, 1 );
     myrprintf( queue, 1 );
 
@@ -342,6 +366,217 @@ char  **argv )
     prtest( "dque_key_insert (with duplicate key)", DQUEERR_NODUPE, key_insert( queue, (void *)NULL, intcomp, &array3[9] ) );
     prtest( "dque_destroy (using dynamic memory)",  DQUEERR_NOERR,    destroy( &queue                                    ) );
 
+    (void) printf( "\n------------------------------\nturn on skip list index, fill queue with 1000 random order integer elements\n" );
+    prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
+    prtest( "dque_options (DQUEOPT_SKIPLIST)",      DQUEERR_NOERR,    options( queue, DQUEOPT_SKIPLIST, intcomp          ) );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        array5[i] = (i * 389) % 500;        /* each value appears twice */
+        if (!prtest( "dque_key_insert",             DQUEERR_NOERR,    key_insert( queue, (void *)NULL, intcomp, &array5[i] ) ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_key_insert (queue in order)",     DQUEERR_NOERR,    myorder( queue, 1000 )                               );
+    val2 = 250;
+    if (prtest( "dque_key_find (skip list)",        DQUEERR_NOERR,    key_find( queue, &val2, intcomp, &iter )             ) ) {
+        prtest( "dque_key_find data == 250",        DQUEERR_NOERR, (*(int *)my_data(iter) != 250) ? DQUEERR_UNKERR : DQUEERR_NOERR );
+    }
+    val2 = 0;                               /* first of the two zeros is array5[0] */
+    if (prtest( "dque_key_find (skip list, FIFO)",  DQUEERR_NOERR,    key_find( queue, &val2, intcomp, &iter )             ) ) {
+        prtest( "dque_key_find data == array5[0]",  DQUEERR_NOERR, (my_data(iter) != &array5[0]) ? DQUEERR_UNKERR : DQUEERR_NOERR );
+    }
+    val2 = 600;
+    prtest( "dque_key_find (skip list, no key)",    DQUEERR_NOTFOUND, key_find( queue, &val2, intcomp, &iter )             );
+    (void) printf( "\nremove one of each pair of integer elements using key_erase\n" );
+    for (val2 = 0; val2 < 500; ++val2) {
+        if (!prtest( "dque_key_erase",              DQUEERR_NOERR,    key_erase( queue, &val2, intcomp, &data )            ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_key_erase (queue in order)",      DQUEERR_NOERR,    myorder( queue, 500 )                                );
+    if (prtest( "dque_pop_front",                   DQUEERR_NOERR,    pop_front( queue, &data )                            ) ) {
+        prtest( "dque_pop_front data == 0",         DQUEERR_NOERR, (*(int *)data != 0) ? DQUEERR_UNKERR : DQUEERR_NOERR );
+    }
+    if (prtest( "dque_pop_back",                    DQUEERR_NOERR,    pop_back( queue, &data )                             ) ) {
+        prtest( "dque_pop_back data == 499",        DQUEERR_NOERR, (*(int *)data != 499) ? DQUEERR_UNKERR : DQUEERR_NOERR );
+    }
+    val2 = 1;
+    prtest( "dque_key_erase (first qnode)",         DQUEERR_NOERR,    key_erase( queue, &val2, intcomp, &data )            );
+    prtest( "dque_key_find (erased key)",           DQUEERR_NOTFOUND, key_find( queue, &val2, intcomp, &iter )             );
+    prtest( "dque_options (DQUEOPT_SKIPLIST off)",  DQUEERR_NOERR,    options( queue, DQUEOPT_SKIPLIST, (COMPFUNC)NULL     ) );
+    val2 = 300;
+    prtest( "dque_key_find (no skip list)",         DQUEERR_NOERR,    key_find( queue, &val2, intcomp, &iter )             );
+    prtest( "dque_options (rebuild DQUEOPT_SKIPLIST)", DQUEERR_NOERR, options( queue, DQUEOPT_SKIPLIST, intcomp          ) );
+    if (prtest( "dque_key_find (rebuilt skip list)",DQUEERR_NOERR,    key_find( queue, &val2, intcomp, &iter )             ) ) {
+        prtest( "dque_erase (skip list)",           DQUEERR_NOERR,    erase( queue, &data, iter )                          );
+    }
+    prtest( "dque_key_find (erased key)",           DQUEERR_NOTFOUND, key_find( queue, &val2, intcomp, &iter )             );
+    prtest( "dque_key_insert (queue in order)",     DQUEERR_NOERR,    myorder( queue, 496 )                                );
+    (void) printf( "\nerased qnodes reused as skip list index entries are not in the queue\n" );
+    prtest( "dque_options (DQUEOPT_SKIPLIST off)",  DQUEERR_NOERR,    options( queue, DQUEOPT_SKIPLIST, (COMPFUNC)NULL     ) );
+    val2 = 100;
+    prtest( "dque_key_find (no skip list)",         DQUEERR_NOERR,    key_find( queue, &val2, intcomp, &iter )             );
+    prtest( "dque_erase",                           DQUEERR_NOERR,    erase( queue, &data, iter )                          );
+    val2 = 200;
+    prtest( "dque_key_find (no skip list)",         DQUEERR_NOERR,    key_find( queue, &val2, intcomp, &iter2 )            );
+    prtest( "dque_erase",                           DQUEERR_NOERR,    erase( queue, &data, iter2 )                         );
+    prtest( "dque_options (rebuild DQUEOPT_SKIPLIST)", DQUEERR_NOERR, options( queue, DQUEOPT_SKIPLIST, intcomp          ) );
+    prtest( "dque_insert (iterator is index entry)", DQUEERR_NOTFOUND, insert( queue, &val2, iter )                        );
+    prtest( "dque_insert (iterator is sentinel)",   DQUEERR_NOTFOUND, insert( queue, &val2, iter2 )                        );
+    prtest( "dque_erase (iterator is index entry)", DQUEERR_NOERR,    erase( queue, &data, iter )                          );
+    prtest( "dque_erase data == NULL",              DQUEERR_NOERR, (data == (void *)NULL) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_key_insert (queue in order)",     DQUEERR_NOERR,    myorder( queue, 494 )                                );
+    prtest( "dque_destroy (using dynamic memory)",  DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\ngeometric growth, push 1000 integer elements doubling allocations up to 256 nodes\n" );
+    prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
+    prtest( "dque_max_size (inline nodes)",         DQUEERR_NOERR,    max_size( queue, &inl )                              );
+    prtest( "dque_options (DQUEOPT_GROWGEO < min)", DQUEERR_MINCNT,   options( queue, DQUEOPT_GROWGEO, 1                 ) );
+    prtest( "dque_options (DQUEOPT_GROWGEO)",       DQUEERR_NOERR,    options( queue, DQUEOPT_GROWGEO, 256               ) );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    if (prtest( "dque_max_size",                    DQUEERR_NOERR,    max_size( queue, &uns )                              ) ) {
+        (void) printf( "max_size: %u\n", uns );    /* inline nodes, blocks of 25, 50, 100, 200, 256, 256, 256 nodes */
+        prtest( "dque_max_size == 1136 + inline nodes", DQUEERR_NOERR, (uns == 1136 + inl) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    prtest( "dque_options (DQUEOPT_GROWFIX)",       DQUEERR_NOERR,    dque_options( queue, DQUEOPT_GROWFIX               ) );
+    (void) printf( "\nkeep ten integer elements, release the rest of the blocks with shrink_to_fit\n" );
+    for (i = 10; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_pop_back",               DQUEERR_NOERR,    pop_back( queue, &data )                             ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_shrink_to_fit (invalid queue)",   DQUEERR_NOQUEUE,  shrink_to_fit( NULL_QUEUE )                          );
+    prtest( "dque_shrink_to_fit",                   DQUEERR_NOERR,    shrink_to_fit( queue )                               );
+    if (prtest( "dque_max_size",                    DQUEERR_NOERR,    max_size( queue, &uns )                              ) ) {
+        (void) printf( "max_size: %u\n", uns );    /* only the inline nodes and first block of 25 are left */
+        prtest( "dque_max_size == 24 + inline nodes", DQUEERR_NOERR, (uns == 24 + inl) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    for (i = 0; i < 10; ++i) {
+        if (!prtest( "dque_pop_front",              DQUEERR_NOERR,    pop_front( queue, &data )                            ) ) {
+	    break;
+        }
+        prtest( "dque_pop_front data in order",     DQUEERR_NOERR, (data == &array5[i]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    prtest( "dque_shrink_to_fit (empty queue)",     DQUEERR_NOERR,    shrink_to_fit( queue )                               );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == inline nodes",        DQUEERR_NOERR, (uns == inl) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i <= inl; ++i) {            /* one block past the inline    */
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    if (prtest( "dque_max_size",                    DQUEERR_NOERR,    max_size( queue, &uns )                              ) ) {
+        (void) printf( "max_size: %u\n", uns );    /* GROWFIX is back to blocks of 25 nodes, not 256 */
+        prtest( "dque_max_size == 24 + inline nodes", DQUEERR_NOERR, (uns == 24 + inl) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    for (i = 0; i <= inl; ++i) {
+        if (!prtest( "dque_pop_front",              DQUEERR_NOERR,    pop_front( queue, &data )                            ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_shrink_to_fit (empty queue)",     DQUEERR_NOERR,    shrink_to_fit( queue )                               );
+
+    (void) printf( "\nfree node watermarks, push then pop 1000 integer elements\n" );
+    prtest( "dque_options (DQUEOPT_WATERMARK lo >= hi)", DQUEERR_INVARG, options( queue, DQUEOPT_WATERMARK, 100, 100     ) );
+    prtest( "dque_options (DQUEOPT_NODECNT)",       DQUEERR_NOERR,    options( queue, DQUEOPT_NODECNT, 25                ) );
+    prtest( "dque_options (DQUEOPT_WATERMARK)",     DQUEERR_NOERR,    options( queue, DQUEOPT_WATERMARK, 100, 50         ) );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_pop_front",              DQUEERR_NOERR,    pop_front( queue, &data )                            ) ) {
+	    break;
+        }
+    }
+    if (prtest( "dque_max_size",                    DQUEERR_NOERR,    max_size( queue, &uns )                              ) ) {
+        (void) printf( "max_size: %u\n", uns );
+        prtest( "dque_max_size <= high watermark",  DQUEERR_NOERR, (uns <= 100) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+
+    (void) printf( "\n------------------------------\ntwo queues sharing one node pool\n" );
+    prtest( "dque_create_pool (not a pool)",        DQUEERR_INVARG,   create_pool( &queue3, queue )                        );
+    prtest( "dque_destroy (using dynamic memory)",  DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_pool_create (using dynamic memory)", DQUEERR_NOERR, pool_create( &pool, 0, (char *)NULL )              );
+    prtest( "dque_create_pool (invalid pool)",      DQUEERR_NOQUEUE,  create_pool( &queue,  NULL_QUEUE )                   );
+    prtest( "dque_create_pool",                     DQUEERR_NOERR,    create_pool( &queue,  pool )                         );
+    prtest( "dque_create_pool",                     DQUEERR_NOERR,    create_pool( &queue3, pool )                         );
+    for (i = 0; i < 20; ++i) {
+        if (!prtest( "dque_push_back (first queue)", DQUEERR_NOERR,   push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    for (i = 0; i < 20; ++i) {
+        if (!prtest( "dque_pop_front (first queue)", DQUEERR_NOERR,   pop_front( queue, &data )                            ) ) {
+	    break;
+        }
+    }
+    for (i = 0; i < 20; ++i) {
+        if (!prtest( "dque_push_back (second queue)", DQUEERR_NOERR,  push_back( queue3, &array5[i] )                      ) ) {
+	    break;
+        }
+    }
+    if (prtest( "dque_max_size (second queue)",     DQUEERR_NOERR,    max_size( queue3, &uns )                             ) ) {
+        (void) printf( "max_size: %u\n", uns );    /* nodes freed by the first queue were reused */
+        prtest( "dque_max_size == 24 + inline nodes", DQUEERR_NOERR, (uns == 24 + inl) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    prtest( "dque_push_back (first queue)",         DQUEERR_NOERR,    push_back( queue, &array5[0] )                       );
+    prtest( "dque_pool_destroy (pool in use)",      DQUEERR_INUSE,    pool_destroy( &pool )                                );
+    prtest( "dque_destroy (pooled queue)",          DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_destroy (pooled queue)",          DQUEERR_NOERR,    destroy( &queue3                                   ) );
+    if (prtest( "dque_max_size (pool)",             DQUEERR_NOERR,    max_size( pool, &uns )                               ) ) {
+        prtest( "dque_max_size == 24 + inline nodes", DQUEERR_NOERR, (uns == 24 + inl) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    prtest( "dque_pool_destroy",                    DQUEERR_NOERR,    pool_destroy( &pool )                                );
+
+    (void) printf( "\n------------------------------\nlarge static buffer, qnodes are carved as needed\n" );
+    prtest( "dque_create (large static buffer)",    DQUEERR_NOERR,    create( &queue, sizeof(bigbuf), bigbuf )             );
+    if (prtest( "dque_max_size",                    DQUEERR_NOERR,    max_size( queue, &uns )                              ) ) {
+        (void) printf( "max_size: %u\n", uns );
+        prtest( "dque_max_size == buffer qnodes",   DQUEERR_NOERR, (uns == (sizeof(bigbuf)-headsize)/nodesize) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    for (i = 0; i < 10; ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    for (i = 0; i < 5; ++i) {
+        if (!prtest( "dque_pop_front",              DQUEERR_NOERR,    pop_front( queue, &data )                            ) ) {
+	    break;
+        }
+    }
+    for (i = 10; i < 20; ++i) {             /* reuses the five popped qnodes first */
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_size",                            DQUEERR_NOERR,    size( queue, &uns )                                  );
+    prtest( "dque_size == 15",                      DQUEERR_NOERR, (uns == 15) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == buffer qnodes",       DQUEERR_NOERR, (uns == (sizeof(bigbuf)-headsize)/nodesize) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_reserve (no dynamic allocation)", DQUEERR_ALLOCNA,  reserve( queue, sizeof(bigbuf) )                    );
+    prtest( "dque_destroy (using static memory)",   DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\nreserve 1000 qnodes, push 1000 integer elements without another allocation\n" );
+    prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
+    prtest( "dque_reserve (invalid queue)",         DQUEERR_NOQUEUE,  reserve( NULL_QUEUE, 1000 )                          );
+    prtest( "dque_reserve",                         DQUEERR_NOERR,    reserve( queue, 1000 )                               );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 1000",                DQUEERR_NOERR, (uns == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_reserve (already reserved)",      DQUEERR_NOERR,    reserve( queue, 500 )                                );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 1000",                DQUEERR_NOERR, (uns == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy (using dynamic memory)",  DQUEERR_NOERR,    destroy( &queue                                    ) );
+
     (void) printf( "\n------------------------------\nfill queue with five string elements\n" );
     prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
     for (i = 0; i < (sizeof(array2)/sizeof(char *)); ++i) {
@@ -480,6 +715,839 @@ char  **argv )
     prtest( "dque_pri_empty == 1",  DQUEERR_NOERR, pri_empty( pri )        == 1 ? DQUEERR_NOERR : DQUEERR_UNKERR );
     prtest( "dque_pri_destroy (dynamic memory)",  DQUEERR_NOERR, pri_destroy( &pri )                     );
 
+    (void) printf( "\n------------------------------\nbinary heap priority queue, equal keys must pop in push order\n" );
+    prtest( "dque_pri_create_heap (invalid arity)", DQUEERR_INVARG, pri_create_heap( &pri, intcomp, 1 )  );
+    prtest( "dque_pri_create_heap (binary heap)",   DQUEERR_NOERR,  pri_create_heap( &pri, intcomp, 2 )  );
+    for (i = 0; i < (sizeof(array3)/sizeof(int)); ++i) {
+        if (!prtest( "dque_pri_push",             DQUEERR_NOERR, pri_push( pri, &array3[i] )) ) {
+	    break;
+        }
+    }
+    prtest( "dque_pri_size  == 10", DQUEERR_NOERR, pri_size( pri )        == 10 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_top   == 0",  DQUEERR_NOERR, *(int *)pri_top( pri )  == 0 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == first 0", DQUEERR_NOERR, pri_pop( pri ) == &array3[6] ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == second 0",DQUEERR_NOERR, pri_pop( pri ) == &array3[9] ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == 1",  DQUEERR_NOERR, *(int *)pri_pop( pri )  == 1 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == 2",  DQUEERR_NOERR, *(int *)pri_pop( pri )  == 2 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == 3",  DQUEERR_NOERR, *(int *)pri_pop( pri )  == 3 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == first 4", DQUEERR_NOERR, pri_pop( pri ) == &array3[2] ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == second 4",DQUEERR_NOERR, pri_pop( pri ) == &array3[8] ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == 6",  DQUEERR_NOERR, *(int *)pri_pop( pri )  == 6 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == 8",  DQUEERR_NOERR, *(int *)pri_pop( pri )  == 8 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop   == 9",  DQUEERR_NOERR, *(int *)pri_pop( pri )  == 9 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_empty == 1",  DQUEERR_NOERR, pri_empty( pri )        == 1 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_pop (empty heap)", DQUEERR_NOERR, pri_pop( pri ) == NULL ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_destroy (binary heap)",     DQUEERR_NOERR, pri_destroy( &pri )                     );
+
+    (void) printf( "\n------------------------------\n4-ary heap priority queue, push 1000 integers past initial heap size\n" );
+    prtest( "dque_pri_create_heap (4-ary heap)",  DQUEERR_NOERR, pri_create_heap( &pri, intcomp, 4 )    );
+    for (i = 0; i < 1000; ++i) {
+        if (pri_push( pri, &array[(i * 7) % 10] ) != DQUEERR_NOERR) {
+            break;
+        }
+    }
+    prtest( "dque_pri_size  == 1000", DQUEERR_NOERR, pri_size( pri )      == 1000 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0, val2 = 0; pri_empty( pri ) == 0; ++i) {
+        val = (int *)pri_pop( pri );
+        if (*val < val2) {                  /* popped out of order?         */
+            break;
+        }
+        val2 = *val;
+    }
+    prtest( "dque_pri_pop (1000 in order)", DQUEERR_NOERR, i == 1000 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_destroy (4-ary heap)",      DQUEERR_NOERR, pri_destroy( &pri )                     );
+
+    (void) printf( "\n------------------------------\nmmap'd node arena, push 1000 integer elements without another allocation\n" );
+    prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
+    prtest( "dque_options (ARENA invalid flags)",   DQUEERR_INVARG,   options( queue, DQUEOPT_ARENA, 1000, 0x100 )         );
+    prtest( "dque_options (ARENA POPULATE|MLOCK)",  DQUEERR_NOERR,    options( queue, DQUEOPT_ARENA, 1000, DQUEARENA_POPULATE|DQUEARENA_MLOCK ) );
+    prtest( "dque_options (second ARENA)",          DQUEERR_INVARG,   options( queue, DQUEOPT_ARENA, 1000, 0 )             );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size >= 1000",                DQUEERR_NOERR, (uns >= 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns2 )                             );
+    prtest( "dque_max_size unchanged",              DQUEERR_NOERR, (uns2 == uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_shrink_to_fit (arena is kept)",   DQUEERR_NOERR,    shrink_to_fit( queue )                               );
+    prtest( "dque_size",                            DQUEERR_NOERR,    size( queue, &uns2 )                                 );
+    prtest( "dque_size == 1000",                    DQUEERR_NOERR, (uns2 == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy (unmaps arena)",          DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
+    prtest( "dque_options (ARENA HUGETLB)",         DQUEERR_NOERR,    options( queue, DQUEOPT_ARENA, 25, DQUEARENA_HUGETLB|DQUEARENA_POPULATE ) );
+    prtest( "dque_push_back",                       DQUEERR_NOERR,    push_back( queue, &array5[0] )                       );
+    prtest( "dque_destroy (unmaps arena)",          DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\nintrusive queue links the dque_link inside each object, no qnodes allocated\n" );
+    prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
+#ifdef DQUE_COMPACT
+    prtest( "dque_options (INTRUSIVE, compact)",    DQUEERR_NOTSUP,   options( queue, DQUEOPT_INTRUSIVE, offsetof(struct job, link) ) );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+#else
+    prtest( "dque_options (INTRUSIVE)",             DQUEERR_NOERR,    options( queue, DQUEOPT_INTRUSIVE, offsetof(struct job, link) ) );
+    for (i = 0; i < 10; ++i) {
+        jobs[i].val = i;
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &jobs[i] )                         ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_push_back (already linked)",      DQUEERR_LINKED,   push_back( queue, &jobs[3] )                         );
+    prtest( "dque_options (INTRUSIVE not empty)",   DQUEERR_INVARG,   options( queue, DQUEOPT_INTRUSIVE, 0 )               );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 10 (no free qnodes)", DQUEERR_NOERR, (uns == 10) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_reserve (intrusive)",             DQUEERR_NOTSUP,   reserve( queue, 100 )                                );
+    for (i = 0, iter = my_begin( queue ); iter != my_end( queue ) && i < 10; my_next( queue, &iter ), ++i) {
+        if (DQUE_CONTAINER_OF( iter, struct job, link )->val != i) {
+            break;
+        }
+    }
+    prtest( "DQUE_CONTAINER_OF (iterate 10 objects)", DQUEERR_NOERR, (i == 10) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    iter = (dque_qiter *)&jobs[5].link;
+    prtest( "dque_erase (object's link)",           DQUEERR_NOERR,    erase(   queue, &data, iter )                        );
+    prtest( "dque_erase data == &jobs[5]",          DQUEERR_NOERR, (data == &jobs[5]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_push_front (erased object)",      DQUEERR_NOERR,    push_front( queue, &jobs[5] )                        );
+    prtest( "dque_pop_front",                       DQUEERR_NOERR,    pop_front( queue, &data )                            );
+    prtest( "dque_pop_front data == &jobs[5]",      DQUEERR_NOERR, (data == &jobs[5]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy (links cleared)",         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create (using dynamic memory)",   DQUEERR_NOERR,    create(  &queue,                 0, (char *)NULL   ) );
+    prtest( "dque_options (INTRUSIVE)",             DQUEERR_NOERR,    options( queue, DQUEOPT_INTRUSIVE, offsetof(struct job, link) ) );
+    prtest( "dque_push_back (object reused)",       DQUEERR_NOERR,    push_back( queue, &jobs[3] )                         );
+    prtest( "dque_destroy (links cleared)",         DQUEERR_NOERR,    destroy( &queue                                    ) );
+#endif
+
+    (void) printf( "\n------------------------------\nuser's allocator, every byte allocated is released\n" );
+    prtest( "dque_create_alloc (invalid queue ptr)", DQUEERR_NOQUEUEP, create_alloc( NULL_QUEUEP, cntmalloc, cntfree, &cntctx ) );
+    prtest( "dque_create_alloc (no free callback)",  DQUEERR_INVARG,   create_alloc( &queue, cntmalloc, NULL, &cntctx ) );
+    prtest( "dque_create_alloc",                    DQUEERR_NOERR,    create_alloc( &queue, cntmalloc, cntfree, &cntctx ) );
+    prtest( "dque_options (GROWGEO 256)",           DQUEERR_NOERR,    options( queue, DQUEOPT_GROWGEO, 256 )               );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    for (i = 0; i < 900; ++i) {
+        if (!prtest( "dque_pop_front",              DQUEERR_NOERR,    pop_front( queue, &data )                            ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_shrink_to_fit",                   DQUEERR_NOERR,    shrink_to_fit( queue )                               );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "allocator used and all bytes freed",   DQUEERR_NOERR, (cntctx.calls > 1 && cntctx.bytes == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+
+    cntctx.calls = 0;
+    prtest( "dque_pool_create_alloc",               DQUEERR_NOERR,    pool_create_alloc( &pool, cntmalloc, cntfree, &cntctx ) );
+    prtest( "dque_create_pool",                     DQUEERR_NOERR,    create_pool( &queue, pool )                          );
+    prtest( "dque_push_back",                       DQUEERR_NOERR,    push_back( queue, &array5[0] )                       );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_pool_destroy",                    DQUEERR_NOERR,    pool_destroy( &pool                                ) );
+    prtest( "pool allocator used and all freed",    DQUEERR_NOERR, (cntctx.calls == (inl ? 2 : 3) && cntctx.bytes == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+
+    cntctx.calls = 0;
+    prtest( "dque_pri_create_alloc (binary heap)",  DQUEERR_NOERR,    pri_create_alloc( &pri, intcomp, 2, cntmalloc, cntfree, &cntctx ) );
+    for (i = 0; i < 1000; ++i) {
+        if (pri_push( pri, &array[(i * 7) % 10] ) != DQUEERR_NOERR) {
+            break;
+        }
+    }
+    prtest( "dque_pri_size  == 1000", DQUEERR_NOERR, pri_size( pri )      == 1000 ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pri_destroy (binary heap)",       DQUEERR_NOERR,    pri_destroy( &pri )                                  );
+    prtest( "heap allocator used and all freed",    DQUEERR_NOERR, (cntctx.calls > 2 && cntctx.bytes == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+
+    (void) printf( "\n------------------------------\nchunked queue, data kept in chunks of 8 slots\n" );
+    prtest( "dque_create_chunk (invalid queue ptr)", DQUEERR_NOQUEUEP, create_chunk( NULL_QUEUEP, 8 )                      );
+    prtest( "dque_create_chunk (1 slot per chunk)", DQUEERR_MINCNT,   create_chunk( &queue, 1 )                            );
+    prtest( "dque_create_chunk",                    DQUEERR_NOERR,    create_chunk( &queue, 8 )                            );
+    prtest( "dque_options (SKIPLIST)",              DQUEERR_NOTSUP,   options( queue, DQUEOPT_SKIPLIST, intcomp )          );
+    prtest( "dque_options (INTRUSIVE)",             DQUEERR_NOTSUP,   options( queue, DQUEOPT_INTRUSIVE, 0 )               );
+    prtest( "dque_empty",                           DQUEERR_NOERR,    empty( queue, &uns )                                 );
+    prtest( "dque_empty == 1",                      DQUEERR_NOERR, (uns == 1) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 10; ++i) {              /* 9 8 ... 1 0 0 1 ... 8 9      */
+        if (!prtest( "dque_push_front",             DQUEERR_NOERR,    push_front( queue, &array[i] )                       )
+        ||  !prtest( "dque_push_back",              DQUEERR_NOERR,    push_back(  queue, &array[i] )                       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_front",                           DQUEERR_NOERR,    front( queue, &data )                                );
+    prtest( "dque_front data == 9",                 DQUEERR_NOERR, (*(int *)data == 9) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_back",                            DQUEERR_NOERR,    back(  queue, &data )                                );
+    prtest( "dque_back data == 9",                  DQUEERR_NOERR, (*(int *)data == 9) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0, iter = my_begin( queue ); iter != my_end( queue ); my_next( queue, &iter ), ++i) {
+        if (*(int *)my_data( iter ) != ((i < 10) ? 9 - i : i - 10)) {
+            break;
+        }
+    }
+    prtest( "dque_next (20 elements across chunks)", DQUEERR_NOERR, (i == 20) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0, iter = my_rbegin( queue ); iter != my_rend( queue ); my_rnext( queue, &iter ), ++i) {
+        if (*(int *)my_data( iter ) != ((i < 10) ? 9 - i : i - 10)) {
+            break;
+        }
+    }
+    prtest( "dque_rnext (20 elements across chunks)", DQUEERR_NOERR, (i == 20) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 24 (3 chunks)",       DQUEERR_NOERR, (uns == 24) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 10; ++i) {
+        if (!prtest( "dque_pop_back",               DQUEERR_NOERR,    pop_back(  queue, &data )                            )
+        ||  !prtest( "dque_pop_front",              DQUEERR_NOERR,    pop_front( queue, &data )                            ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_pop_front data == 0",             DQUEERR_NOERR, (*(int *)data == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front (empty queue)",         DQUEERR_NOERR,    pop_front( queue, &data )                            );
+    prtest( "dque_pop_front data == NULL",          DQUEERR_NOERR, (data == NULL) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "dque_key_insert",             DQUEERR_NOERR,    key_insert( queue, NULL, intcomp, &array5[i] )       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_key_insert (queue in order)",     DQUEERR_NOERR,    myorder( queue, 1000 )                               );
+    prtest( "dque_key_find",                        DQUEERR_NOERR,    key_find( queue, &array5[7], intcomp, &iter )        );
+    prtest( "dque_key_find data",                   DQUEERR_NOERR, (*(int *)my_data( iter ) == array5[7]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_insert (before found element)",   DQUEERR_NOERR,    insert( queue, &array5[7], iter )                    );
+    prtest( "dque_key_find",                        DQUEERR_NOERR,    key_find( queue, &array5[7], intcomp, &iter )        );
+    prtest( "dque_erase (found element)",           DQUEERR_NOERR,    erase( queue, &data, iter )                          );
+    prtest( "dque_erase data",                      DQUEERR_NOERR, (*(int *)data == array5[7]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 500; ++i) {
+        if (!prtest( "dque_key_erase",              DQUEERR_NOERR,    key_erase( queue, &array5[i], intcomp, &data )       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_key_erase (queue in order)",      DQUEERR_NOERR,    myorder( queue, 500 )                                );
+    prtest( "dque_options (NODUPE)",                DQUEERR_NOERR,    options( queue, DQUEOPT_NODUPE, 1 )                  );
+    prtest( "dque_key_insert (duplicate)",          DQUEERR_NODUPE,   key_insert( queue, NULL, intcomp, &array5[0] )       );
+    prtest( "dque_size",                            DQUEERR_NOERR,    size( queue, &uns )                                  );
+    prtest( "dque_size == 500",                     DQUEERR_NOERR, (uns == 500) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_reserve (1500 elements)",         DQUEERR_NOERR,    reserve( queue, 1500 )                               );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size >= 1500 (spare chunks)", DQUEERR_NOERR, (uns >= 1500) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 1000; ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns2 )                             );
+    prtest( "dque_max_size unchanged (no new chunk)", DQUEERR_NOERR, (uns2 == uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_reserve (1600 elements)",         DQUEERR_NOERR,    reserve( queue, 1600 )                               );
+    prtest( "dque_shrink_to_fit (spare chunks)",    DQUEERR_NOERR,    shrink_to_fit( queue )                               );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns2 )                             );
+    prtest( "dque_max_size unchanged (no spares)",  DQUEERR_NOERR, (uns2 == uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\nring buffer queue, FIFO and LIFO in a power of two ring of slots\n" );
+    prtest( "dque_create_ring (using dynamic memory)", DQUEERR_NOERR, create_ring( &queue, 0, (char *)NULL )               );
+    prtest( "dque_options (SKIPLIST)",              DQUEERR_NOTSUP,   options( queue, DQUEOPT_SKIPLIST, intcomp )          );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "que_push",                    DQUEERR_NOERR,    que_push( queue, &array5[i] )                        ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 1024 (doubled)",      DQUEERR_NOERR, (uns == 1024) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 600; ++i) {
+        if (que_pop( queue ) != &array5[i]) {
+            break;
+        }
+    }
+    prtest( "que_pop (600 elements in order)",      DQUEERR_NOERR, (i == 600) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 500; ++i) {             /* wraps around the ring        */
+        if (!prtest( "que_push",                    DQUEERR_NOERR,    que_push( queue, &array5[i] )                        ) ) {
+	    break;
+        }
+    }
+    for (i = 0, iter = my_begin( queue ); iter != my_end( queue ); my_next( queue, &iter ), ++i) {
+        if (my_data( iter ) != &array5[(i < 400) ? i + 600 : i - 400]) {
+            break;
+        }
+    }
+    prtest( "dque_next (900 elements around ring)", DQUEERR_NOERR, (i == 900) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0, iter = my_rbegin( queue ); iter != my_rend( queue ); my_rnext( queue, &iter ), ++i) {
+        if (my_data( iter ) != &array5[(i < 500) ? 499 - i : 1499 - i]) {
+            break;
+        }
+    }
+    prtest( "dque_rnext (900 elements around ring)", DQUEERR_NOERR, (i == 900) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "que_front == &array5[600]",            DQUEERR_NOERR, (que_front( queue ) == &array5[600]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "que_back  == &array5[499]",            DQUEERR_NOERR, (que_back( queue )  == &array5[499]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_begin",                           DQUEERR_NOERR,    begin( queue, &iter )                                );
+    prtest( "dque_insert (not supported)",          DQUEERR_NOTSUP,   insert( queue, &array5[0], iter )                    );
+    prtest( "dque_erase (not supported)",           DQUEERR_NOTSUP,   erase( queue, &data, iter )                          );
+    prtest( "dque_reserve",                         DQUEERR_NOERR,    reserve( queue, 3000 )                               );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 4096",                DQUEERR_NOERR, (uns == 4096) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "que_front == &array5[600] (reserved)", DQUEERR_NOERR, (que_front( queue ) == &array5[600]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "que_size == 900",                      DQUEERR_NOERR, (que_size( queue ) == 900) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create_ring (buffer too small)",  DQUEERR_MINCNT,   create_ring( &queue, headsize+sizeof(void *), bfr )  );
+    prtest( "dque_create_ring (using static memory)", DQUEERR_NOERR,  create_ring( &queue, headsize+10*sizeof(void *), bfr ) );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 8 (power of two)",    DQUEERR_NOERR, (uns == 8) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 8; ++i) {
+        if (!prtest( "stk_push",                    DQUEERR_NOERR,    stk_push( queue, &array[i] )                         ) ) {
+	    break;
+        }
+    }
+    prtest( "stk_push (ring full)",                 DQUEERR_ALLOCNA,  stk_push( queue, &array[8] )                         );
+    prtest( "dque_reserve (static ring)",           DQUEERR_ALLOCNA,  reserve( queue, 16 )                                 );
+    for (i = 7; i >= 0; --i) {
+        if (stk_pop( queue ) != &array[i]) {
+            break;
+        }
+    }
+    prtest( "stk_pop (8 elements, LIFO order)",     DQUEERR_NOERR, (i < 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "stk_empty",                            DQUEERR_NOERR, stk_empty( queue ) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy (using static memory)",   DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\ninline qnodes, a queue of a few elements allocates only its qhead\n" );
+    cntctx.calls = 0;
+    prtest( "dque_create_alloc",                    DQUEERR_NOERR,    create_alloc( &queue, cntmalloc, cntfree, &cntctx ) );
+    for (i = 0; i < (int)inl; ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array[i] )                        ) ) {
+	    break;
+        }
+    }
+    prtest( "only the qhead was allocated",         DQUEERR_NOERR, (cntctx.calls == 1) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_push_back (past inline qnodes)",  DQUEERR_NOERR,    push_back( queue, &array[9] )                        );
+    prtest( "block allocated on overflow",          DQUEERR_NOERR, (cntctx.calls == 2) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "myorder (inline and block qnodes)",    DQUEERR_NOERR,    myorder( queue, inl + 1 )                            );
+    prtest( "dque_shrink_to_fit",                   DQUEERR_NOERR,    shrink_to_fit( queue )                               );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "all bytes freed",                      DQUEERR_NOERR, (cntctx.bytes == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+
+    (void) printf( "\n------------------------------\nsingly-linked FIFO queue, forward links only\n" );
+    prtest( "dque_create_fifo (invalid queue ptr)", DQUEERR_NOQUEUEP, create_fifo( NULL_QUEUEP )                           );
+    prtest( "dque_create_fifo",                     DQUEERR_NOERR,    create_fifo( &queue )                                );
+    prtest( "dque_options (SKIPLIST)",              DQUEERR_NOTSUP,   options( queue, DQUEOPT_SKIPLIST, intcomp )          );
+    for (i = 0; i < (sizeof(array5)/sizeof(int)); ++i) {
+        if (!prtest( "que_push",                    DQUEERR_NOERR,    que_push( queue, &array5[i] )                        ) ) {
+	    break;
+        }
+    }
+    prtest( "que_front == &array5[0]",              DQUEERR_NOERR, (que_front( queue ) == &array5[0])   ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "que_back  == &array5[999]",            DQUEERR_NOERR, (que_back( queue )  == &array5[999]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0, iter = my_begin( queue ); iter != my_end( queue ); my_next( queue, &iter ), ++i) {
+        if (my_data( iter ) != &array5[i]) {
+            break;
+        }
+    }
+    prtest( "dque_next (1000 elements in order)",   DQUEERR_NOERR, (i == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_rbegin (no backward links)",      DQUEERR_NOTSUP,   rbegin( queue, &iter )                               );
+    prtest( "dque_pop_back (no backward links)",    DQUEERR_NOTSUP,   pop_back( queue, &data )                             );
+    prtest( "dque_key_find",                        DQUEERR_NOERR,    key_find( queue, &array5[0], intcomp, &iter )        );
+    prtest( "dque_insert (not supported)",          DQUEERR_NOTSUP,   insert( queue, &array5[0], iter )                    );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size >= 1000",                DQUEERR_NOERR, (uns >= 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 1000; ++i) {
+        if (que_pop( queue ) != &array5[i]) {
+            break;
+        }
+    }
+    prtest( "que_pop (1000 elements in order)",     DQUEERR_NOERR, (i == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "que_empty",                            DQUEERR_NOERR, que_empty( queue ) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns2 )                             );
+    prtest( "dque_max_size unchanged (snodes reused)", DQUEERR_NOERR, (uns2 == uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "stk_push",                             DQUEERR_NOERR,    stk_push( queue, &array[1] )                         );
+    prtest( "stk_push",                             DQUEERR_NOERR,    stk_push( queue, &array[2] )                         );
+    prtest( "stk_pop == &array[2]",                 DQUEERR_NOERR, (stk_pop( queue ) == &array[2]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "stk_pop == &array[1]",                 DQUEERR_NOERR, (stk_pop( queue ) == &array[1]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_reserve",                         DQUEERR_NOERR,    reserve( queue, 3000 )                               );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size == 3000",                DQUEERR_NOERR, (uns == 3000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\nXOR-linked queue, one link per element\n" );
+    prtest( "dque_create_xor (invalid queue ptr)",  DQUEERR_NOQUEUEP, create_xor( NULL_QUEUEP )                            );
+    prtest( "dque_create_xor",                      DQUEERR_NOERR,    create_xor( &queue )                                 );
+    prtest( "dque_options (INTRUSIVE)",             DQUEERR_NOTSUP,   options( queue, DQUEOPT_INTRUSIVE, 0 )               );
+    for (i = 500; i < 1000; ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    for (i = 499; i >= 0; --i) {
+        if (!prtest( "dque_push_front",             DQUEERR_NOERR,    push_front( queue, &array5[i] )                      ) ) {
+	    break;
+        }
+    }
+    prtest( "que_front == &array5[0]",              DQUEERR_NOERR, (que_front( queue ) == &array5[0])   ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "que_back  == &array5[999]",            DQUEERR_NOERR, (que_back( queue )  == &array5[999]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0, iter = my_begin( queue ); iter != my_end( queue ); my_next( queue, &iter ), ++i) {
+        if (my_data( iter ) != &array5[i]) {
+            break;
+        }
+    }
+    prtest( "dque_next (1000 elements in order)",   DQUEERR_NOERR, (i == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 999, iter = my_rbegin( queue ); iter != my_rend( queue ); my_rnext( queue, &iter ), --i) {
+        if (my_data( iter ) != &array5[i]) {
+            break;
+        }
+    }
+    prtest( "dque_rnext (1000 elements in order)",  DQUEERR_NOERR, (i == -1) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_key_find",                        DQUEERR_NOERR,    key_find( queue, &array5[0], intcomp, &iter )        );
+    prtest( "dque_get_data == &array5[0]",          DQUEERR_NOERR, (my_data( iter ) == &array5[0]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 500; ++i) {
+        my_next( queue, &iter );
+    }
+    prtest( "que_front == &array5[0] (drops cache)",DQUEERR_NOERR, (que_front( queue ) == &array5[0])   ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_get_data == &array5[500]",        DQUEERR_NOERR, (my_data( iter ) == &array5[500]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_rnext",                           DQUEERR_NOERR,    rnext( queue, &iter )                                );
+    prtest( "dque_get_data == &array5[499]",        DQUEERR_NOERR, (my_data( iter ) == &array5[499]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_next",                            DQUEERR_NOERR,    next( queue, &iter )                                 );
+    prtest( "dque_next",                            DQUEERR_NOERR,    next( queue, &iter )                                 );
+    prtest( "dque_get_data == &array5[501]",        DQUEERR_NOERR, (my_data( iter ) == &array5[501]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_insert (not supported)",          DQUEERR_NOTSUP,   insert( queue, &array5[0], iter )                    );
+    prtest( "dque_erase (not supported)",           DQUEERR_NOTSUP,   erase( queue, &data, iter )                          );
+    prtest( "dque_pop_back",                        DQUEERR_NOERR,    pop_back( queue, &data )                             );
+    prtest( "dque_pop_back == &array5[999]",        DQUEERR_NOERR, (data == &array5[999]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0, iter = my_begin( queue ); iter != my_end( queue ); ++i) {
+        my_next( queue, &iter );            /* pop behind the iterator      */
+        if (que_pop( queue ) != &array5[i]) {
+            break;
+        }
+    }
+    prtest( "que_pop while iterating (999 in order)", DQUEERR_NOERR, (i == 999 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size >= 1000",                DQUEERR_NOERR, (uns >= 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "stk_push",                             DQUEERR_NOERR,    stk_push( queue, &array[1] )                         );
+    prtest( "stk_push",                             DQUEERR_NOERR,    stk_push( queue, &array[2] )                         );
+    prtest( "stk_pop == &array[2]",                 DQUEERR_NOERR, (stk_pop( queue ) == &array[2]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "stk_pop == &array[1]",                 DQUEERR_NOERR, (stk_pop( queue ) == &array[1]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\nLIFO qnode reuse and dque_compact\n" );
+    prtest( "dque_compact (invalid pointer to queue)", DQUEERR_NOQUEUE, compact( NULL_QUEUE )                              );
+    prtest( "dque_create",                          DQUEERR_NOERR,    create( &queue, 0, (char *)NULL )                    );
+    for (i = 0; i < 1000; ++i) {
+        if (!prtest( "dque_push_back",              DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+	    break;
+        }
+    }
+    prtest( "dque_rbegin",                          DQUEERR_NOERR,    rbegin( queue, &iter )                               );
+    prtest( "dque_pop_back",                        DQUEERR_NOERR,    pop_back( queue, &data )                             );
+    prtest( "dque_push_back",                       DQUEERR_NOERR,    push_back( queue, data )                             );
+    prtest( "dque_rbegin",                          DQUEERR_NOERR,    rbegin( queue, &iter2 )                              );
+    prtest( "freed qnode reused first",             DQUEERR_NOERR, (iter == iter2) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 1000; ++i) {                /* reused qnodes come back reversed */
+        (void) que_pop( queue );
+    }
+    for (i = 0; i < 1000; ++i) {
+        (void) que_push( queue, &array5[i] );
+    }
+    prtest( "dque_compact",                         DQUEERR_NOERR,    compact( queue )                                     );
+    for (i = 0, iter2 = NULL_QITER, iter = my_begin( queue ); iter != my_end( queue ); my_next( queue, &iter ), ++i) {
+        if ((iter2 != NULL_QITER && iter < iter2) || my_data( iter ) != &array5[i]) {
+            break;
+        }
+        iter2 = iter;
+    }
+    prtest( "qnodes in address order, data in order", DQUEERR_NOERR, (i == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_size",                            DQUEERR_NOERR,    size( queue, &uns )                                  );
+    prtest( "dque_size == 1000",                    DQUEERR_NOERR, (uns == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create",                          DQUEERR_NOERR,    create( &queue, 0, (char *)NULL )                    );
+    for (i = 0; i < (sizeof(array)/sizeof(int)); ++i) {
+        (void) que_push( queue, &array[i] );
+    }
+    prtest( "dque_options (SKIPLIST)",              DQUEERR_NOERR,    options( queue, DQUEOPT_SKIPLIST, intcomp )          );
+    prtest( "dque_compact (skip list)",             DQUEERR_NOERR,    compact( queue )                                     );
+    prtest( "dque_key_find (rebuilt skip list)",    DQUEERR_NOERR,    key_find( queue, &array[7], intcomp, &iter )         );
+    prtest( "dque_get_data == &array[7]",           DQUEERR_NOERR, (my_data( iter ) == &array[7]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create_chunk",                    DQUEERR_NOERR,    create_chunk( &queue, 0 )                            );
+    prtest( "dque_compact (chunked)",               DQUEERR_NOTSUP,   compact( queue )                                     );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+#ifndef DQUE_NOLOCK
+    {
+    pthread_t   thrd[4];
+    void       *rslt;
+    unsigned    fails = 0;
+
+    (void) printf( "\n------------------------------\nDQUEOPT_LOCKED queue shared by 4 threads\n" );
+    prtest( "dque_create",                          DQUEERR_NOERR,    create( &queue, 0, (char *)NULL )                    );
+    prtest( "dque_options (LOCKED)",                DQUEERR_NOERR,    options( queue, DQUEOPT_LOCKED, 1 )                  );
+    for (i = 0; i < 4; ++i) {
+        (void) pthread_create( &thrd[i], NULL, lockworker, queue );
+    }
+    for (i = 0; i < 4; ++i) {
+        (void) pthread_join( thrd[i], &rslt );
+        fails += (rslt != NULL);
+    }
+    prtest( "40000 pushed and popped",              DQUEERR_NOERR, (fails == 0 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_pool_create",                     DQUEERR_NOERR,    pool_create( &pool, 0, (char *)NULL )                );
+    prtest( "dque_options (LOCKED pool)",           DQUEERR_NOERR,    options( pool, DQUEOPT_LOCKED, 1 )                   );
+    prtest( "dque_create_pool",                     DQUEERR_NOERR,    create_pool( &queue, pool )                          );
+    prtest( "dque_create_pool",                     DQUEERR_NOERR,    create_pool( &queue2, pool )                         );
+    prtest( "dque_options (LOCKED)",                DQUEERR_NOERR,    options( queue, DQUEOPT_LOCKED, 1 )                  );
+    prtest( "dque_options (LOCKED)",                DQUEERR_NOERR,    options( queue2, DQUEOPT_LOCKED, 1 )                 );
+    for (i = 0; i < 4; ++i) {               /* two threads on each queue    */
+        (void) pthread_create( &thrd[i], NULL, lockworker, (i & 1) ? queue2 : queue );
+    }
+    for (i = 0; i < 4; ++i) {
+        (void) pthread_join( thrd[i], &rslt );
+        fails += (rslt != NULL);
+    }
+    prtest( "40000 pushed and popped (pool)",       DQUEERR_NOERR, (fails == 0 && que_empty( queue ) && que_empty( queue2 )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue2                                   ) );
+    prtest( "dque_pool_destroy",                    DQUEERR_NOERR,    pool_destroy( &pool                                ) );
+    prtest( "dque_create (using static memory)",    DQUEERR_NOERR,    create( &queue, sizeof(bfr), bfr )                   );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_options (LOCKED static)",         DQUEERR_NOERR,    options( queue, DQUEOPT_LOCKED, 1 )                  );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns2 )                             );
+    prtest( "dque_max_size less (mutex in buffer)", DQUEERR_NOERR, (uns2 < uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_push_back",                       DQUEERR_NOERR,    push_back( queue, &array[0] )                        );
+    prtest( "dque_pop_front",                       DQUEERR_NOERR,    pop_front( queue, &data )                            );
+    prtest( "dque_pop_front data == &array[0]",     DQUEERR_NOERR, (data == &array[0]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_options (LOCKED off)",            DQUEERR_NOERR,    options( queue, DQUEOPT_LOCKED, 0 )                  );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns2 )                             );
+    prtest( "dque_max_size restored",               DQUEERR_NOERR, (uns2 == uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create (using static memory)",    DQUEERR_NOERR,    create( &queue, headsize+(2*nodesize), bfr )         );
+    prtest( "dque_push_back",                       DQUEERR_NOERR,    push_back( queue, &array[0] )                        );
+    prtest( "dque_push_back",                       DQUEERR_NOERR,    push_back( queue, &array[1] )                        );
+    prtest( "dque_options (LOCKED, no room)",       DQUEERR_ALLOCNA,  options( queue, DQUEOPT_LOCKED, 1 )                  );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    }
+#endif
+
+    (void) printf( "\n------------------------------\nlock-free bounded MPMC queue\n" );
+#ifdef DQUE_NOATOMIC
+    prtest( "dque_create_mpmc (no atomic builtins)", DQUEERR_NOTSUP,  create_mpmc( &queue, 0, (char *)NULL )               );
+#else
+    prtest( "dque_create_mpmc (invalid queue ptr)", DQUEERR_NOQUEUEP, create_mpmc( NULL_QUEUEP, 0, (char *)NULL )         );
+    prtest( "dque_create_mpmc (no room for cells)", DQUEERR_MINCNT,   create_mpmc( &queue, headsize, bfr )                 );
+    prtest( "dque_create_mpmc (static buffer)",     DQUEERR_NOERR,    create_mpmc( &queue, sizeof(bfr), bfr )              );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size is a power of two",      DQUEERR_NOERR, (uns >= 2 && (uns & (uns - 1)) == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front (empty)",               DQUEERR_EMPTY,    pop_front( queue, &data )                            );
+    prtest( "dque_options (LOCKED)",                DQUEERR_NOTSUP,   options( queue, DQUEOPT_LOCKED, 1 )                  );
+    prtest( "dque_options (SKIPLIST)",              DQUEERR_NOTSUP,   options( queue, DQUEOPT_SKIPLIST, intcomp )          );
+    prtest( "dque_push_front (not supported)",      DQUEERR_NOTSUP,   push_front( queue, &array[0] )                       );
+    prtest( "dque_pop_back (not supported)",        DQUEERR_NOTSUP,   pop_back( queue, &data )                             );
+    prtest( "dque_begin (not supported)",           DQUEERR_NOTSUP,   begin( queue, &iter )                                );
+    prtest( "dque_key_find (not supported)",        DQUEERR_NOTSUP,   key_find( queue, &array[0], intcomp, &iter )         );
+    for (uns2 = 0; uns2 < 3; ++uns2) {          /* fill and drain, three laps */
+        for (i = 0; i < (int)uns; ++i) {
+            if (!prtest( "dque_push_back",          DQUEERR_NOERR,    push_back( queue, &array5[i] )                       ) ) {
+                break;
+            }
+        }
+        prtest( "dque_push_back (full)",            DQUEERR_FULL,     push_back( queue, &array5[i] )                       );
+        prtest( "dque_size",                        DQUEERR_NOERR,    size( queue, &inl )                                  );
+        prtest( "dque_size == dque_max_size",       DQUEERR_NOERR, (inl == uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+        for (i = 0; i < (int)uns; ++i) {
+            if (que_pop( queue ) != &array5[i]) {
+                break;
+            }
+        }
+        prtest( "dque_pop_front (all in order)",    DQUEERR_NOERR, (i == (int)uns && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create_mpmc",                     DQUEERR_NOERR,    create_mpmc( &queue, 0, (char *)NULL )               );
+    prtest( "dque_reserve (more than the cells)",   DQUEERR_ALLOCNA,  reserve( queue, 100000 )                             );
+    prtest( "que_push",                             DQUEERR_NOERR,    que_push( queue, &array[3] )                         );
+    prtest( "que_pop == &array[3]",                 DQUEERR_NOERR, (que_pop( queue ) == &array[3]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+#ifndef DQUE_NOLOCK
+    {
+    pthread_t   thrd[4];
+    void       *rslt;
+
+    for (i = 0; i < 4; ++i) {               /* 4 producers and consumers    */
+        (void) pthread_create( &thrd[i], NULL, mpmcworker, queue );
+    }
+    for (uns = 0, i = 0; i < 4; ++i) {
+        (void) pthread_join( thrd[i], &rslt );
+        uns += (unsigned int)(size_t)rslt;  /* # of elements popped         */
+    }
+    while (!que_empty( queue )) {           /* left by the last pushes      */
+        uns += (que_pop( queue ) != NULL);
+    }
+    prtest( "40000 pushed and popped by 4 threads", DQUEERR_NOERR, (uns == 40000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+#endif
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+#endif
+
+    (void) printf( "\n------------------------------\nwait-free SPSC queue, push_back_n and pop_front_n\n" );
+    {
+    void       *ptrs[128];
+    void       *ptrs2[128];
+    unsigned    done;
+
+    for (i = 0; i < 128; ++i) {
+        ptrs[i] = &array5[i];
+    }
+#ifdef DQUE_NOATOMIC
+    prtest( "dque_create_spsc (no atomic builtins)", DQUEERR_NOTSUP,  create_spsc( &queue, 0, (char *)NULL )               );
+#else
+    prtest( "dque_create_spsc (invalid queue ptr)", DQUEERR_NOQUEUEP, create_spsc( NULL_QUEUEP, 0, (char *)NULL )         );
+    prtest( "dque_create_spsc (no room for slots)", DQUEERR_MINCNT,   create_spsc( &queue, headsize, bfr )                 );
+    prtest( "dque_create_spsc (static buffer)",     DQUEERR_NOERR,    create_spsc( &queue, sizeof(bfr), bfr )              );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size is a power of two",      DQUEERR_NOERR, (uns >= 2 && uns < 128 && (uns & (uns - 1)) == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front (empty)",               DQUEERR_EMPTY,    pop_front( queue, &data )                            );
+    prtest( "dque_pop_front_n (empty)",             DQUEERR_EMPTY,    pop_front_n( queue, ptrs2, 4, &done )                );
+    prtest( "dque_push_back_n (invalid data ptr)",  DQUEERR_NODATAP,  push_back_n( queue, NULL, 4, &done )                 );
+    prtest( "dque_push_back_n (invalid count ptr)", DQUEERR_INVARG,   push_back_n( queue, ptrs, 4, NULL )                  );
+    prtest( "dque_pop_front_n (invalid data ptr)",  DQUEERR_NODATAP,  pop_front_n( queue, NULL, 4, &done )                 );
+    prtest( "dque_pop_front_n (invalid count ptr)", DQUEERR_INVARG,   pop_front_n( queue, ptrs2, 4, NULL )                 );
+    ptrs[2] = NULL;
+    prtest( "dque_push_back_n (NULL data)",         DQUEERR_NODATA,   push_back_n( queue, ptrs, 4, &done )                 );
+    ptrs[2] = &array5[2];
+    prtest( "dque_push_front (not supported)",      DQUEERR_NOTSUP,   push_front( queue, &array[0] )                       );
+    prtest( "dque_begin (not supported)",           DQUEERR_NOTSUP,   begin( queue, &iter )                                );
+    prtest( "dque_push_back_n (full)",              DQUEERR_FULL,     push_back_n( queue, ptrs, uns + 5, &done )           );
+    prtest( "dque_push_back_n pushed max_size",     DQUEERR_NOERR, (done == uns) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_push_back (full)",                DQUEERR_FULL,     push_back( queue, &array[0] )                        );
+    prtest( "dque_pop_front_n",                     DQUEERR_NOERR,    pop_front_n( queue, ptrs2, 128, &done )              );
+    for (i = 0; i < (int)done && ptrs2[i] == &array5[i]; ++i) {
+        ;
+    }
+    prtest( "dque_pop_front_n (all in order)",      DQUEERR_NOERR, (done == uns && i == (int)uns && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (uns2 = 0, i = 0; i < 100; ++i) {   /* 7 at a time, many laps       */
+        if (push_back_n( queue, ptrs, 7, &done ) != DQUEERR_NOERR
+        ||  pop_front_n( queue, ptrs2, 8, &done ) != DQUEERR_NOERR) {
+            break;
+        }
+        for (inl = 0; inl < done && ptrs2[inl] == &array5[inl]; ++inl) {
+            ;
+        }
+        if (inl != 7) {
+            break;
+        }
+        uns2   += done;
+    }
+    prtest( "700 pushed and popped in order",       DQUEERR_NOERR, (i == 100 && uns2 == 700 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+#endif
+    prtest( "dque_create",                          DQUEERR_NOERR,    create( &queue, 0, (char *)NULL )                    );
+    prtest( "dque_push_back_n (qnode list)",        DQUEERR_NOERR,    push_back_n( queue, ptrs, 10, &done )                );
+    prtest( "dque_pop_front_n (4 of 10)",           DQUEERR_NOERR,    pop_front_n( queue, ptrs2, 4, &done )                );
+    prtest( "dque_pop_front_n == &array5[0..3]",    DQUEERR_NOERR, (done == 4 && ptrs2[3] == &array5[3]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front_n (6 left)",            DQUEERR_NOERR,    pop_front_n( queue, ptrs2, 128, &done )              );
+    prtest( "dque_pop_front_n == &array5[4..9]",    DQUEERR_NOERR, (done == 6 && ptrs2[0] == &array5[4] && ptrs2[5] == &array5[9]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front_n (empty)",             DQUEERR_EMPTY,    pop_front_n( queue, ptrs2, 128, &done )              );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    }
+#if !defined(DQUE_NOLOCK) && !defined(DQUE_NOATOMIC)
+    {
+    pthread_t   thrd;
+
+    prtest( "dque_create_spsc",                     DQUEERR_NOERR,    create_spsc( &queue, 0, (char *)NULL )               );
+    (void) pthread_create( &thrd, NULL, spscworker, queue );
+    for (i = 0; i < 100000; ++i) {          /* consumer, checks the order   */
+        while (dque_pop_front( queue, &data ) == DQUEERR_EMPTY) {
+            ;
+        }
+        if (data != &array5[i % 1000]) {
+            break;
+        }
+    }
+    (void) pthread_join( thrd, NULL );
+    prtest( "100000 pushed and popped in order",    DQUEERR_NOERR, (i == 100000 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    }
+#endif
+
+    (void) printf( "\n------------------------------\nblocking pop_front_wait and push_back_wait\n" );
+    prtest( "dque_pop_front_wait (invalid queue)",  DQUEERR_NOQUEUE,  pop_front_wait( NULL_QUEUE, &data, 0 )               );
+    prtest( "dque_push_back_wait (invalid queue)",  DQUEERR_NOQUEUE,  push_back_wait( NULL_QUEUE, &array[0], 0 )           );
+    prtest( "dque_create",                          DQUEERR_NOERR,    create( &queue, 0, (char *)NULL )                    );
+    prtest( "dque_pop_front_wait (invalid data ptr)", DQUEERR_NODATAP, pop_front_wait( queue, NULL, 0 )                    );
+    prtest( "dque_push_back_wait (invalid data)",   DQUEERR_NODATA,   push_back_wait( queue, NULL, 0 )                     );
+    prtest( "dque_pop_front_wait (empty, no wait)", DQUEERR_EMPTY,    pop_front_wait( queue, &data, 0 )                    );
+    prtest( "dque_pop_front_wait (not LOCKED)",     DQUEERR_NOTSUP,   pop_front_wait( queue, &data, 10 )                   );
+    prtest( "dque_push_back_wait (no wait)",        DQUEERR_NOERR,    push_back_wait( queue, &array[1], 0 )                );
+    prtest( "dque_pop_front_wait (no wait)",        DQUEERR_NOERR,    pop_front_wait( queue, &data, 0 )                    );
+    prtest( "dque_pop_front_wait == &array[1]",     DQUEERR_NOERR, (data == &array[1]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+#if defined(DQUE_NOATOMIC) && !defined(DQUE_NOLOCK)
+    prtest( "dque_options (LOCKED)",                DQUEERR_NOERR,    options( queue, DQUEOPT_LOCKED, 1 )                  );
+    prtest( "dque_pop_front_wait (no atomic builtins)", DQUEERR_NOTSUP, pop_front_wait( queue, &data, 10 )                 );
+#endif
+#if !defined(DQUE_NOLOCK) && !defined(DQUE_NOATOMIC)
+    {
+    pthread_t   thrd;
+    void       *rslt;
+
+    prtest( "dque_options (LOCKED)",                DQUEERR_NOERR,    options( queue, DQUEOPT_LOCKED, 1 )                  );
+    prtest( "dque_pop_front_wait (10ms timeout)",   DQUEERR_EMPTY,    pop_front_wait( queue, &data, 10 )                   );
+    prtest( "dque_pop_front_wait (timeout, NULL)",  DQUEERR_NOERR, (data == NULL) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    (void) pthread_create( &thrd, NULL, waitworker, queue );
+    for (i = 0; i < 10000; ++i) {           /* the consumer waits for each  */
+        (void) push_back( queue, &array5[i % 1000] );
+    }
+    (void) pthread_join( thrd, &rslt );
+    prtest( "10000 waited for on a LOCKED queue",   DQUEERR_NOERR, (rslt == NULL && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create_mpmc (static buffer)",     DQUEERR_NOERR,    create_mpmc( &queue, sizeof(bfr), bfr )              );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    for (i = 0; i < (int)uns; ++i) {
+        (void) push_back( queue, &array5[i] );
+    }
+    prtest( "dque_push_back_wait (full, 10ms)",     DQUEERR_FULL,     push_back_wait( queue, &array[0], 10 )               );
+    while (!que_empty( queue )) {
+        (void) que_pop( queue );
+    }
+    (void) pthread_create( &thrd, NULL, waitworker, queue );
+    for (i = 0; i < 10000; ++i) {           /* both sides wait on the ring  */
+        if (push_back_wait( queue, &array5[i % 1000], DQUE_FOREVER ) != DQUEERR_NOERR) {
+            break;
+        }
+    }
+    (void) pthread_join( thrd, &rslt );
+    prtest( "10000 waited for on an MPMC queue",    DQUEERR_NOERR, (i == 10000 && rslt == NULL && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+#endif
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\nChase-Lev work-stealing deque\n" );
+#ifdef DQUE_NOATOMIC
+    prtest( "dque_create_steal (no atomic builtins)", DQUEERR_NOTSUP, create_steal( &queue, 0, (char *)NULL )              );
+#else
+    prtest( "dque_create_steal (invalid queue ptr)", DQUEERR_NOQUEUEP, create_steal( NULL_QUEUEP, 0, (char *)NULL )       );
+    prtest( "dque_create_steal (no room for slots)", DQUEERR_MINCNT,  create_steal( &queue, headsize, bfr )                );
+    prtest( "dque_create_steal (static buffer)",    DQUEERR_NOERR,    create_steal( &queue, sizeof(bfr), bfr )             );
+    prtest( "dque_max_size",                        DQUEERR_NOERR,    max_size( queue, &uns )                              );
+    prtest( "dque_max_size is a power of two",      DQUEERR_NOERR, (uns >= 2 && (uns & (uns - 1)) == 0) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front (empty)",               DQUEERR_EMPTY,    pop_front( queue, &data )                            );
+    prtest( "dque_steal_back (empty)",              DQUEERR_EMPTY,    steal_back( queue, &data )                           );
+    prtest( "dque_steal_back (invalid data ptr)",   DQUEERR_NODATAP,  steal_back( queue, NULL )                            );
+    prtest( "dque_push_back (not supported)",       DQUEERR_NOTSUP,   push_back( queue, &array[0] )                        );
+    prtest( "dque_pop_back (not supported)",        DQUEERR_NOTSUP,   pop_back( queue, &data )                             );
+    prtest( "dque_begin (not supported)",           DQUEERR_NOTSUP,   begin( queue, &iter )                                );
+    for (i = 0; i < (int)uns; ++i) {
+        if (!prtest( "dque_push_front",             DQUEERR_NOERR,    push_front( queue, &array5[i] )                      ) ) {
+            break;
+        }
+    }
+    prtest( "dque_push_front (full)",               DQUEERR_FULL,     push_front( queue, &array5[i] )                      );
+    prtest( "dque_steal_back (oldest)",             DQUEERR_NOERR,    steal_back( queue, &data )                           );
+    prtest( "dque_steal_back == &array5[0]",        DQUEERR_NOERR, (data == &array5[0]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front (newest)",              DQUEERR_NOERR,    pop_front( queue, &data )                            );
+    prtest( "dque_pop_front == last pushed",        DQUEERR_NOERR, (data == &array5[uns - 1]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_size",                            DQUEERR_NOERR,    size( queue, &inl )                                  );
+    prtest( "dque_size == dque_max_size - 2",       DQUEERR_NOERR, (inl == uns - 2) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = (int)uns - 2; i > 0 && que_pop( queue ) == &array5[i]; --i) {
+        ;
+    }
+    prtest( "dque_pop_front (all, newest first)",   DQUEERR_NOERR, (i == 0 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    prtest( "dque_create_steal",                    DQUEERR_NOERR,    create_steal( &queue, 0, (char *)NULL )              );
+    for (i = 0; i < 1000 && push_front( queue, &array5[i] ) == DQUEERR_NOERR; ++i) {
+        ;
+    }
+    prtest( "dque_push_front (grows the array)",    DQUEERR_NOERR, (i == 1000 && max_size( queue, &uns ) == DQUEERR_NOERR && uns >= 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_reserve",                         DQUEERR_NOERR,    reserve( queue, 5000 )                               );
+    prtest( "dque_max_size >= 5000",                DQUEERR_NOERR, (max_size( queue, &uns ) == DQUEERR_NOERR && uns >= 5000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 0; i < 500 && steal_back( queue, &data ) == DQUEERR_NOERR && data == &array5[i]; ++i) {
+        ;
+    }
+    prtest( "dque_steal_back (500, oldest first)",  DQUEERR_NOERR, (i == 500) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 999; i >= 500 && que_pop( queue ) == &array5[i]; --i) {
+        ;
+    }
+    prtest( "dque_pop_front (500, newest first)",   DQUEERR_NOERR, (i == 499 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+#ifndef DQUE_NOLOCK
+    {
+    pthread_t   thrd[3];
+    void       *rslt;
+
+    for (i = 0; i < 3; ++i) {               /* 3 thieves                    */
+        (void) pthread_create( &thrd[i], NULL, stealworker, queue );
+    }
+    for (uns = 0, i = 0; i < 40000; ++i) {  /* owner pushes, pops some      */
+        (void) push_front( queue, &array5[i % 1000] );
+        if ((i & 3) == 3) {
+            uns += (pop_front( queue, &data ) == DQUEERR_NOERR);
+        }
+    }
+    for (i = 0; i < 3; ++i) {               /* one stop for each thief      */
+        (void) push_front( queue, &array[0] );
+    }
+    for (i = 0; i < 3; ++i) {
+        (void) pthread_join( thrd[i], &rslt );
+        uns += (unsigned int)(size_t)rslt;  /* # of elements stolen         */
+    }
+    prtest( "40000 popped or stolen by 3 threads",  DQUEERR_NOERR, (uns == 40000 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+#endif
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+#endif
+    prtest( "dque_create",                          DQUEERR_NOERR,    create( &queue, 0, (char *)NULL )                    );
+    prtest( "dque_steal_back (not a steal deque)",  DQUEERR_NOTSUP,   steal_back( queue, &data )                           );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+
+    (void) printf( "\n------------------------------\nlock-free skip list priority queue\n" );
+    prtest( "dque_create_prio (invalid queue ptr)", DQUEERR_NOQUEUEP, create_prio( NULL_QUEUEP, intcomp )                  );
+    prtest( "dque_create_prio (invalid comp)",      DQUEERR_NOCOMP,   create_prio( &queue, (COMPFUNC)NULL )                );
+#ifdef DQUE_NOATOMIC
+    prtest( "dque_create_prio (no atomic builtins)", DQUEERR_NOTSUP,  create_prio( &queue, intcomp )                       );
+#else
+    prtest( "dque_create_prio",                     DQUEERR_NOERR,    create_prio( &queue, intcomp )                       );
+    prtest( "dque_pop_front (empty)",               DQUEERR_EMPTY,    pop_front( queue, &data )                            );
+    prtest( "dque_empty",                           DQUEERR_NOERR, (que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_push_back (invalid data ptr)",    DQUEERR_NODATA,   push_back( queue, (void *)NULL )                     );
+    prtest( "dque_push_front (not supported)",      DQUEERR_NOTSUP,   push_front( queue, &array[0] )                       );
+    prtest( "dque_key_insert (not supported)",      DQUEERR_NOTSUP,   key_insert( queue, (void *)NULL, intcomp, &array[0] ) );
+    prtest( "dque_reserve (nothing to reserve)",    DQUEERR_NOERR,    reserve( queue, 100 )                                );
+    for (i = 0; i < 1000 && push_back( queue, &array5[i] ) == DQUEERR_NOERR; ++i) {
+        ;
+    }
+    prtest( "dque_push_back (1000)",                DQUEERR_NOERR, (i == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_size",                            DQUEERR_NOERR,    size( queue, &uns )                                  );
+    prtest( "dque_size == 1000",                    DQUEERR_NOERR, (uns == 1000) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front (smallest)",            DQUEERR_NOERR,    pop_front( queue, &data )                            );
+    prtest( "dque_pop_front == &array5[0]",         DQUEERR_NOERR, (data == &array5[0]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_pop_front (equal, pushed later)", DQUEERR_NOERR,    pop_front( queue, &data )                            );
+    prtest( "dque_pop_front == &array5[500]",       DQUEERR_NOERR, (data == &array5[500]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    for (i = 2, data2 = data; i < 1000 && (data = que_pop( queue )) != (void *)NULL && intcomp( data2, data ) <= 0; ++i) {
+        data2   = data;
+    }
+    prtest( "dque_pop_front (998, in comp order)",  DQUEERR_NOERR, (i == 1000 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_push_back_wait",                  DQUEERR_NOERR,    push_back_wait( queue, &array[7], 0 )                );
+    prtest( "dque_pop_front_wait",                  DQUEERR_NOERR,    pop_front_wait( queue, &data, 0 )                    );
+    prtest( "dque_pop_front_wait == &array[7]",     DQUEERR_NOERR, (data == &array[7]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+#ifndef DQUE_NOLOCK
+    {
+    pthread_t   thrd[4];
+    void       *rslt;
+    size_t      sum     = 0;
+
+    for (i = 0; i < 4; ++i) {               /* 4 threads push and pop       */
+        (void) pthread_create( &thrd[i], NULL, prioworker, queue );
+    }
+    for (i = 0; i < 4; ++i) {
+        (void) pthread_join( thrd[i], &rslt );
+        sum    += (size_t)rslt;             /* sum of the values popped     */
+    }
+    prtest( "4 threads push and pop 20000 each",    DQUEERR_NOERR, (sum == 4 * 20 * 249500 && que_empty( queue )) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    }
+#endif
+    for (i = 0; i < 100 && push_back( queue, &array5[i] ) == DQUEERR_NOERR; ++i) {
+        ;
+    }
+    prtest( "dque_destroy (not empty)",             DQUEERR_NOERR,    destroy( &queue                                    ) );
+#endif
+
+#ifndef DQUE_NOLOCK
+    (void) printf( "\n------------------------------\nthread-local errcode of the dque_util wrappers\n" );
+    {
+    pthread_t   thrd;
+    void       *rslt;
+
+    prtest( "dque_create",                          DQUEERR_NOERR,    create( &queue, 0, (char *)NULL )                    );
+    prtest( "que_push",                             DQUEERR_NOERR,    que_push( queue, &array[4] )                         );
+    (void) pthread_create( &thrd, NULL, errworker, NULL );
+    (void) pthread_join( thrd, &rslt );
+    prtest( "errcode of the other thread",          DQUEERR_NOQUEUE,  (dque_err)(size_t)rslt                               );
+    prtest( "errcode of this thread unchanged",     DQUEERR_NOERR,    errcode                                              );
+    prtest( "que_pop == &array[4]",                 DQUEERR_NOERR, (que_pop( queue ) == &array[4]) ? DQUEERR_NOERR : DQUEERR_UNKERR );
+    prtest( "dque_destroy",                         DQUEERR_NOERR,    destroy( &queue                                    ) );
+    }
+#endif
+
     (void) printf( "\nHello World!!!\n" );
 
     (void) printf( "\n%-76s%s\n", "Overall test status:", status ? "Fail" : "Pass" );
@@ -516,6 +1584,24 @@ myprintf( dque_qhead *queue, int typ ) {
     (void) printf( "\n" );
 }
 
+/* check that a queue of integers has cnt elements in ascending order       */
+dque_err
+myorder( dque_qhead *queue, unsigned int cnt ) {
+    dque_qiter   *iter;
+    int          *prev = (int *)NULL;
+    unsigned int  n    = 0;
+
+    for (iter = my_begin( queue ); iter != my_end( queue ); my_next( queue, &iter )) {
+        if (prev != (int *)NULL && intcomp( prev, my_data( iter ) ) > 0) {
+            return (DQUEERR_UNKERR);
+        }
+        prev = (int *)my_data( iter );
+        ++n;
+    }
+
+    return ((n == cnt) ? DQUEERR_NOERR : DQUEERR_UNKERR);
+}
+
 void
 myrprintf( dque_qhead *queue, int typ ) {
     dque_qiter *iter;
@@ -588,4 +1674,145 @@ intrcomp( void *i1, void *i2 ) {
     return (*(int *)i2 - *(int *)i1);
 }
 
+void *
+cntmalloc( void *ctx, size_t siz ) {
+    ((struct cntalloc *)ctx)->bytes += siz;
+    ((struct cntalloc *)ctx)->calls += 1;
+    return (malloc( siz ));
+}
 
+void
+cntfree( void *ctx, void *ptr, size_t siz ) {
+    ((struct cntalloc *)ctx)->bytes -= siz;
+    free( ptr );
+}
+
+/* push and pop 10000 elements on a DQUEOPT_LOCKED queue, NULL = all popped */
+void *
+lockworker( void *queue ) {
+    void *data;
+    int   i, cnt = 0;
+
+    for (i = 0; i < 10000; ++i) {
+        (void) dque_push_back( (dque_qhead *)queue, &array5[i % 1000] );
+        if ((i & 3) == 3) {                 /* pop some while pushing   */
+            cnt += (dque_pop_front( (dque_qhead *)queue, &data ) == DQUEERR_NOERR && data != NULL);
+        }
+    }
+    while (cnt < 10000 && dque_pop_front( (dque_qhead *)queue, &data ) == DQUEERR_NOERR && data != NULL) {
+        ++cnt;
+    }
+    return ((cnt == 10000) ? NULL : queue);
+}
+
+/* push 10000 elements onto an MPMC queue, popping when it is full, then pop */
+/* until it is empty, returns the # of elements popped                      */
+void *
+mpmcworker( void *queue ) {
+    void *data;
+    int   i;
+    size_t cnt = 0;
+
+    for (i = 0; i < 10000; ++i) {
+        while (dque_push_back( (dque_qhead *)queue, &array5[i % 1000] ) == DQUEERR_FULL) {
+            cnt += (dque_pop_front( (dque_qhead *)queue, &data ) == DQUEERR_NOERR && data != NULL);
+        }
+        if ((i & 3) == 3) {                 /* pop some while pushing   */
+            cnt += (dque_pop_front( (dque_qhead *)queue, &data ) == DQUEERR_NOERR && data != NULL);
+        }
+    }
+    while (dque_pop_front( (dque_qhead *)queue, &data ) == DQUEERR_NOERR && data != NULL) {
+        ++cnt;
+    }
+    return ((void *)cnt);
+}
+
+/* producer for an SPSC queue, pushes 100000 elements, some in batches      */
+void *
+spscworker( void *queue ) {
+    void    *ptrs[10];
+    unsigned done;
+    int      i, j;
+
+    for (i = 0; i < 100000; ) {
+        if (i % 1000 <= 980) {              /* batches of 10            */
+            for (j = 0; j < 10; ++j) {
+                ptrs[j] = &array5[(i + j) % 1000];
+            }
+            for (j = 0; j < 10; j += done) {
+                (void) dque_push_back_n( (dque_qhead *)queue, &ptrs[j], 10 - j, &done );
+            }
+            i += 10;
+        } else {                            /* and one at a time        */
+            while (dque_push_back( (dque_qhead *)queue, &array5[i % 1000] ) == DQUEERR_FULL) {
+                ;
+            }
+            ++i;
+        }
+    }
+    return (NULL);
+}
+
+/* consumer for the wait tests, pops 10000 elements with dque_pop_front_wait */
+/* and checks their order, NULL = all popped in order                       */
+void *
+waitworker( void *queue ) {
+    void *data;
+    int   i;
+
+    for (i = 0; i < 10000; ++i) {
+        if (dque_pop_front_wait( (dque_qhead *)queue, &data, DQUE_FOREVER ) != DQUEERR_NOERR || data != &array5[i % 1000]) {
+            return (queue);
+        }
+    }
+    return (NULL);
+}
+
+/* thief for the work-stealing test, steals until it gets &array[0], which */
+/* the owner pushes last, returns the # of other elements stolen            */
+void *
+stealworker( void *queue ) {
+    void  *data;
+    size_t cnt = 0;
+
+    for (;;) {
+        if (dque_steal_back( (dque_qhead *)queue, &data ) == DQUEERR_NOERR) {
+            if (data == &array[0]) {
+                break;
+            }
+            ++cnt;
+        }
+    }
+    return ((void *)cnt);
+}
+
+/* pushes and pops 20000 elements on the priority queue test, 8 at a time, */
+/* returns the sum of the values it popped                                  */
+void *
+prioworker( void *queue ) {
+    void  *data;
+    size_t sum = 0;
+    int    i;
+    int    j;
+
+    for (i = 0; i < 20000; i += 8) {
+        for (j = 0; j < 8; ++j) {
+            (void) dque_push_back( (dque_qhead *)queue, &array5[(i + j) % 1000] );
+        }
+        for (j = 0; j < 8; ++j) {           /* others may pop ours first    */
+            while (dque_pop_front( (dque_qhead *)queue, &data ) != DQUEERR_NOERR) {
+                ;
+            }
+            sum    += (size_t)*(int *)data;
+        }
+    }
+    return ((void *)sum);
+}
+
+/* fails a dque_util wrapper on another thread, returns that thread's errcode */
+void *
+errworker( void *arg ) {
+    (void) arg;
+    (void) que_pop( NULL_QUEUE );           /* sets errcode to DQUEERR_NOQUEUE */
+    return ((void *)(size_t)errcode);
+}